@@ -1,5 +1,6 @@
 #include "api.h"
 #include "Arduino.h"
+#include <EEPROM.h>
 #include <stdarg.h>
 
 // NOTE!!!
@@ -14,6 +15,8 @@ void setup_api()
 {
   pinMode(2, OUTPUT); // digital pin 2
   pinMode(7, OUTPUT); // digital pin 7
+  pinMode(4, OUTPUT); // digital pin 4, zone 2 gas valve
+  pinMode(5, OUTPUT); // digital pin 5, zone 2 igniter
   pinMode(3, INPUT); // door sensor on pin 3; connect switch to GND
 
   door_sensor_interrupt_handler(digitalRead(3) == HIGH); // we may not get an interrupt at startup, so we call the handler manually
@@ -36,6 +39,14 @@ uint16_t read_voltage(input_t input)
   {
     return (uint32_t)analogRead(A1) * 5000 / 1023;
   }
+  else if (input == TEMPERATURE_SENSOR_2)
+  {
+    return (uint32_t)analogRead(A2) * 5000 / 1023;
+  }
+  else if (input == TEMPERATURE_SENSOR_2_REFERENCE)
+  {
+    return (uint32_t)analogRead(A3) * 5000 / 1023;
+  }
 
   return 0;
 }
@@ -51,6 +62,14 @@ void set_output(output_t output, bool output_state)
   {
     digitalWrite(7, output_state);
   }
+  else if (output == GAS_VALVE_2)
+  {
+    digitalWrite(4, output_state);
+  }
+  else if (output == IGNITER_2)
+  {
+    digitalWrite(5, output_state);
+  }
 }
 
 // read current output state
@@ -64,6 +83,14 @@ bool read_output(output_t output)
   {
     return digitalRead(7) == HIGH;
   }
+  else if (output == GAS_VALVE_2)
+  {
+    return digitalRead(4) == HIGH;
+  }
+  else if (output == IGNITER_2)
+  {
+    return digitalRead(5) == HIGH;
+  }
   return false;
 }
 
@@ -72,6 +99,11 @@ uint32_t get_millis()
   return millis();
 }
 
+uint32_t get_micros()
+{
+  return micros();
+}
+
 void serial_printf(const char * format, ...)
 {
   char buffer[256];
@@ -82,3 +114,35 @@ void serial_printf(const char * format, ...)
 
   Serial.print(buffer);
 }
+
+int serial_read_byte()
+{
+  return Serial.read(); // -1 when the RX buffer is empty
+}
+
+void serial_write(const uint8_t * data, uint16_t length)
+{
+  Serial.write(data, length);
+}
+
+uint16_t eeprom_size()
+{
+  return (uint16_t)EEPROM.length();
+}
+
+uint8_t eeprom_read(uint16_t address)
+{
+  if (address >= EEPROM.length())
+  {
+    return 0xFF;
+  }
+  return EEPROM.read(address);
+}
+
+void eeprom_update(uint16_t address, uint8_t value)
+{
+  if (address < EEPROM.length())
+  {
+    EEPROM.update(address, value); // EEPROM.update skips the write when the value is unchanged
+  }
+}
@@ -20,6 +20,10 @@ typedef enum
     // pin A1
     // referred to as vref
     TEMPERATURE_SENSOR_REFERENCE,
+
+    // pin A2, A3: second zone sensor pair (multi-zone ovens)
+    TEMPERATURE_SENSOR_2,
+    TEMPERATURE_SENSOR_2_REFERENCE,
 } input_t;
 
 typedef enum
@@ -32,6 +36,10 @@ typedef enum
     // pin D7
     // when on, it sparks to ignite gas
     IGNITER,
+
+    // pin D4, D5: second zone burner (multi-zone ovens)
+    GAS_VALVE_2,
+    IGNITER_2,
 } output_t;
 
 void setup_api();
@@ -57,9 +65,27 @@ bool read_output(output_t output);
 // returns the current number of milliseconds since the Arduino board began running
 uint32_t get_millis();
 
+// returns microseconds since start (wraps after ~71 minutes); used for timing stats
+uint32_t get_micros();
+
 // note that float %f format is not supported
 void serial_printf(const char * format, ...);
 
+// Raw binary serial I/O for the command protocol (shares the port with log text).
+// returns the next received byte (0-255), or -1 if none is available
+int serial_read_byte();
+
+void serial_write(const uint8_t * data, uint16_t length);
+
+// Persistent storage (ATmega328P: 1024 bytes of EEPROM).
+// Added for configuration persistence; addresses outside eeprom_size() are ignored.
+uint16_t eeprom_size();
+
+uint8_t eeprom_read(uint16_t address);
+
+// writes only if the stored byte differs, so unchanged bytes cost no erase/write cycle
+void eeprom_update(uint16_t address, uint8_t value);
+
 
 #ifdef __cplusplus
 }
@@ -1,33 +1,187 @@
 /**
  * @file ptx_actuator.cpp
  * @brief Implementation of actuator control layer
+ * @details A shadow byte holds the last commanded state of every output; a
+ *          write reaches the hardware only when the shadow changes, so the
+ *          per-tick ptx_apply_outputs() costs a compare while nothing changes.
+ *          Init, emergency stop and ptx_actuator_resync() always write, which
+ *          drives pins that drifted from the shadow back to it. The port backend stops every burner with
+ *          one masked PORTD write, so no valve stays open while another is
+ *          being switched.
+ *
+ *          Backends:
+ *          - PTX_ACTUATOR_PORT_DIRECT = 0: set_output() from api.h
+ *          - PTX_ACTUATOR_PORT_DIRECT = 1: read-modify-write of the output port
+ *            register (all four burner pins are on PORTD); state read back
+ *            from the PIN register instead of digitalRead()
  */
 #include "ptx_actuator.h"
 #include "api.h"
 
+/* Port backend by default on the ATmega328P; set_output() elsewhere */
+#ifndef PTX_ACTUATOR_PORT_DIRECT
+#if defined(__AVR_ATmega328P__)
+#define PTX_ACTUATOR_PORT_DIRECT 1
+#else
+#define PTX_ACTUATOR_PORT_DIRECT 0
+#endif
+#endif
+
+#if PTX_ACTUATOR_PORT_DIRECT
+#include <avr/io.h>
+
+/* Pin of each output_t on PORTD: D2 gas, D7 igniter, D4 gas 2, D5 igniter 2 */
+static const uint8_t pti_port_bit[] = { _BV(PD2), _BV(PD7), _BV(PD4), _BV(PD5) };
+#define PTX_ACTUATOR_PORT_MASK (_BV(PD2) | _BV(PD7) | _BV(PD4) | _BV(PD5))
+#define PTX_ACTUATOR_CHANNELS  (sizeof(pti_port_bit) / sizeof(pti_port_bit[0]))
+#define PTX_ACTUATOR_BIT(ch)   (pti_port_bit[ch])
+#else
+#define PTX_ACTUATOR_CHANNELS  4U
+#define PTX_ACTUATOR_BIT(ch)   ((uint8_t)(1U << (ch)))
+#endif
+
+/* The door ISR stops the burners through this module: shadow updates from the
+   control loop must not interleave with it */
+#if defined(__AVR__)
+#include <avr/interrupt.h>
+#define PTX_ACTUATOR_LOCK()   uint8_t pti_sreg = SREG; cli()
+#define PTX_ACTUATOR_UNLOCK() SREG = pti_sreg
+#else
+#define PTX_ACTUATOR_LOCK()   ((void)0)
+#define PTX_ACTUATOR_UNLOCK() ((void)0)
+#endif
+
+/* Last commanded state, one PTX_ACTUATOR_BIT() per output_t */
+static volatile uint8_t pti_shadow = 0;
+
+/* Emergency stop latency, written from the door ISR */
+static volatile ptx_actuator_stop_stats_t pti_stop_stats;
+
+/* Push one channel to the hardware; caller holds the lock */
+static void ptx_actuator_write(output_t channel, bool enable) {
+#if PTX_ACTUATOR_PORT_DIRECT
+    if (enable) PORTD |= PTX_ACTUATOR_BIT(channel);
+    else PORTD &= (uint8_t)~PTX_ACTUATOR_BIT(channel);
+#else
+    set_output(channel, enable ? 1 : 0);
+#endif
+}
+
 void ptx_actuator_init(void) {
     /* Start with all actuators OFF for safety */
-    set_output(GAS_VALVE, 0);
-    set_output(IGNITER, 0);
+    ptx_actuator_emergency_stop();
 }
 
 void ptx_actuator_set_gas(bool enable) {
-    set_output(GAS_VALVE, enable ? 1 : 0);
+    ptx_actuator_set_channel(GAS_VALVE, enable);
 }
 
 void ptx_actuator_set_igniter(bool enable) {
-    set_output(IGNITER, enable ? 1 : 0);
+    ptx_actuator_set_channel(IGNITER, enable);
+}
+
+void ptx_actuator_set_channel(output_t channel, bool enable) {
+    if ((unsigned)channel >= PTX_ACTUATOR_CHANNELS) return;
+    uint8_t bit = PTX_ACTUATOR_BIT(channel);
+    PTX_ACTUATOR_LOCK();
+    uint8_t shadow = pti_shadow;
+    uint8_t next = enable ? (uint8_t)(shadow | bit) : (uint8_t)(shadow & ~bit);
+    if (next != shadow) {
+        pti_shadow = next;
+        ptx_actuator_write(channel, enable);
+    }
+    PTX_ACTUATOR_UNLOCK();
 }
 
 void ptx_actuator_emergency_stop(void) {
+    PTX_ACTUATOR_LOCK();
+#if PTX_ACTUATOR_PORT_DIRECT
+    /* Every zone's gas and igniter in one port write */
+    PORTD &= (uint8_t)~PTX_ACTUATOR_PORT_MASK;
+#else
+    /* Every zone's burner: gas first, then igniter, back to back */
     set_output(GAS_VALVE, 0);
+    set_output(GAS_VALVE_2, 0);
     set_output(IGNITER, 0);
+    set_output(IGNITER_2, 0);
+#endif
+    pti_shadow = 0;
+    PTX_ACTUATOR_UNLOCK();
+}
+
+void ptx_actuator_emergency_stop_from(uint32_t entry_us) {
+    ptx_actuator_emergency_stop();
+    uint32_t latency = get_micros() - entry_us;
+
+    PTX_ACTUATOR_LOCK();
+    pti_stop_stats.last_us = latency;
+    if (latency > pti_stop_stats.max_us) pti_stop_stats.max_us = latency;
+    pti_stop_stats.count++;
+    PTX_ACTUATOR_UNLOCK();
+}
+
+void ptx_actuator_get_stop_stats(ptx_actuator_stop_stats_t* stats) {
+    PTX_ACTUATOR_LOCK();
+    stats->last_us = pti_stop_stats.last_us;
+    stats->max_us  = pti_stop_stats.max_us;
+    stats->count   = pti_stop_stats.count;
+    PTX_ACTUATOR_UNLOCK();
+}
+
+void ptx_actuator_reset_stop_stats(void) {
+    PTX_ACTUATOR_LOCK();
+    pti_stop_stats.last_us = 0;
+    pti_stop_stats.max_us  = 0;
+    pti_stop_stats.count   = 0;
+    PTX_ACTUATOR_UNLOCK();
+}
+
+void ptx_actuator_resync(void) {
+    PTX_ACTUATOR_LOCK();
+#if PTX_ACTUATOR_PORT_DIRECT
+    PORTD = (uint8_t)((PORTD & (uint8_t)~PTX_ACTUATOR_PORT_MASK) | pti_shadow);
+#else
+    for (uint8_t ch = 0; ch < PTX_ACTUATOR_CHANNELS; ch++) {
+        set_output((output_t)ch, (pti_shadow & PTX_ACTUATOR_BIT(ch)) != 0);
+    }
+#endif
+    PTX_ACTUATOR_UNLOCK();
+}
+
+uint8_t ptx_actuator_readback_mismatch(void) {
+    PTX_ACTUATOR_LOCK();
+#if PTX_ACTUATOR_PORT_DIRECT
+    uint8_t diff = (uint8_t)((PIND ^ pti_shadow) & PTX_ACTUATOR_PORT_MASK);
+#else
+    uint8_t pins = 0;
+    for (uint8_t ch = 0; ch < PTX_ACTUATOR_CHANNELS; ch++) {
+        if (read_output((output_t)ch)) pins |= PTX_ACTUATOR_BIT(ch);
+    }
+    uint8_t diff = (uint8_t)(pins ^ pti_shadow);
+#endif
+    PTX_ACTUATOR_UNLOCK();
+    if (diff == 0) return 0;
+
+    /* Rare path: translate backend bits to output_t bits */
+    uint8_t mask = 0;
+    for (uint8_t ch = 0; ch < PTX_ACTUATOR_CHANNELS; ch++) {
+        if (diff & PTX_ACTUATOR_BIT(ch)) mask |= PTX_ACTUATOR_CHANNEL_BIT(ch);
+    }
+    return mask;
 }
 
 bool ptx_actuator_get_gas_state(void) {
+#if PTX_ACTUATOR_PORT_DIRECT
+    return (PIND & PTX_ACTUATOR_BIT(GAS_VALVE)) != 0;
+#else
     return read_output(GAS_VALVE);
+#endif
 }
 
 bool ptx_actuator_get_igniter_state(void) {
+#if PTX_ACTUATOR_PORT_DIRECT
+    return (PIND & PTX_ACTUATOR_BIT(IGNITER)) != 0;
+#else
     return read_output(IGNITER);
+#endif
 }
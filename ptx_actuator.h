@@ -2,16 +2,43 @@
  * @file ptx_actuator.h
  * @brief Actuator control abstraction layer (gas valve, igniter)
  * @details Provides clean interface between application logic and hardware API
+ *          Outputs are written only when their commanded state changes; the
+ *          emergency stop always writes. Read-back queries the pins.
  */
 #ifndef PTX_ACTUATOR_H
 #define PTX_ACTUATOR_H
 
 #include <stdbool.h>
+#include <stdint.h>
+#include "api.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Build options */
+#ifndef PTX_ACTUATOR_VERIFY_TICKS
+#define PTX_ACTUATOR_VERIFY_TICKS 4U  /**< Compare readback with the command every N ticks (0 = off) */
+#endif
+#ifndef PTX_ACTUATOR_VERIFY_LATCH
+#define PTX_ACTUATOR_VERIFY_LATCH 2U  /**< Consecutive mismatching samples that latch an actuator fault */
+#endif
+#ifndef PTX_ACTUATOR_RESYNC_TICKS
+#define PTX_ACTUATOR_RESYNC_TICKS 200U  /**< Rewrite every output from the shadow every N ticks (0 = off, max 255) */
+#endif
+
+/** Bit of an output_t in ptx_actuator_readback_mismatch() */
+#define PTX_ACTUATOR_CHANNEL_BIT(channel) ((uint8_t)(1U << (channel)))
+
+/**
+ * @brief Emergency stop latency, ISR entry to outputs off (get_micros() based)
+ */
+typedef struct {
+    uint32_t last_us;  /**< Latency of the latest timed stop */
+    uint32_t max_us;   /**< Worst latency since reset */
+    uint32_t count;    /**< Timed stops since reset */
+} ptx_actuator_stop_stats_t;
+
 /**
  * @brief Initialize actuator outputs
  * @note Ensures all actuators start in safe state (OFF)
@@ -30,12 +57,55 @@ void ptx_actuator_set_gas(bool enable);
  */
 void ptx_actuator_set_igniter(bool enable);
 
+/**
+ * @brief Control any actuator output (e.g. a second zone's GAS_VALVE_2)
+ * @param channel Output channel
+ * @param enable true to activate, false to deactivate
+ */
+void ptx_actuator_set_channel(output_t channel, bool enable);
+
 /**
  * @brief Emergency shutdown - turn off all actuators immediately
- * @note Used for safety cutoff (door open, sensor fault, etc.)
+ * @note Used for safety cutoff (door open, sensor fault, etc.); covers every zone
  */
 void ptx_actuator_emergency_stop(void);
 
+/**
+ * @brief Emergency stop that records its latency
+ * @param entry_us get_micros() taken on entry to the door ISR
+ * @note ISR safe. Latency covers everything from entry_us to the outputs
+ *       being written off.
+ */
+void ptx_actuator_emergency_stop_from(uint32_t entry_us);
+
+/**
+ * @brief Copy the emergency stop latency statistics
+ * @param stats Destination
+ */
+void ptx_actuator_get_stop_stats(ptx_actuator_stop_stats_t* stats);
+
+/**
+ * @brief Clear the emergency stop latency statistics
+ */
+void ptx_actuator_reset_stop_stats(void);
+
+/**
+ * @brief Outputs whose pin readback disagrees with the last command
+ * @return PTX_ACTUATOR_CHANNEL_BIT() mask, 0 when every output matches
+ * @note A few cycles when everything matches (port backend: one PIN read and
+ *       an XOR with the shadow).
+ */
+uint8_t ptx_actuator_readback_mismatch(void);
+
+/**
+ * @brief Drive every output to its last commanded state
+ * @details The set functions only write on a change of command, so a pin that
+ *          drifted away from it (latch upset, glitch on the line) stays wrong
+ *          until this rewrites it. The control loop calls it every
+ *          PTX_ACTUATOR_RESYNC_TICKS ticks. Port backend: one masked PORTD write.
+ */
+void ptx_actuator_resync(void);
+
 /**
  * @brief Get current gas valve state
  * @return true if gas valve is open, false if closed
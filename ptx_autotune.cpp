@@ -0,0 +1,149 @@
+/**
+ * @file ptx_autotune.cpp
+ * @brief Implementation of the relay-feedback autotuner
+ */
+#include "ptx_autotune.h"
+#include <math.h>
+
+#define PTX_AUTOTUNE_PI 3.14159265f
+
+/* Smallest amplitude treated as an oscillation (below sensor noise) */
+#define PTX_AUTOTUNE_MIN_AMPLITUDE_C 0.2f
+
+static float ptx_autotune_clamp(float v, float hi) {
+    if (v < 0.0f) return 0.0f;
+    if (v > hi) return hi;
+    return v;
+}
+
+void ptx_autotune_init(ptx_autotune_t* at) {
+    at->state = PTX_AUTOTUNE_IDLE;
+    at->target_mode = PTX_CONTROL_MODE_PI;
+    at->cycles_wanted = 0;
+    at->cycles_done = 0;
+    at->sampled = false;
+    at->heat_prev = false;
+    at->reached_off = false;
+    at->in_cycle = false;
+    at->warmed = false;
+    at->applied = false;
+    at->start_ms = 0;
+    at->cycle_start_ms = 0;
+    at->on_ms = 0;
+    at->min_ms = 0;
+    at->max_c = 0.0f;
+    at->min_c = 0.0f;
+    at->sum_amplitude_c = 0.0f;
+    at->sum_period_s = 0.0f;
+    at->sum_on_fraction = 0.0f;
+    at->sum_dead_time_s = 0.0f;
+    at->ku = 0.0f;
+    at->tu_s = 0.0f;
+    at->amplitude_c = 0.0f;
+    at->dead_time_s = 0.0f;
+    at->kp = 0.0f;
+    at->ki = 0.0f;
+    at->kd = 0.0f;
+}
+
+bool ptx_autotune_start(ptx_autotune_t* at, uint8_t target_mode, uint8_t cycles) {
+    if (target_mode != PTX_CONTROL_MODE_PI && target_mode != PTX_CONTROL_MODE_PID) return false;
+    if (cycles == 0 || cycles > PTX_AUTOTUNE_MAX_CYCLES) return false;
+    ptx_autotune_init(at);
+    at->state = PTX_AUTOTUNE_RUNNING;
+    at->target_mode = target_mode;
+    at->cycles_wanted = cycles;
+    return true;
+}
+
+void ptx_autotune_abort(ptx_autotune_t* at) {
+    if (at->state == PTX_AUTOTUNE_RUNNING) at->state = PTX_AUTOTUNE_ABORTED;
+}
+
+/* Averages to Ku/Tu and the Ziegler-Nichols gains */
+static void ptx_autotune_finish(ptx_autotune_t* at) {
+    float n = (float)at->cycles_done;
+    at->amplitude_c = at->sum_amplitude_c / n;
+    at->tu_s = at->sum_period_s / n;
+    at->dead_time_s = at->sum_dead_time_s / n;
+    if (at->amplitude_c < PTX_AUTOTUNE_MIN_AMPLITUDE_C || at->tu_s <= 0.0f) {
+        at->state = PTX_AUTOTUNE_ABORTED;
+        return;
+    }
+    float on_fraction = at->sum_on_fraction / n;
+    at->ku = (2.0f / PTX_AUTOTUNE_PI) * sinf(PTX_AUTOTUNE_PI * on_fraction) / at->amplitude_c;
+
+    if (at->target_mode == PTX_CONTROL_MODE_PID) {
+        at->kp = 0.6f * at->ku;
+        at->ki = at->kp / (at->tu_s / 2.0f);
+        at->kd = at->kp * (at->tu_s / 8.0f);
+    } else {
+        at->kp = 0.45f * at->ku;
+        at->ki = at->kp / (at->tu_s / 1.2f);
+        at->kd = 0.0f;
+    }
+    at->state = PTX_AUTOTUNE_DONE;
+}
+
+void ptx_autotune_sample(ptx_autotune_t* at, uint32_t now_ms, float temp_c, float off_c, bool heat_on) {
+    if (at->state != PTX_AUTOTUNE_RUNNING) return;
+    if (!at->sampled) {
+        at->sampled = true;
+        at->start_ms = now_ms;
+    }
+    if (now_ms - at->start_ms >= PTX_AUTOTUNE_TIMEOUT_MS) {
+        at->state = PTX_AUTOTUNE_ABORTED;
+        return;
+    }
+
+    bool rising = heat_on && !at->heat_prev;
+    bool falling = !heat_on && at->heat_prev;
+    at->heat_prev = heat_on;
+
+    /* Warm-up: no cycle is measured before the relay first switches off at the top */
+    if (!at->reached_off) {
+        at->reached_off = (temp_c >= off_c);
+        return;
+    }
+
+    if (rising) {
+        if (at->in_cycle && at->on_ms > 0) {
+            uint32_t period_ms = now_ms - at->cycle_start_ms;
+            if (at->warmed) {
+                at->sum_period_s += (float)period_ms * 0.001f;
+                at->sum_on_fraction += (float)at->on_ms / (float)period_ms;
+                at->sum_amplitude_c += 0.5f * (at->max_c - at->min_c);
+                at->sum_dead_time_s += (float)(at->min_ms - at->cycle_start_ms) * 0.001f;
+                if (++at->cycles_done >= at->cycles_wanted) {
+                    ptx_autotune_finish(at);
+                    return;
+                }
+            }
+            at->warmed = true;
+        }
+        at->in_cycle = true;
+        at->cycle_start_ms = now_ms;
+        at->on_ms = 0;
+        at->max_c = temp_c;
+        at->min_c = temp_c;
+        at->min_ms = now_ms;
+        return;
+    }
+    if (!at->in_cycle) return;
+
+    if (falling) at->on_ms = now_ms - at->cycle_start_ms;
+    if (temp_c > at->max_c) at->max_c = temp_c;
+    if (temp_c < at->min_c) {
+        at->min_c = temp_c;
+        at->min_ms = now_ms;
+    }
+}
+
+bool ptx_autotune_apply(const ptx_autotune_t* at, ptx_oven_config_t* cfg) {
+    if (at->state != PTX_AUTOTUNE_DONE) return false;
+    cfg->control_mode = at->target_mode;
+    cfg->pid_kp = ptx_autotune_clamp(at->kp, 10.0f);
+    cfg->pid_ki = ptx_autotune_clamp(at->ki, 1.0f);
+    cfg->pid_kd = ptx_autotune_clamp(at->kd, 100.0f);
+    return true;
+}
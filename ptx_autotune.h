@@ -0,0 +1,136 @@
+/**
+ * @file ptx_autotune.h
+ * @brief Relay-feedback autotuning of the PI/PID gains
+ * @details While a session runs, the controller heats with its hysteresis
+ *          thresholds, whatever the configured control mode: the burner is a
+ *          relay around the target, and the oven settles into a limit cycle.
+ *          Each cycle runs from one burner-on edge to the next. For every cycle
+ *          the estimator keeps only running extremes and sums, so memory is
+ *          O(1) regardless of the cycle count:
+ *          - period Tu and burner on-fraction D
+ *          - temperature amplitude a = (max - min) / 2
+ *          - dead time L = burner-on edge to the temperature minimum
+ *
+ *          The ultimate gain follows from the describing function of the
+ *          relay's first harmonic: Ku = (2 / pi) * sin(pi * D) / a (duty per
+ *          degree C). This treats the relay as ideal, which underestimates Ku
+ *          somewhat for a relay with hysteresis, so the gains err on the
+ *          conservative side. Gains use Ziegler-Nichols:
+ *          - PI:  kp = 0.45 Ku, Ti = Tu / 1.2
+ *          - PID: kp = 0.6 Ku,  Ti = Tu / 2, Td = Tu / 8
+ *
+ *          The first complete cycle after the oven first reaches the OFF
+ *          threshold is discarded, since it still carries the warm-up.
+ */
+#ifndef PTX_AUTOTUNE_H
+#define PTX_AUTOTUNE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ptx_oven_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Build options */
+#ifndef PTX_AUTOTUNE_TIMEOUT_MS
+#define PTX_AUTOTUNE_TIMEOUT_MS 7200000UL  /* Give up if the cycles are not complete after 2 h */
+#endif
+
+#define PTX_AUTOTUNE_MAX_CYCLES 20U  /**< Upper bound of cycles per session */
+
+/**
+ * @brief Session state
+ */
+typedef enum {
+    PTX_AUTOTUNE_IDLE = 0,   /**< Never started */
+    PTX_AUTOTUNE_RUNNING,    /**< Relay cycling, measuring */
+    PTX_AUTOTUNE_DONE,       /**< Gains computed */
+    PTX_AUTOTUNE_ABORTED     /**< Shutdown, lockout or timeout during the session */
+} ptx_autotune_state_t;
+
+/**
+ * @brief Session state, running sums and results
+ * @note Measurement members are private to ptx_autotune.cpp.
+ */
+typedef struct {
+    uint8_t  state;            /**< ptx_autotune_state_t */
+    uint8_t  target_mode;      /**< PTX_CONTROL_MODE_PI or PTX_CONTROL_MODE_PID */
+    uint8_t  cycles_wanted;
+    uint8_t  cycles_done;      /**< Cycles measured so far */
+
+    bool     sampled;          /**< start_ms is set (first sample seen) */
+    bool     heat_prev;        /**< Burner state at the previous sample */
+    bool     reached_off;      /**< Temperature has reached the OFF threshold once */
+    bool     in_cycle;         /**< A cycle is being measured */
+    bool     warmed;           /**< The warm-up cycle has been discarded */
+    bool     applied;          /**< Result handled by the controller (shared config written) */
+    uint32_t start_ms;         /**< First sample of the session (timeout base) */
+    uint32_t cycle_start_ms;   /**< Burner-on edge that opened the cycle */
+    uint32_t on_ms;            /**< Burner time of the current cycle */
+    uint32_t min_ms;           /**< Time of the current cycle's minimum */
+    float    max_c;
+    float    min_c;
+    float    sum_amplitude_c;
+    float    sum_period_s;
+    float    sum_on_fraction;
+    float    sum_dead_time_s;
+
+    /* Results, valid in PTX_AUTOTUNE_DONE */
+    float    ku;               /**< Ultimate gain (duty per degree C) */
+    float    tu_s;             /**< Ultimate period */
+    float    amplitude_c;      /**< Mean half peak-to-peak temperature */
+    float    dead_time_s;      /**< Mean burner-on to temperature-minimum delay */
+    float    kp;
+    float    ki;
+    float    kd;               /**< 0 for PI */
+} ptx_autotune_t;
+
+/**
+ * @brief Reset to PTX_AUTOTUNE_IDLE
+ */
+void ptx_autotune_init(ptx_autotune_t* at);
+
+/**
+ * @brief Start a session; the timeout runs from the first ptx_autotune_sample()
+ * @param at Session
+ * @param target_mode PTX_CONTROL_MODE_PI or PTX_CONTROL_MODE_PID (the rule used)
+ * @param cycles Cycles to average, 1..PTX_AUTOTUNE_MAX_CYCLES
+ * @return false (and no change) if target_mode or cycles is out of range
+ */
+bool ptx_autotune_start(ptx_autotune_t* at, uint8_t target_mode, uint8_t cycles);
+
+/**
+ * @brief Feed one control tick of a running session
+ * @param at Session
+ * @param now_ms Current time
+ * @param temp_c Measured temperature
+ * @param off_c Relay OFF threshold (target + delta)
+ * @param heat_on Burner (gas) commanded on this tick
+ */
+void ptx_autotune_sample(ptx_autotune_t* at, uint32_t now_ms, float temp_c, float off_c, bool heat_on);
+
+/**
+ * @brief End a running session without a result
+ */
+void ptx_autotune_abort(ptx_autotune_t* at);
+
+/**
+ * @brief Whether a session is in progress
+ */
+static inline bool ptx_autotune_running(const ptx_autotune_t* at) { return at->state == PTX_AUTOTUNE_RUNNING; }
+
+/**
+ * @brief Write the tuned gains and control mode into a configuration
+ * @param at Finished session
+ * @param cfg Configuration to update (gains clamped to the validated ranges)
+ * @return false if the session is not PTX_AUTOTUNE_DONE
+ */
+bool ptx_autotune_apply(const ptx_autotune_t* at, ptx_oven_config_t* cfg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PTX_AUTOTUNE_H */
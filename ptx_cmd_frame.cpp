@@ -0,0 +1,85 @@
+/**
+ * @file ptx_cmd_frame.cpp
+ * @brief Implementation of command protocol framing
+ */
+#include "ptx_cmd_frame.h"
+#include "ptx_crc.h"
+#include <stddef.h>
+#include <string.h>
+
+void ptx_cmd_parser_init(ptx_cmd_parser_t* parser) {
+    memset(parser, 0, sizeof(*parser));
+    parser->state = PTX_CMD_PARSE_SOF;
+}
+
+bool ptx_cmd_parser_feed(ptx_cmd_parser_t* parser, uint8_t byte) {
+    switch (parser->state) {
+        case PTX_CMD_PARSE_SOF:
+            if (byte == PTX_CMD_SOF) {
+                parser->state = PTX_CMD_PARSE_LEN;
+            }
+            break;
+
+        case PTX_CMD_PARSE_LEN:
+            if (byte == PTX_CMD_SOF) {
+                /* SOF can never be a length: the previous one was stray, this one starts the frame */
+                break;
+            }
+            if (byte > PTX_CMD_MAX_PAYLOAD) {
+                /* Cannot be a valid frame; resync on the next SOF */
+                parser->length_errors++;
+                parser->state = PTX_CMD_PARSE_SOF;
+                break;
+            }
+            parser->length = byte;
+            parser->index = 0;
+            parser->crc = ptx_crc16_update(PTX_CRC16_INIT, &byte, 1);
+            parser->state = PTX_CMD_PARSE_CMD;
+            break;
+
+        case PTX_CMD_PARSE_CMD:
+            parser->cmd = byte;
+            parser->crc = ptx_crc16_update(parser->crc, &byte, 1);
+            parser->state = (parser->length > 0) ? PTX_CMD_PARSE_PAYLOAD : PTX_CMD_PARSE_CRC_LO;
+            break;
+
+        case PTX_CMD_PARSE_PAYLOAD:
+            parser->payload[parser->index++] = byte;
+            parser->crc = ptx_crc16_update(parser->crc, &byte, 1);
+            if (parser->index >= parser->length) {
+                parser->state = PTX_CMD_PARSE_CRC_LO;
+            }
+            break;
+
+        case PTX_CMD_PARSE_CRC_LO:
+            parser->crc_lo = byte;
+            parser->state = PTX_CMD_PARSE_CRC_HI;
+            break;
+
+        case PTX_CMD_PARSE_CRC_HI:
+        default:
+            parser->state = PTX_CMD_PARSE_SOF;
+            if (((uint16_t)parser->crc_lo | ((uint16_t)byte << 8)) == parser->crc) {
+                parser->frames_ok++;
+                return true;
+            }
+            parser->crc_errors++;
+            break;
+    }
+    return false;
+}
+
+uint8_t ptx_cmd_encode_frame(uint8_t cmd, const uint8_t* payload, uint8_t length, uint8_t* out) {
+    if (length > PTX_CMD_MAX_PAYLOAD) return 0;
+
+    out[0] = PTX_CMD_SOF;
+    out[1] = length;
+    out[2] = cmd;
+    if (length > 0 && payload != NULL) {
+        memcpy(&out[3], payload, length);
+    }
+    uint16_t crc = ptx_crc16_update(PTX_CRC16_INIT, &out[1], (uint16_t)(length + 2U));
+    out[3 + length] = (uint8_t)crc;
+    out[4 + length] = (uint8_t)(crc >> 8);
+    return (uint8_t)(length + PTX_CMD_FRAME_OVERHEAD);
+}
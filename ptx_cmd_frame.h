@@ -0,0 +1,82 @@
+/**
+ * @file ptx_cmd_frame.h
+ * @brief Framing for the binary command protocol (device and host side)
+ * @details Frame layout:
+ *          | SOF 0xA5 | LEN | CMD | PAYLOAD[LEN] | CRC16 lo | CRC16 hi |
+ *          CRC-16/CCITT-FALSE covers LEN, CMD and PAYLOAD. The parser is a
+ *          byte-at-a-time state machine with a fixed payload buffer, so it
+ *          can run on the RX stream without allocation and resynchronizes on
+ *          the next SOF after noise or interleaved log text.
+ */
+#ifndef PTX_CMD_FRAME_H
+#define PTX_CMD_FRAME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PTX_CMD_SOF          0xA5U
+#define PTX_CMD_MAX_PAYLOAD  32U   /**< Largest payload accepted or produced */
+#define PTX_CMD_FRAME_OVERHEAD 5U  /**< SOF + LEN + CMD + CRC16 */
+#define PTX_CMD_MAX_FRAME    (PTX_CMD_MAX_PAYLOAD + PTX_CMD_FRAME_OVERHEAD)
+
+/**
+ * @brief Parser states
+ */
+typedef enum {
+    PTX_CMD_PARSE_SOF = 0,
+    PTX_CMD_PARSE_LEN,
+    PTX_CMD_PARSE_CMD,
+    PTX_CMD_PARSE_PAYLOAD,
+    PTX_CMD_PARSE_CRC_LO,
+    PTX_CMD_PARSE_CRC_HI
+} ptx_cmd_parse_state_t;
+
+/**
+ * @brief Incremental frame parser
+ */
+typedef struct {
+    ptx_cmd_parse_state_t state;
+    uint8_t  length;                        /**< Payload length of frame in progress */
+    uint8_t  cmd;                           /**< Command byte of frame in progress */
+    uint8_t  index;                         /**< Payload bytes received so far */
+    uint16_t crc;                           /**< Running CRC */
+    uint8_t  crc_lo;                        /**< Received CRC low byte */
+    uint8_t  payload[PTX_CMD_MAX_PAYLOAD];  /**< Payload of the last complete frame */
+
+    uint16_t frames_ok;                     /**< Frames with valid CRC */
+    uint16_t crc_errors;                    /**< Frames dropped on CRC mismatch */
+    uint16_t length_errors;                 /**< Frames dropped because LEN > PTX_CMD_MAX_PAYLOAD */
+} ptx_cmd_parser_t;
+
+/**
+ * @brief Reset parser to wait for SOF and clear counters
+ */
+void ptx_cmd_parser_init(ptx_cmd_parser_t* parser);
+
+/**
+ * @brief Feed one received byte
+ * @return true when a frame with valid CRC is complete; its command, length
+ *         and payload are in parser->cmd, parser->length, parser->payload
+ *         until the next byte is fed
+ */
+bool ptx_cmd_parser_feed(ptx_cmd_parser_t* parser, uint8_t byte);
+
+/**
+ * @brief Encode a frame
+ * @param cmd Command byte
+ * @param payload Payload bytes (may be NULL when length is 0)
+ * @param length Payload length (<= PTX_CMD_MAX_PAYLOAD)
+ * @param out Destination buffer of at least length + PTX_CMD_FRAME_OVERHEAD bytes
+ * @return Number of bytes written, or 0 if length is too large
+ */
+uint8_t ptx_cmd_encode_frame(uint8_t cmd, const uint8_t* payload, uint8_t length, uint8_t* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PTX_CMD_FRAME_H */
@@ -0,0 +1,314 @@
+/**
+ * @file ptx_cmd_protocol.cpp
+ * @brief Device-side dispatch of the binary command protocol
+ */
+#include "ptx_cmd_protocol.h"
+#include "ptx_cmd_frame.h"
+#include "ptx_oven_config.h"
+#include "ptx_oven_control.h"
+#include "ptx_oven_zones.h"
+#include "ptx_oven_status_packed.h"
+#include "ptx_config_store.h"
+#include "ptx_trace.h"
+#include "ptx_actuator.h"
+#include "api.h"
+#include <string.h>
+
+/* Bytes drained from the RX stream per ptx_cmd_poll() call (bounds loop time) */
+#define PTX_CMD_POLL_BUDGET 16U
+
+static_assert(5U + PTX_CMD_TRANSITIONS_PER_FRAME * sizeof(ptx_transition_t) <= PTX_CMD_MAX_PAYLOAD,
+              "GET_TRANSITIONS response must fit one frame");
+static_assert(24U <= PTX_CMD_MAX_PAYLOAD, "AUTOTUNE response must fit one frame");
+static_assert(10U <= PTX_CMD_MAX_PAYLOAD, "RECIPE response must fit one frame");
+
+static ptx_cmd_parser_t pti_parser;
+static uint16_t pti_rejected_count = 0;  /* Requests answered with a non-OK result */
+
+static void ptx_put_u16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void ptx_put_u32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t ptx_get_u32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint32_t ptx_float_bits(float v) {
+    uint32_t u;
+    memcpy(&u, &v, sizeof(u));
+    return u;
+}
+
+static float ptx_bits_float(uint32_t u) {
+    float v;
+    memcpy(&v, &u, sizeof(v));
+    return v;
+}
+
+#if (PTX_TRACE_RECORD_ENABLED)
+/* Trace chunks go out as unsolicited frames between responses */
+static void ptx_cmd_trace_sink(const uint8_t* data, uint8_t length) {
+    uint8_t frame[PTX_CMD_MAX_FRAME];
+    uint8_t frame_len = ptx_cmd_encode_frame((uint8_t)(PTX_CMD_TRACE_DATA | PTX_CMD_RESPONSE_FLAG),
+                                             data, length, frame);
+    serial_write(frame, frame_len);
+}
+#endif
+
+/* Read a field as its wire value; false if the field id is unknown */
+static bool ptx_cmd_get_field(uint8_t field, uint32_t* value) {
+    switch (field) {
+        case PTX_CMD_FIELD_IGNITION_DURATION_MS:     *value = ptx_oven_get_ignition_duration_ms(); break;
+        case PTX_CMD_FIELD_PERIODIC_LOG_MS:          *value = ptx_oven_get_periodic_log_ms(); break;
+        case PTX_CMD_FIELD_SENSOR_FAULT_WINDOW_MS:   *value = ptx_oven_get_sensor_fault_window_ms(); break;
+        case PTX_CMD_FIELD_AUTO_RESUME_DELAY_MS:     *value = ptx_oven_get_auto_resume_delay_ms(); break;
+        case PTX_CMD_FIELD_VREF_MIN_V:               *value = ptx_float_bits(ptx_oven_get_vref_min_v()); break;
+        case PTX_CMD_FIELD_VREF_MAX_V:               *value = ptx_float_bits(ptx_oven_get_vref_max_v()); break;
+        case PTX_CMD_FIELD_TEMP_TARGET_C:            *value = ptx_float_bits(ptx_oven_get_temp_target_c()); break;
+        case PTX_CMD_FIELD_TEMP_DELTA_C:             *value = ptx_float_bits(ptx_oven_get_temp_delta_c()); break;
+        case PTX_CMD_FIELD_MAX_IGNITION_ATTEMPTS:    *value = ptx_oven_get_max_ignition_attempts(); break;
+        case PTX_CMD_FIELD_PURGE_TIME_MS:            *value = ptx_oven_get_purge_time_ms(); break;
+        case PTX_CMD_FIELD_FLAME_DETECT_TEMP_RISE_C: *value = ptx_float_bits(ptx_oven_get_flame_detect_temp_rise_c()); break;
+        case PTX_CMD_FIELD_CONTROL_MODE:             *value = ptx_oven_get_control_mode(); break;
+        case PTX_CMD_FIELD_PID_KP:                   *value = ptx_float_bits(ptx_oven_get_pid_kp()); break;
+        case PTX_CMD_FIELD_PID_KI:                   *value = ptx_float_bits(ptx_oven_get_pid_ki()); break;
+        case PTX_CMD_FIELD_PID_KD:                   *value = ptx_float_bits(ptx_oven_get_pid_kd()); break;
+        case PTX_CMD_FIELD_PID_WINDOW_MS:            *value = ptx_oven_get_pid_window_ms(); break;
+        case PTX_CMD_FIELD_PREDICT_LEAD_MS:          *value = ptx_oven_get_predict_lead_ms(); break;
+        case PTX_CMD_FIELD_PREIGNITE_ENABLED:        *value = ptx_oven_get_preignite_enabled(); break;
+        default: return false;
+    }
+    return true;
+}
+
+/* Apply a wire value through the range-checked setter; false if it was refused */
+static bool ptx_cmd_set_field(uint8_t field, uint32_t value) {
+    float f = ptx_bits_float(value);
+    switch (field) {
+        case PTX_CMD_FIELD_IGNITION_DURATION_MS:     return ptx_oven_set_ignition_duration_ms(value);
+        case PTX_CMD_FIELD_PERIODIC_LOG_MS:          return ptx_oven_set_periodic_log_ms(value);
+        case PTX_CMD_FIELD_SENSOR_FAULT_WINDOW_MS:   return ptx_oven_set_sensor_fault_window_ms(value);
+        case PTX_CMD_FIELD_AUTO_RESUME_DELAY_MS:     return ptx_oven_set_auto_resume_delay_ms(value);
+        case PTX_CMD_FIELD_VREF_MIN_V:               return ptx_oven_set_vref_range_v(f, ptx_oven_get_vref_max_v());
+        case PTX_CMD_FIELD_VREF_MAX_V:               return ptx_oven_set_vref_range_v(ptx_oven_get_vref_min_v(), f);
+        case PTX_CMD_FIELD_TEMP_TARGET_C:            return ptx_oven_set_temp_target_c(f);
+        case PTX_CMD_FIELD_TEMP_DELTA_C:             return ptx_oven_set_temp_delta_c(f);
+        case PTX_CMD_FIELD_MAX_IGNITION_ATTEMPTS:
+            return value <= 0xFFU && ptx_oven_set_max_ignition_attempts((uint8_t)value);
+        case PTX_CMD_FIELD_PURGE_TIME_MS:            return ptx_oven_set_purge_time_ms(value);
+        case PTX_CMD_FIELD_FLAME_DETECT_TEMP_RISE_C: return ptx_oven_set_flame_detect_temp_rise_c(f);
+        case PTX_CMD_FIELD_CONTROL_MODE:
+            return value <= 0xFFU && ptx_oven_set_control_mode((uint8_t)value);
+        case PTX_CMD_FIELD_PID_KP: return ptx_oven_set_pid_gains(f, ptx_oven_get_pid_ki(), ptx_oven_get_pid_kd());
+        case PTX_CMD_FIELD_PID_KI: return ptx_oven_set_pid_gains(ptx_oven_get_pid_kp(), f, ptx_oven_get_pid_kd());
+        case PTX_CMD_FIELD_PID_KD: return ptx_oven_set_pid_gains(ptx_oven_get_pid_kp(), ptx_oven_get_pid_ki(), f);
+        case PTX_CMD_FIELD_PID_WINDOW_MS:            return ptx_oven_set_pid_window_ms(value);
+        case PTX_CMD_FIELD_PREDICT_LEAD_MS:          return ptx_oven_set_predict_lead_ms(value);
+        case PTX_CMD_FIELD_PREIGNITE_ENABLED:
+            return value <= 0xFFU && ptx_oven_set_preignite_enabled((uint8_t)value);
+        default: return false;
+    }
+}
+
+/* Build the response payload for the frame held by the parser; returns its length */
+static uint8_t ptx_cmd_dispatch(uint8_t cmd, const uint8_t* req, uint8_t req_len, uint8_t* resp) {
+    uint8_t len = 1;
+    resp[0] = PTX_CMD_RESULT_OK;
+
+    switch (cmd) {
+        case PTX_CMD_GET_FIELD:
+        case PTX_CMD_SET_FIELD: {
+            uint8_t expected = (cmd == PTX_CMD_GET_FIELD) ? 1U : 5U;
+            if (req_len != expected) {
+                resp[0] = PTX_CMD_RESULT_BAD_LENGTH;
+                break;
+            }
+            uint32_t value;
+            if (!ptx_cmd_get_field(req[0], &value)) {
+                resp[0] = PTX_CMD_RESULT_UNKNOWN_FIELD;
+                break;
+            }
+            if (cmd == PTX_CMD_SET_FIELD) {
+                uint32_t requested = ptx_get_u32(&req[1]);
+                bool accepted = ptx_cmd_set_field(req[0], requested);
+                (void)ptx_cmd_get_field(req[0], &value);
+                if (!accepted || value != requested) {
+                    resp[0] = PTX_CMD_RESULT_REJECTED;
+                }
+            }
+            resp[1] = req[0];
+            ptx_put_u32(&resp[2], value);
+            len = 6;
+            break;
+        }
+
+#if !defined(PTX_OVEN_PROFILE)
+        case PTX_CMD_SAVE_CONFIG: {
+            ptx_config_store_result_t result = ptx_config_store_save();
+            if (result != PTX_CONFIG_STORE_OK && result != PTX_CONFIG_STORE_UNCHANGED) {
+                resp[0] = PTX_CMD_RESULT_STORE_FAILED;
+            }
+            resp[1] = (uint8_t)result;
+            len = 2;
+            break;
+        }
+#endif
+
+        case PTX_CMD_RESET_LOCKOUT:
+#if (PTX_OVEN_MULTI_ZONE_ENABLED)
+            ptx_oven_zones_reset_ignition_lockout();
+#else
+            ptx_oven_reset_ignition_lockout();
+#endif
+            break;
+
+        case PTX_CMD_GET_STATUS: {
+            ptx_oven_status_packed_t snap;
+            ptx_oven_status_pack(ptx_oven_get_status(), &snap);
+            ptx_put_u16(&resp[1], (uint16_t)snap.temperature_dc);
+            ptx_put_u16(&resp[3], snap.vref_mv);
+            ptx_put_u16(&resp[5], snap.signal_mv);
+            resp[7] = snap.flags;
+            resp[8] = snap.state_attempt;
+            len = 9;
+            break;
+        }
+
+        case PTX_CMD_GET_STATS:
+            ptx_put_u16(&resp[1], pti_parser.frames_ok);
+            ptx_put_u16(&resp[3], pti_parser.crc_errors);
+            ptx_put_u16(&resp[5], pti_parser.length_errors);
+            ptx_put_u16(&resp[7], pti_rejected_count);
+            ptx_put_u32(&resp[9], ptx_oven_get_compiled_config()->version);
+            ptx_put_u32(&resp[13], get_millis());
+            {
+                ptx_actuator_stop_stats_t stop;
+                ptx_actuator_get_stop_stats(&stop);
+                ptx_put_u16(&resp[17], (uint16_t)((stop.count > 0xFFFFU) ? 0xFFFFU : stop.count));
+                ptx_put_u16(&resp[19], (uint16_t)((stop.max_us > 0xFFFFU) ? 0xFFFFU : stop.max_us));
+            }
+            len = 21;
+            break;
+
+        case PTX_CMD_GET_TRANSITIONS: {
+            if (req_len != 1) {
+                resp[0] = PTX_CMD_RESULT_BAD_LENGTH;
+                break;
+            }
+            const ptx_transition_ring_t* ring = ptx_oven_get_transitions();
+            resp[1] = ptx_transition_ring_count(ring);
+            ptx_put_u16(&resp[2], ring->total);
+            resp[4] = req[0];
+            len = 5;
+            ptx_transition_t t;
+            for (unsigned i = req[0]; i < resp[1] && i < req[0] + PTX_CMD_TRANSITIONS_PER_FRAME; i++) {
+                (void)ptx_transition_ring_get(ring, (uint8_t)i, &t);
+                ptx_put_u32(&resp[len], t.time_ms);
+                ptx_put_u16(&resp[len + 4], (uint16_t)t.temperature_dc);
+                resp[len + 6] = t.states;
+                resp[len + 7] = t.cause;
+                len = (uint8_t)(len + sizeof(ptx_transition_t));
+            }
+            break;
+        }
+
+        case PTX_CMD_AUTOTUNE: {
+            if (req_len != 0 && req_len != 2) {
+                resp[0] = PTX_CMD_RESULT_BAD_LENGTH;
+                break;
+            }
+            if (req_len == 2 && !ptx_oven_start_autotune(req[0], req[1])) {
+                resp[0] = PTX_CMD_RESULT_REJECTED;
+            }
+            const ptx_autotune_t* at = ptx_oven_get_autotune();
+            resp[1] = at->state;
+            resp[2] = at->cycles_done;
+            resp[3] = at->cycles_wanted;
+            ptx_put_u32(&resp[4], ptx_float_bits(at->ku));
+            ptx_put_u32(&resp[8], (uint32_t)(at->tu_s * 1000.0f));
+            ptx_put_u32(&resp[12], ptx_float_bits(at->kp));
+            ptx_put_u32(&resp[16], ptx_float_bits(at->ki));
+            ptx_put_u32(&resp[20], ptx_float_bits(at->kd));
+            len = 24;
+            break;
+        }
+
+        case PTX_CMD_RECIPE: {
+            if (req_len > 1) {
+                resp[0] = PTX_CMD_RESULT_BAD_LENGTH;
+                break;
+            }
+            if (req_len == 1) {
+                if (req[0] == 0) {
+                    ptx_oven_stop_recipe();
+                } else if (!ptx_oven_start_recipe(req[0])) {
+                    resp[0] = PTX_CMD_RESULT_REJECTED;
+                }
+            }
+            const ptx_recipe_t* r = ptx_oven_get_recipe();
+            float setpoint_c = ptx_recipe_running(r) ? ptx_recipe_setpoint_c(r) : ptx_oven_get_temp_target_c();
+            resp[1] = r->state;
+            resp[2] = r->recipe_id;
+            resp[3] = r->segment;
+            resp[4] = r->segments;
+            resp[5] = r->phase;
+            ptx_put_u16(&resp[6], (uint16_t)(int16_t)(setpoint_c * 10.0f + (setpoint_c >= 0.0f ? 0.5f : -0.5f)));
+            ptx_put_u16(&resp[8], (uint16_t)(ptx_recipe_hold_left_ms(r, get_millis()) / 1000UL));
+            len = 10;
+            break;
+        }
+
+#if (PTX_TRACE_RECORD_ENABLED)
+        case PTX_CMD_TRACE_CONTROL:
+            if (req_len != 1) {
+                resp[0] = PTX_CMD_RESULT_BAD_LENGTH;
+            } else if (req[0] != 0) {
+                ptx_trace_start(ptx_cmd_trace_sink);
+            } else {
+                ptx_trace_stop();
+            }
+            break;
+#endif
+
+        default:
+            resp[0] = PTX_CMD_RESULT_UNKNOWN_CMD;
+            break;
+    }
+
+    if (resp[0] != PTX_CMD_RESULT_OK) {
+        pti_rejected_count++;
+    }
+    return len;
+}
+
+void ptx_cmd_init(void) {
+    ptx_cmd_parser_init(&pti_parser);
+    pti_rejected_count = 0;
+}
+
+void ptx_cmd_feed_byte(uint8_t byte) {
+    if (!ptx_cmd_parser_feed(&pti_parser, byte)) return;
+
+    uint8_t resp[PTX_CMD_MAX_PAYLOAD];
+    uint8_t frame[PTX_CMD_MAX_FRAME];
+    uint8_t resp_len = ptx_cmd_dispatch(pti_parser.cmd, pti_parser.payload, pti_parser.length, resp);
+    uint8_t frame_len = ptx_cmd_encode_frame((uint8_t)(pti_parser.cmd | PTX_CMD_RESPONSE_FLAG),
+                                             resp, resp_len, frame);
+    serial_write(frame, frame_len);
+}
+
+void ptx_cmd_poll(void) {
+    for (uint8_t i = 0; i < PTX_CMD_POLL_BUDGET; i++) {
+        int byte = serial_read_byte();
+        if (byte < 0) break;
+        ptx_cmd_feed_byte((uint8_t)byte);
+    }
+}
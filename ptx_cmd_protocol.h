@@ -0,0 +1,155 @@
+/**
+ * @file ptx_cmd_protocol.h
+ * @brief Binary command protocol for runtime configuration over serial
+ * @details Requests and responses use the framing in ptx_cmd_frame.h. A
+ *          response echoes the request command with PTX_CMD_RESPONSE_FLAG set;
+ *          its first payload byte is a ptx_cmd_result_t. Multi-byte values are
+ *          little-endian; float fields travel as raw IEEE-754 bits.
+ *
+ *          Requests and response payloads:
+ *          - GET_FIELD     [field]              -> [result][field][value u32]
+ *          - SET_FIELD     [field][value u32]   -> [result][field][value u32 read back]
+ *          - SAVE_CONFIG   []                   -> [result][ptx_config_store_result_t]
+ *          - RESET_LOCKOUT []                   -> [result]
+ *          - GET_STATUS    []                   -> [result][ptx_oven_status_packed_t, 8 bytes]
+ *          - GET_STATS     []                   -> [result][frames_ok u16][crc_errors u16]
+ *                                                  [length_errors u16][rejected u16]
+ *                                                  [config_version u32][uptime_ms u32]
+ *                                                  [estop_count u16][estop_max_us u16]
+ *          - TRACE_CONTROL [on u8]              -> [result]
+ *          - GET_TRANSITIONS [start u8]         -> [result][held u8][total u16][start u8]
+ *                                                  up to PTX_CMD_TRANSITIONS_PER_FRAME x
+ *                                                  [time_ms u32][temp_dc i16][from<<4|to u8][cause u8]
+ *          - AUTOTUNE      [] or [mode u8][cycles u8]
+ *                                               -> [result][state u8][done u8][wanted u8][ku f32]
+ *                                                  [tu_ms u32][kp f32][ki f32][kd f32]
+ *          - RECIPE        [] or [recipe u8]    -> [result][state u8][recipe u8][segment u8]
+ *                                                  [segments u8][phase u8][setpoint_dc i16]
+ *                                                  [hold_left_s u16]
+ *
+ *          GET_TRANSITIONS reads the heating transition ring of zone 0, oldest
+ *          entry first (start 0); request start + n for the next page.
+ *          AUTOTUNE with an empty payload reports the session of zone 0; with
+ *          [mode][cycles] it first starts one (ptx_oven_start_autotune()), and
+ *          an out-of-range mode or cycle count is REJECTED.
+ *          RECIPE with an empty payload reports the recipe executor of zone 0;
+ *          [recipe] starts a built-in recipe (ptx_oven_start_recipe()), and
+ *          [0] stops the running one. An unknown id is REJECTED. setpoint_dc
+ *          is the effective setpoint: the recipe's while it runs, otherwise
+ *          temp_target_c.
+ *
+ *          While a trace is on, the device also sends unsolicited TRACE_DATA
+ *          frames (command PTX_CMD_TRACE_DATA | PTX_CMD_RESPONSE_FLAG) carrying
+ *          consecutive chunks of a ptx_trace.h input trace; turning it on again
+ *          restarts the trace with a new header. TRACE_CONTROL is answered with
+ *          UNKNOWN_CMD when the build has PTX_TRACE_RECORD_ENABLED set to 0.
+ *          A multi-zone build traces the inputs of zone 0.
+ *
+ *          SET_FIELD goes through the range-checked ptx_oven_set_* setters;
+ *          a value they refuse is reported as PTX_CMD_RESULT_REJECTED together
+ *          with the unchanged value. A PTX_OVEN_PROFILE build runs on its
+ *          baked-in profile: every SET_FIELD is REJECTED and SAVE_CONFIG is
+ *          answered with UNKNOWN_CMD.
+ */
+#ifndef PTX_CMD_PROTOCOL_H
+#define PTX_CMD_PROTOCOL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PTX_CMD_RESPONSE_FLAG 0x80U
+
+/**
+ * @brief Request command codes
+ */
+typedef enum {
+    PTX_CMD_GET_FIELD     = 0x10,
+    PTX_CMD_SET_FIELD     = 0x11,
+    PTX_CMD_SAVE_CONFIG   = 0x12,
+    PTX_CMD_RESET_LOCKOUT = 0x20,
+    PTX_CMD_GET_STATUS    = 0x30,
+    PTX_CMD_GET_STATS     = 0x40,
+    PTX_CMD_TRACE_CONTROL = 0x50,
+    PTX_CMD_TRACE_DATA    = 0x51,  /**< Device to host only */
+    PTX_CMD_GET_TRANSITIONS = 0x60,
+    PTX_CMD_AUTOTUNE      = 0x70,
+    PTX_CMD_RECIPE        = 0x71
+} ptx_cmd_code_t;
+
+#define PTX_CMD_TRANSITIONS_PER_FRAME 3U  /**< Entries in one GET_TRANSITIONS response */
+
+/**
+ * @brief Result code in the first byte of every response
+ */
+typedef enum {
+    PTX_CMD_RESULT_OK = 0,
+    PTX_CMD_RESULT_UNKNOWN_CMD,    /**< Command code not supported */
+    PTX_CMD_RESULT_BAD_LENGTH,     /**< Payload length wrong for the command */
+    PTX_CMD_RESULT_UNKNOWN_FIELD,  /**< Field id not supported */
+    PTX_CMD_RESULT_REJECTED,       /**< Setter refused the value (range) or config busy */
+    PTX_CMD_RESULT_STORE_FAILED    /**< EEPROM save failed */
+} ptx_cmd_result_t;
+
+/**
+ * @brief Configuration field identifiers (one per ptx_oven_config_t member)
+ */
+typedef enum {
+    PTX_CMD_FIELD_IGNITION_DURATION_MS = 1,     /**< u32 */
+    PTX_CMD_FIELD_PERIODIC_LOG_MS,              /**< u32 */
+    PTX_CMD_FIELD_SENSOR_FAULT_WINDOW_MS,       /**< u32 */
+    PTX_CMD_FIELD_AUTO_RESUME_DELAY_MS,         /**< u32 */
+    PTX_CMD_FIELD_VREF_MIN_V,                   /**< f32 */
+    PTX_CMD_FIELD_VREF_MAX_V,                   /**< f32 */
+    PTX_CMD_FIELD_TEMP_TARGET_C,                /**< f32 */
+    PTX_CMD_FIELD_TEMP_DELTA_C,                 /**< f32 */
+    PTX_CMD_FIELD_MAX_IGNITION_ATTEMPTS,        /**< u32 (0-255) */
+    PTX_CMD_FIELD_PURGE_TIME_MS,                /**< u32 */
+    PTX_CMD_FIELD_FLAME_DETECT_TEMP_RISE_C,     /**< f32 */
+    PTX_CMD_FIELD_CONTROL_MODE,                 /**< u32 (ptx_control_mode_t) */
+    PTX_CMD_FIELD_PID_KP,                       /**< f32 */
+    PTX_CMD_FIELD_PID_KI,                       /**< f32 */
+    PTX_CMD_FIELD_PID_KD,                       /**< f32 */
+    PTX_CMD_FIELD_PID_WINDOW_MS,                /**< u32 */
+    PTX_CMD_FIELD_PREDICT_LEAD_MS,              /**< u32 */
+    PTX_CMD_FIELD_PREIGNITE_ENABLED,            /**< u32 (0/1) */
+    PTX_CMD_FIELD_COUNT
+} ptx_cmd_field_t;
+
+/**
+ * @brief Reset the receive state machine and counters
+ */
+void ptx_cmd_init(void);
+
+/**
+ * @brief Feed one received byte; dispatches and transmits a response when a frame completes
+ * @param byte Byte from the serial RX stream
+ */
+void ptx_cmd_feed_byte(uint8_t byte);
+
+/**
+ * @brief Drain pending serial input (bounded per call)
+ * @note Call once per main loop iteration.
+ */
+void ptx_cmd_poll(void);
+
+/**
+ * @brief Whether a field carries a float value
+ * @param field Field identifier
+ * @return true for f32 fields, false for integer fields
+ */
+static inline bool ptx_cmd_field_is_float(uint8_t field) {
+    return field == PTX_CMD_FIELD_VREF_MIN_V || field == PTX_CMD_FIELD_VREF_MAX_V ||
+           field == PTX_CMD_FIELD_TEMP_TARGET_C || field == PTX_CMD_FIELD_TEMP_DELTA_C ||
+           field == PTX_CMD_FIELD_FLAME_DETECT_TEMP_RISE_C || field == PTX_CMD_FIELD_PID_KP ||
+           field == PTX_CMD_FIELD_PID_KI || field == PTX_CMD_FIELD_PID_KD;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PTX_CMD_PROTOCOL_H */
@@ -0,0 +1,263 @@
+/**
+ * @file ptx_config_store.cpp
+ * @brief Implementation of wear-leveled, versioned configuration storage
+ */
+#include "ptx_config_store.h"
+#include "ptx_oven_config.h"
+#include "ptx_crc.h"
+#include "api.h"
+#include <stddef.h>
+#include <string.h>
+
+#define PTX_STORE_MAGIC_0 0x50U  /* 'P' */
+#define PTX_STORE_MAGIC_1 0x58U  /* 'X' */
+
+/* Payload length of each schema version (index = schema) */
+static constexpr uint8_t pti_schema_length[PTX_CONFIG_STORE_SCHEMA + 1] = {
+    0,   /* unused */
+    32,  /* v1: timing, vref range, target and hysteresis */
+    41,  /* v2: + max_ignition_attempts, purge_time_ms, flame_detect_temp_rise_c */
+    58,  /* v3: + control_mode, pid_kp, pid_ki, pid_kd, pid_window_ms */
+    62,  /* v4: + predict_lead_ms */
+    63,  /* v5: + preignite_enabled */
+};
+
+/* Longest payload of any schema; sizes the record buffers. The running
+   maximum is carried down so each element is visited once (C++11 constexpr). */
+template <size_t N>
+constexpr uint8_t ptx_schema_length_max(const uint8_t (&len)[N], size_t i = 0, uint8_t max = 0U) {
+    return (i >= N) ? max : ptx_schema_length_max(len, i + 1, (len[i] > max) ? len[i] : max);
+}
+#define PTX_STORE_PAYLOAD_MAX ptx_schema_length_max(pti_schema_length)
+
+static_assert(PTX_CONFIG_STORE_HEADER_SIZE + PTX_STORE_PAYLOAD_MAX <= PTX_CONFIG_STORE_SLOT_SIZE,
+              "config record must fit in one slot");
+
+typedef struct {
+    bool     valid;
+    uint8_t  slot;
+    uint8_t  schema;
+    uint8_t  length;
+    uint16_t sequence;
+} pti_record_info_t;
+
+static uint16_t ptx_slot_addr(uint8_t slot) {
+    return (uint16_t)(PTX_CONFIG_STORE_BASE_ADDR + (uint16_t)slot * PTX_CONFIG_STORE_SLOT_SIZE);
+}
+
+/* Little-endian field encoding; layout is independent of struct padding */
+static void ptx_put_u32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t ptx_get_u32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void ptx_put_f32(uint8_t* p, float v) {
+    uint32_t u;
+    memcpy(&u, &v, sizeof(u));
+    ptx_put_u32(p, u);
+}
+
+static float ptx_get_f32(const uint8_t* p) {
+    uint32_t u = ptx_get_u32(p);
+    float v;
+    memcpy(&v, &u, sizeof(v));
+    return v;
+}
+
+static void ptx_read_bytes(uint16_t addr, uint8_t* dst, uint8_t len) {
+    for (uint8_t i = 0; i < len; i++) {
+        dst[i] = eeprom_read((uint16_t)(addr + i));
+    }
+}
+
+static uint16_t ptx_record_crc(const uint8_t* header, const uint8_t* payload, uint8_t length) {
+    /* CRC covers schema, length and sequence (header bytes 2..5) and the payload */
+    uint16_t crc = ptx_crc16_update(PTX_CRC16_INIT, &header[2], 4);
+    return ptx_crc16_update(crc, payload, length);
+}
+
+/* Check one slot; on success fills info and (optionally) the payload */
+static bool ptx_read_record(uint8_t slot, pti_record_info_t* info, uint8_t* payload) {
+    uint8_t header[PTX_CONFIG_STORE_HEADER_SIZE];
+    uint8_t buf[PTX_STORE_PAYLOAD_MAX];
+    uint16_t addr = ptx_slot_addr(slot);
+
+    info->valid = false;
+    ptx_read_bytes(addr, header, PTX_CONFIG_STORE_HEADER_SIZE);
+    if (header[0] != PTX_STORE_MAGIC_0 || header[1] != PTX_STORE_MAGIC_1) return false;
+
+    uint8_t schema = header[2];
+    uint8_t length = header[3];
+    if (schema == 0 || schema > PTX_CONFIG_STORE_SCHEMA) return false;
+    if (length != pti_schema_length[schema]) return false;
+
+    ptx_read_bytes((uint16_t)(addr + PTX_CONFIG_STORE_HEADER_SIZE), buf, length);
+    uint16_t stored_crc = (uint16_t)header[6] | ((uint16_t)header[7] << 8);
+    if (ptx_record_crc(header, buf, length) != stored_crc) return false;
+
+    info->valid    = true;
+    info->slot     = slot;
+    info->schema   = schema;
+    info->length   = length;
+    info->sequence = (uint16_t)header[4] | ((uint16_t)header[5] << 8);
+    if (payload != NULL) {
+        memcpy(payload, buf, length);
+    }
+    return true;
+}
+
+/* Newest valid record by sequence number (serial-number arithmetic handles wrap) */
+static void ptx_find_newest(pti_record_info_t* newest, uint8_t* payload) {
+    newest->valid = false;
+    for (uint8_t slot = 0; slot < PTX_CONFIG_STORE_SLOTS; slot++) {
+        pti_record_info_t info;
+        if (!ptx_read_record(slot, &info, NULL)) continue;
+        if (!newest->valid || (int16_t)(info.sequence - newest->sequence) > 0) {
+            *newest = info;
+        }
+    }
+    if (newest->valid && payload != NULL) {
+        (void)ptx_read_record(newest->slot, newest, payload);
+    }
+}
+
+static void ptx_serialize(const ptx_oven_config_t* cfg, uint8_t* p) {
+    /* v1 fields */
+    ptx_put_u32(&p[0],  cfg->ignition_duration_ms);
+    ptx_put_u32(&p[4],  cfg->periodic_log_ms);
+    ptx_put_u32(&p[8],  cfg->sensor_fault_window_ms);
+    ptx_put_u32(&p[12], cfg->auto_resume_delay_ms);
+    ptx_put_f32(&p[16], cfg->vref_min_v);
+    ptx_put_f32(&p[20], cfg->vref_max_v);
+    ptx_put_f32(&p[24], cfg->temp_target_c);
+    ptx_put_f32(&p[28], cfg->temp_delta_c);
+    /* v2 fields */
+    p[32] = cfg->max_ignition_attempts;
+    ptx_put_u32(&p[33], cfg->purge_time_ms);
+    ptx_put_f32(&p[37], cfg->flame_detect_temp_rise_c);
+    /* v3 fields */
+    p[41] = cfg->control_mode;
+    ptx_put_f32(&p[42], cfg->pid_kp);
+    ptx_put_f32(&p[46], cfg->pid_ki);
+    ptx_put_f32(&p[50], cfg->pid_kd);
+    ptx_put_u32(&p[54], cfg->pid_window_ms);
+    /* v4 fields */
+    ptx_put_u32(&p[58], cfg->predict_lead_ms);
+    /* v5 fields */
+    p[62] = cfg->preignite_enabled;
+}
+
+/* Decode any known schema; fields the schema lacks keep their defaults (migration) */
+static void ptx_deserialize(uint8_t schema, const uint8_t* p, ptx_oven_config_t* cfg) {
+    ptx_oven_get_default_config(cfg);
+
+    cfg->ignition_duration_ms   = ptx_get_u32(&p[0]);
+    cfg->periodic_log_ms        = ptx_get_u32(&p[4]);
+    cfg->sensor_fault_window_ms = ptx_get_u32(&p[8]);
+    cfg->auto_resume_delay_ms   = ptx_get_u32(&p[12]);
+    cfg->vref_min_v             = ptx_get_f32(&p[16]);
+    cfg->vref_max_v             = ptx_get_f32(&p[20]);
+    cfg->temp_target_c          = ptx_get_f32(&p[24]);
+    cfg->temp_delta_c           = ptx_get_f32(&p[28]);
+    if (schema < 2) return;
+
+    cfg->max_ignition_attempts    = p[32];
+    cfg->purge_time_ms            = ptx_get_u32(&p[33]);
+    cfg->flame_detect_temp_rise_c = ptx_get_f32(&p[37]);
+    if (schema < 3) return;
+
+    cfg->control_mode  = p[41];
+    cfg->pid_kp        = ptx_get_f32(&p[42]);
+    cfg->pid_ki        = ptx_get_f32(&p[46]);
+    cfg->pid_kd        = ptx_get_f32(&p[50]);
+    cfg->pid_window_ms = ptx_get_u32(&p[54]);
+    if (schema < 4) return;
+
+    cfg->predict_lead_ms = ptx_get_u32(&p[58]);
+    if (schema < 5) return;
+
+    cfg->preignite_enabled = p[62];
+}
+
+static bool ptx_store_fits(void) {
+    return (uint32_t)PTX_CONFIG_STORE_BASE_ADDR +
+           (uint32_t)PTX_CONFIG_STORE_SLOTS * PTX_CONFIG_STORE_SLOT_SIZE <= eeprom_size();
+}
+
+ptx_config_store_result_t ptx_config_store_load(void) {
+    if (!ptx_store_fits()) return PTX_CONFIG_STORE_ERROR;
+
+    uint8_t payload[PTX_STORE_PAYLOAD_MAX];
+    pti_record_info_t newest;
+    ptx_find_newest(&newest, payload);
+    if (!newest.valid) return PTX_CONFIG_STORE_EMPTY;
+
+    ptx_oven_config_t cfg;
+    ptx_deserialize(newest.schema, payload, &cfg);
+    if (!ptx_oven_config_validate(&cfg)) return PTX_CONFIG_STORE_INVALID;
+    if (!ptx_oven_set_config(&cfg)) return PTX_CONFIG_STORE_ERROR;
+
+    return (newest.schema < PTX_CONFIG_STORE_SCHEMA) ? PTX_CONFIG_STORE_MIGRATED : PTX_CONFIG_STORE_OK;
+}
+
+ptx_config_store_result_t ptx_config_store_save(void) {
+    if (!ptx_store_fits()) return PTX_CONFIG_STORE_ERROR;
+
+    const uint8_t length = pti_schema_length[PTX_CONFIG_STORE_SCHEMA];
+    uint8_t payload[PTX_STORE_PAYLOAD_MAX];
+    ptx_serialize(ptx_oven_get_config(), payload);
+
+    uint8_t stored[PTX_STORE_PAYLOAD_MAX];
+    pti_record_info_t newest;
+    ptx_find_newest(&newest, stored);
+    if (newest.valid && newest.schema == PTX_CONFIG_STORE_SCHEMA &&
+        memcmp(stored, payload, length) == 0) {
+        return PTX_CONFIG_STORE_UNCHANGED;
+    }
+
+    uint8_t slot = newest.valid ? (uint8_t)((newest.slot + 1U) % PTX_CONFIG_STORE_SLOTS) : 0U;
+    uint16_t sequence = newest.valid ? (uint16_t)(newest.sequence + 1U) : 1U;
+    if (sequence == 0) sequence = 1;  /* 0 is reported as "empty" */
+
+    uint8_t header[PTX_CONFIG_STORE_HEADER_SIZE];
+    header[0] = PTX_STORE_MAGIC_0;
+    header[1] = PTX_STORE_MAGIC_1;
+    header[2] = PTX_CONFIG_STORE_SCHEMA;
+    header[3] = length;
+    header[4] = (uint8_t)sequence;
+    header[5] = (uint8_t)(sequence >> 8);
+    uint16_t crc = ptx_record_crc(header, payload, length);
+    header[6] = (uint8_t)crc;
+    header[7] = (uint8_t)(crc >> 8);
+
+    /* Payload first, header last: a save cut short by power loss fails the CRC
+       and the previous record in another slot stays the newest valid one. */
+    uint16_t addr = ptx_slot_addr(slot);
+    for (uint8_t i = 0; i < length; i++) {
+        eeprom_update((uint16_t)(addr + PTX_CONFIG_STORE_HEADER_SIZE + i), payload[i]);
+    }
+    for (uint8_t i = 0; i < PTX_CONFIG_STORE_HEADER_SIZE; i++) {
+        eeprom_update((uint16_t)(addr + i), header[i]);
+    }
+    return PTX_CONFIG_STORE_OK;
+}
+
+void ptx_config_store_erase(void) {
+    if (!ptx_store_fits()) return;
+    for (uint8_t slot = 0; slot < PTX_CONFIG_STORE_SLOTS; slot++) {
+        eeprom_update(ptx_slot_addr(slot), 0xFFU);
+    }
+}
+
+uint16_t ptx_config_store_get_sequence(void) {
+    if (!ptx_store_fits()) return 0;
+    pti_record_info_t newest;
+    ptx_find_newest(&newest, NULL);
+    return newest.valid ? newest.sequence : 0;
+}
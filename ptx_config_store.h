@@ -0,0 +1,74 @@
+/**
+ * @file ptx_config_store.h
+ * @brief Persistent storage of ptx_oven_config_t in EEPROM
+ * @details The configuration is stored as a versioned record (magic, schema
+ *          version, payload length, sequence number, CRC-16) in one of
+ *          PTX_CONFIG_STORE_SLOTS rotating slots. Each save goes to the slot
+ *          after the newest valid one, so writes are spread across the slots
+ *          and a save interrupted by power loss leaves the previous record
+ *          intact. Older schema versions are migrated forward on load.
+ */
+#ifndef PTX_CONFIG_STORE_H
+#define PTX_CONFIG_STORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PTX_CONFIG_STORE_BASE_ADDR   0U    /**< First EEPROM byte used by the store */
+#define PTX_CONFIG_STORE_SLOTS       4U    /**< Number of wear-leveling slots */
+#define PTX_CONFIG_STORE_SLOT_SIZE   128U  /**< Bytes reserved per slot (header + payload) */
+#define PTX_CONFIG_STORE_HEADER_SIZE 8U    /**< magic(2) schema(1) length(1) sequence(2) crc(2) */
+
+/** Current payload schema; bump and add a migration step when ptx_oven_config_t changes */
+#define PTX_CONFIG_STORE_SCHEMA      5U
+
+/**
+ * @brief Result of a load or save operation
+ */
+typedef enum {
+    PTX_CONFIG_STORE_OK = 0,     /**< Record loaded/saved */
+    PTX_CONFIG_STORE_MIGRATED,   /**< Older schema loaded and migrated forward */
+    PTX_CONFIG_STORE_UNCHANGED,  /**< Save skipped: newest record already matches */
+    PTX_CONFIG_STORE_EMPTY,      /**< No valid record found; configuration left unchanged */
+    PTX_CONFIG_STORE_INVALID,    /**< Record intact but rejected by ptx_oven_config_validate() */
+    PTX_CONFIG_STORE_ERROR       /**< EEPROM too small or configuration busy */
+} ptx_config_store_result_t;
+
+/**
+ * @brief Load the newest valid record and publish it as the active configuration
+ * @return PTX_CONFIG_STORE_OK, _MIGRATED, _EMPTY, _INVALID or _ERROR
+ * @note Bounded: reads PTX_CONFIG_STORE_SLOTS headers and one payload per
+ *       candidate. Call once from setup() before the control loop starts.
+ */
+ptx_config_store_result_t ptx_config_store_load(void);
+
+/**
+ * @brief Persist the active configuration
+ * @return PTX_CONFIG_STORE_OK, _UNCHANGED or _ERROR
+ * @note Writes the next slot in rotation. Wear is spread by the rotation;
+ *       eeprom_update() only skips bytes that still match the record that
+ *       slot held PTX_CONFIG_STORE_SLOTS saves ago, so the header is
+ *       always rewritten and most payload bytes usually are too.
+ */
+ptx_config_store_result_t ptx_config_store_save(void);
+
+/**
+ * @brief Invalidate every stored record (factory reset)
+ */
+void ptx_config_store_erase(void);
+
+/**
+ * @brief Sequence number of the newest valid record
+ * @return Sequence number, or 0 if the store is empty
+ */
+uint16_t ptx_config_store_get_sequence(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PTX_CONFIG_STORE_H */
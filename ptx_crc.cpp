@@ -0,0 +1,15 @@
+/**
+ * @file ptx_crc.cpp
+ * @brief Implementation of CRC helpers
+ */
+#include "ptx_crc.h"
+
+uint16_t ptx_crc16_update(uint16_t crc, const uint8_t* data, uint16_t len) {
+    for (uint16_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000U) ? (uint16_t)((crc << 1) ^ 0x1021U) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
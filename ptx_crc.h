@@ -0,0 +1,31 @@
+/**
+ * @file ptx_crc.h
+ * @brief CRC helpers shared by persistent storage and serial framing
+ */
+#ifndef PTX_CRC_H
+#define PTX_CRC_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Initial value for ptx_crc16_update() (CRC-16/CCITT-FALSE) */
+#define PTX_CRC16_INIT 0xFFFFU
+
+/**
+ * @brief Feed bytes into a CRC-16/CCITT-FALSE (poly 0x1021, no reflection)
+ * @param crc Running CRC (start with PTX_CRC16_INIT)
+ * @param data Bytes to add
+ * @param len Number of bytes
+ * @return Updated CRC
+ * @note Bitwise implementation: no lookup table, so no flash/SRAM cost on AVR.
+ */
+uint16_t ptx_crc16_update(uint16_t crc, const uint8_t* data, uint16_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PTX_CRC_H */
@@ -8,11 +8,27 @@ Then check `notes.md`.
 #include "api.h"
 #include "ptx_logging.h"
 #include "ptx_oven_control.h"
+#include "ptx_oven_zones.h"
 #include "ptx_actuator.h"
+#include "ptx_config_store.h"
+#include "ptx_cmd_protocol.h"
 
 void setup() {
   ptx_log_init();
+
+  // Restore field-tuned parameters; defaults stay active if nothing valid is stored
+  ptx_config_store_result_t store_result = ptx_config_store_load();
+  if (store_result != PTX_CONFIG_STORE_OK) {
+    PTX_LOGF("config store load result=%d, using %s", (int)store_result,
+             (store_result == PTX_CONFIG_STORE_MIGRATED) ? "migrated config" : "defaults");
+  }
+
+#if (PTX_OVEN_MULTI_ZONE_ENABLED)
+  ptx_oven_zones_init(PTX_OVEN_MAX_ZONES);
+#else
   ptx_oven_control_init();
+#endif
+  ptx_cmd_init();
   setup_api();
 
   PTX_LOGF("Elf oven 2000 starting up.");
@@ -22,17 +38,27 @@ void setup() {
 // Immediate safety: cut GAS & IGNITER if door opens.
 void door_sensor_interrupt_handler(bool voltage_high)
 {
+  uint32_t entry_us = get_micros();  // stop latency is measured from here
   // TODO: add small filtering for stability if needed
   if (voltage_high) {
-    ptx_actuator_emergency_stop();
+    ptx_actuator_emergency_stop_from(entry_us);
   }
   // Propagate state to controller; controller loop will handle any logging.
+#if (PTX_OVEN_MULTI_ZONE_ENABLED)
+  ptx_oven_zones_set_door_state(voltage_high);
+#else
   ptx_oven_set_door_state(voltage_high);
+#endif
 }
 
 
 void loop() {
-  // Run oven control loop
+  // Handle runtime configuration commands, then run oven control loop
+  ptx_cmd_poll();
+#if (PTX_OVEN_MULTI_ZONE_ENABLED)
+  ptx_oven_zones_update();
+#else
   ptx_oven_control_update();
+#endif
   delay(50); // ~20 Hz control loop; module logs once per second
 }
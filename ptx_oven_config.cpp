@@ -1,12 +1,30 @@
 /**
  * @file ptx_oven_config.cpp
  * @brief Implementation of runtime-configurable oven parameters
+ * @details Configuration is double-buffered. Readers use the published slot;
+ *          writers copy it into the inactive slot, modify and validate the copy,
+ *          then flip the published index. The control tick pins its slot for the
+ *          whole update so a writer (e.g. serial handler or ISR) never modifies
+ *          the data the controller is reading.
  */
 #include "ptx_oven_config.h"
+#include "ptx_oven_profile.h"
 #include <stddef.h>
 
-/* Internal configuration state */
-static ptx_oven_config_t pti_oven_config = {
+#define PTX_CONFIG_SLOT_NONE 0xFFU
+
+/* Writers and the pinning reader may run from an ISR: index test-and-set
+   sequences must not interleave with them */
+#if defined(__AVR__)
+#include <avr/interrupt.h>
+#define PTX_CONFIG_LOCK()   uint8_t pti_sreg = SREG; cli()
+#define PTX_CONFIG_UNLOCK() SREG = pti_sreg
+#else
+#define PTX_CONFIG_LOCK()   ((void)0)
+#define PTX_CONFIG_UNLOCK() ((void)0)
+#endif
+
+static const ptx_oven_config_t pti_default_config = {
     .ignition_duration_ms   = 5000U,  /* 5 seconds igniter ON */
     .periodic_log_ms        = 1000U,  /* log every second */
     .sensor_fault_window_ms = 1000U,  /* fault after 1s out-of-range */
@@ -17,135 +35,343 @@ static ptx_oven_config_t pti_oven_config = {
     .temp_delta_c           = 5.0f,   /* hysteresis half-band */
     .max_ignition_attempts  = 3U,     /* 3 ignition retry attempts */
     .purge_time_ms          = 2500U,  /* 2.5 seconds purge after failed ignition */
-    .flame_detect_temp_rise_c = 2.0f  /* 2°C temperature rise to detect flame */
+    .flame_detect_temp_rise_c = 2.0f, /* 2°C temperature rise to detect flame */
+    .control_mode           = PTX_CONTROL_MODE_HYSTERESIS,
+    .pid_kp                 = 0.05f,  /* full duty at 20°C below target */
+    .pid_ki                 = 0.0005f,
+    .pid_kd                 = 0.5f,
+    .pid_window_ms          = 30000U, /* 30 s burner window */
+    .predict_lead_ms        = 0U,     /* no predictive switching */
+    .preignite_enabled      = 0U      /* ignite at the ON threshold */
 };
 
+/* A slot holds the user-facing config and its compiled hot-path form */
+typedef struct {
+    ptx_oven_config_t          config;
+    ptx_oven_config_compiled_t compiled;
+} pti_config_slot_t;
+
+/* Internal configuration state: two slots plus published/pinned indices */
+static pti_config_slot_t pti_config_slots[2];
+static volatile uint8_t pti_active_slot = 0;
+static uint32_t pti_config_version = 0;
+static volatile uint8_t pti_pinned_slot = PTX_CONFIG_SLOT_NONE;
+static volatile bool pti_write_in_progress = false;
+
+/* Publish defaults on first use so the compiled slot is never stale */
+static void ptx_config_ensure_init(void) {
+    if (pti_config_version == 0) {
+        pti_config_slots[0].config = pti_default_config;
+        ptx_oven_config_compile(&pti_default_config, &pti_config_slots[0].compiled);
+        pti_config_slots[0].compiled.version = ++pti_config_version;
+        pti_active_slot = 0;
+    }
+}
+
+/* Conversions are shared with ptx_oven_profile_view<> so both build modes compile identically */
+uint32_t ptx_oven_temp_to_ratio_q16(float temp_c) {
+    /* Inverse of the sensor map: -10 °C at 10% vref, 300 °C at 90% vref */
+    return ptx_temp_to_ratio_q16_constexpr(temp_c);
+}
+
+void ptx_oven_config_compile(const ptx_oven_config_t* config, ptx_oven_config_compiled_t* compiled) {
+    compiled->vref_min_mv    = ptx_volts_to_mv_constexpr(config->vref_min_v);
+    compiled->vref_max_mv    = ptx_volts_to_mv_constexpr(config->vref_max_v);
+    compiled->signal_lo_q16  = PTX_SIGNAL_LO_Q16;
+    compiled->signal_hi_q16  = PTX_SIGNAL_HI_Q16;
+    compiled->temp_on_q16    = ptx_oven_temp_to_ratio_q16(config->temp_target_c - config->temp_delta_c);
+    compiled->temp_off_q16   = ptx_oven_temp_to_ratio_q16(config->temp_target_c + config->temp_delta_c);
+    compiled->flame_rise_q16 = ptx_temp_rise_to_ratio_q16_constexpr(config->flame_detect_temp_rise_c);
+}
+
+/**
+ * Stage a copy of the published config in the inactive slot.
+ * Returns NULL if another write is in progress, the inactive slot is still
+ * pinned by a reader (a second reconfiguration within one control tick), or
+ * the build bakes in a compile-time profile.
+ */
+static ptx_oven_config_t* ptx_config_begin_write(void) {
+#if defined(PTX_OVEN_PROFILE)
+    /* The tick runs on the baked-in profile; a published write would be ignored */
+    return NULL;
+#else
+    ptx_config_ensure_init();
+    PTX_CONFIG_LOCK();
+    uint8_t target = (uint8_t)(pti_active_slot ^ 1U);
+    bool busy = pti_write_in_progress || target == pti_pinned_slot;
+    if (!busy) pti_write_in_progress = true;
+    PTX_CONFIG_UNLOCK();
+    if (busy) return NULL;
+
+    pti_config_slots[target].config = pti_config_slots[pti_active_slot].config;
+    return &pti_config_slots[target].config;
+#endif
+}
+
+/* Validate and compile the staged slot, then publish it; the single-byte index store is atomic */
+static bool ptx_config_commit(ptx_oven_config_t* staged) {
+    uint8_t target = (uint8_t)(pti_active_slot ^ 1U);
+    bool ok = ptx_oven_config_validate(staged);
+    if (ok) {
+        ptx_oven_config_compile(staged, &pti_config_slots[target].compiled);
+        pti_config_slots[target].compiled.version = ++pti_config_version;
+        pti_active_slot = target;
+    }
+    pti_write_in_progress = false;
+    return ok;
+}
+
+bool ptx_oven_config_validate(const ptx_oven_config_t* config) {
+    if (config == NULL) return false;
+    return config->ignition_duration_ms >= 1000 && config->ignition_duration_ms <= 30000 &&
+           config->periodic_log_ms >= 100 && config->periodic_log_ms <= 60000 &&
+           config->sensor_fault_window_ms >= 100 && config->sensor_fault_window_ms <= 10000 &&
+           config->auto_resume_delay_ms >= 1000 && config->auto_resume_delay_ms <= 30000 &&
+           config->vref_min_v >= 0.0f && config->vref_min_v <= 10.0f &&
+           config->vref_max_v >= 0.0f && config->vref_max_v <= 10.0f &&
+           config->vref_min_v < config->vref_max_v &&
+           config->temp_target_c >= 0.0f && config->temp_target_c <= 300.0f &&
+           config->temp_delta_c >= 0.1f && config->temp_delta_c <= 50.0f &&
+           config->max_ignition_attempts >= 1 && config->max_ignition_attempts <= 10 &&
+           config->purge_time_ms >= 1000 && config->purge_time_ms <= 10000 &&
+           config->flame_detect_temp_rise_c > 0.0f && config->flame_detect_temp_rise_c <= 50.0f &&
+           config->control_mode <= PTX_CONTROL_MODE_PID &&
+           config->pid_kp >= 0.0f && config->pid_kp <= 10.0f &&
+           config->pid_ki >= 0.0f && config->pid_ki <= 1.0f &&
+           config->pid_kd >= 0.0f && config->pid_kd <= 100.0f &&
+           config->pid_window_ms <= 600000 &&
+           config->predict_lead_ms <= 30000 &&
+           config->preignite_enabled <= 1 &&
+           /* A window must hold one ignition and one purge when it is in use */
+           (config->control_mode == PTX_CONTROL_MODE_HYSTERESIS ||
+            config->pid_window_ms >= config->ignition_duration_ms + config->purge_time_ms);
+}
+
 const ptx_oven_config_t* ptx_oven_get_config(void) {
-    return &pti_oven_config;
+    ptx_config_ensure_init();
+    return &pti_config_slots[pti_active_slot].config;
 }
 
-void ptx_oven_set_config(const ptx_oven_config_t* config) {
+const ptx_oven_config_compiled_t* ptx_oven_get_compiled_config(void) {
+    ptx_config_ensure_init();
+    return &pti_config_slots[pti_active_slot].compiled;
+}
+
+const ptx_oven_config_t* ptx_oven_config_pin(void) {
+    ptx_config_ensure_init();
+    PTX_CONFIG_LOCK();
+    uint8_t slot = pti_active_slot;
+    pti_pinned_slot = slot;
+    PTX_CONFIG_UNLOCK();
+    return &pti_config_slots[slot].config;
+}
+
+const ptx_oven_config_compiled_t* ptx_oven_config_pinned_compiled(void) {
+    uint8_t slot = pti_pinned_slot;
+    if (slot == PTX_CONFIG_SLOT_NONE) return NULL;
+    return &pti_config_slots[slot].compiled;
+}
+
+void ptx_oven_config_unpin(void) {
+    pti_pinned_slot = PTX_CONFIG_SLOT_NONE;
+}
+
+bool ptx_oven_set_config(const ptx_oven_config_t* config) {
+    if (config == NULL) return false;
+    ptx_oven_config_t* next = ptx_config_begin_write();
+    if (next == NULL) return false;
+    *next = *config;
+    return ptx_config_commit(next);
+}
+
+bool ptx_oven_reset_config_to_defaults(void) {
+    return ptx_oven_set_config(&pti_default_config);
+}
+
+void ptx_oven_get_default_config(ptx_oven_config_t* config) {
     if (config != NULL) {
-        pti_oven_config = *config;
+        *config = pti_default_config;
     }
 }
 
-void ptx_oven_reset_config_to_defaults(void) {
-    pti_oven_config.ignition_duration_ms   = 5000U;
-    pti_oven_config.periodic_log_ms        = 1000U;
-    pti_oven_config.sensor_fault_window_ms = 1000U;
-    pti_oven_config.auto_resume_delay_ms   = 3000U;
-    pti_oven_config.vref_min_v             = 4.5f;
-    pti_oven_config.vref_max_v             = 5.5f;
-    pti_oven_config.temp_target_c          = 180.0f;
-    pti_oven_config.temp_delta_c           = 5.0f;
-    pti_oven_config.max_ignition_attempts  = 3U;
-    pti_oven_config.purge_time_ms          = 2500U;
-    pti_oven_config.flame_detect_temp_rise_c = 2.0f;
-}
-
-/* Individual parameter setters */
-void ptx_oven_set_ignition_duration_ms(uint32_t duration_ms) {
-    if (duration_ms >= 1000 && duration_ms <= 30000) {
-        pti_oven_config.ignition_duration_ms = duration_ms;
-    }
+/* Individual parameter setters: stage, modify one field, validate and publish.
+   Out-of-range values fail validation and leave the published config unchanged. */
+bool ptx_oven_set_ignition_duration_ms(uint32_t duration_ms) {
+    ptx_oven_config_t* next = ptx_config_begin_write();
+    if (next == NULL) return false;
+    next->ignition_duration_ms = duration_ms;
+    return ptx_config_commit(next);
 }
 
 uint32_t ptx_oven_get_ignition_duration_ms(void) {
-    return pti_oven_config.ignition_duration_ms;
+    return ptx_oven_get_config()->ignition_duration_ms;
 }
 
-void ptx_oven_set_periodic_log_ms(uint32_t interval_ms) {
-    if (interval_ms >= 100 && interval_ms <= 60000) {
-        pti_oven_config.periodic_log_ms = interval_ms;
-    }
+bool ptx_oven_set_periodic_log_ms(uint32_t interval_ms) {
+    ptx_oven_config_t* next = ptx_config_begin_write();
+    if (next == NULL) return false;
+    next->periodic_log_ms = interval_ms;
+    return ptx_config_commit(next);
 }
 
 uint32_t ptx_oven_get_periodic_log_ms(void) {
-    return pti_oven_config.periodic_log_ms;
+    return ptx_oven_get_config()->periodic_log_ms;
 }
 
-void ptx_oven_set_sensor_fault_window_ms(uint32_t window_ms) {
-    if (window_ms >= 100 && window_ms <= 10000) {
-        pti_oven_config.sensor_fault_window_ms = window_ms;
-    }
+bool ptx_oven_set_sensor_fault_window_ms(uint32_t window_ms) {
+    ptx_oven_config_t* next = ptx_config_begin_write();
+    if (next == NULL) return false;
+    next->sensor_fault_window_ms = window_ms;
+    return ptx_config_commit(next);
 }
 
 uint32_t ptx_oven_get_sensor_fault_window_ms(void) {
-    return pti_oven_config.sensor_fault_window_ms;
+    return ptx_oven_get_config()->sensor_fault_window_ms;
 }
 
-void ptx_oven_set_auto_resume_delay_ms(uint32_t delay_ms) {
-    if (delay_ms >= 1000 && delay_ms <= 30000) {
-        pti_oven_config.auto_resume_delay_ms = delay_ms;
-    }
+bool ptx_oven_set_auto_resume_delay_ms(uint32_t delay_ms) {
+    ptx_oven_config_t* next = ptx_config_begin_write();
+    if (next == NULL) return false;
+    next->auto_resume_delay_ms = delay_ms;
+    return ptx_config_commit(next);
 }
 
 uint32_t ptx_oven_get_auto_resume_delay_ms(void) {
-    return pti_oven_config.auto_resume_delay_ms;
+    return ptx_oven_get_config()->auto_resume_delay_ms;
 }
 
-void ptx_oven_set_vref_range_v(float min_v, float max_v) {
-    if (min_v >= 0.0f && min_v <= 10.0f && max_v >= 0.0f && max_v <= 10.0f && min_v < max_v) {
-        pti_oven_config.vref_min_v = min_v;
-        pti_oven_config.vref_max_v = max_v;
-    }
+bool ptx_oven_set_vref_range_v(float min_v, float max_v) {
+    ptx_oven_config_t* next = ptx_config_begin_write();
+    if (next == NULL) return false;
+    next->vref_min_v = min_v;
+    next->vref_max_v = max_v;
+    return ptx_config_commit(next);
 }
 
 float ptx_oven_get_vref_min_v(void) {
-    return pti_oven_config.vref_min_v;
+    return ptx_oven_get_config()->vref_min_v;
 }
 
 float ptx_oven_get_vref_max_v(void) {
-    return pti_oven_config.vref_max_v;
+    return ptx_oven_get_config()->vref_max_v;
 }
 
-void ptx_oven_set_temp_target_c(float target_c) {
-    if (target_c >= 0.0f && target_c <= 300.0f) {
-        pti_oven_config.temp_target_c = target_c;
-    }
+bool ptx_oven_set_temp_target_c(float target_c) {
+    ptx_oven_config_t* next = ptx_config_begin_write();
+    if (next == NULL) return false;
+    next->temp_target_c = target_c;
+    return ptx_config_commit(next);
 }
 
 float ptx_oven_get_temp_target_c(void) {
-    return pti_oven_config.temp_target_c;
+    return ptx_oven_get_config()->temp_target_c;
 }
 
-void ptx_oven_set_temp_delta_c(float delta_c) {
-    if (delta_c >= 0.1f && delta_c <= 50.0f) {
-        pti_oven_config.temp_delta_c = delta_c;
-    }
+bool ptx_oven_set_temp_delta_c(float delta_c) {
+    ptx_oven_config_t* next = ptx_config_begin_write();
+    if (next == NULL) return false;
+    next->temp_delta_c = delta_c;
+    return ptx_config_commit(next);
 }
 
 float ptx_oven_get_temp_delta_c(void) {
-    return pti_oven_config.temp_delta_c;
+    return ptx_oven_get_config()->temp_delta_c;
 }
 
-void ptx_oven_set_max_ignition_attempts(uint8_t attempts) {
-    if (attempts >= 1 && attempts <= 10) {
-        pti_oven_config.max_ignition_attempts = attempts;
-    }
+bool ptx_oven_set_max_ignition_attempts(uint8_t attempts) {
+    ptx_oven_config_t* next = ptx_config_begin_write();
+    if (next == NULL) return false;
+    next->max_ignition_attempts = attempts;
+    return ptx_config_commit(next);
 }
 
 uint8_t ptx_oven_get_max_ignition_attempts(void) {
-    return pti_oven_config.max_ignition_attempts;
+    return ptx_oven_get_config()->max_ignition_attempts;
 }
 
-void ptx_oven_set_purge_time_ms(uint32_t purge_ms) {
-    if (purge_ms >= 1000 && purge_ms <= 10000) {
-        pti_oven_config.purge_time_ms = purge_ms;
-    }
+bool ptx_oven_set_purge_time_ms(uint32_t purge_ms) {
+    ptx_oven_config_t* next = ptx_config_begin_write();
+    if (next == NULL) return false;
+    next->purge_time_ms = purge_ms;
+    return ptx_config_commit(next);
 }
 
 uint32_t ptx_oven_get_purge_time_ms(void) {
-    return pti_oven_config.purge_time_ms;
+    return ptx_oven_get_config()->purge_time_ms;
 }
 
-void ptx_oven_set_flame_detect_temp_rise_c(float temp_rise_c) {
-    if (temp_rise_c > 0.0f && temp_rise_c <= 50.0f) {
-        pti_oven_config.flame_detect_temp_rise_c = temp_rise_c;
-    }
+bool ptx_oven_set_flame_detect_temp_rise_c(float temp_rise_c) {
+    ptx_oven_config_t* next = ptx_config_begin_write();
+    if (next == NULL) return false;
+    next->flame_detect_temp_rise_c = temp_rise_c;
+    return ptx_config_commit(next);
 }
 
 float ptx_oven_get_flame_detect_temp_rise_c(void) {
-    return pti_oven_config.flame_detect_temp_rise_c;
+    return ptx_oven_get_config()->flame_detect_temp_rise_c;
+}
+
+bool ptx_oven_set_control_mode(uint8_t mode) {
+    ptx_oven_config_t* next = ptx_config_begin_write();
+    if (next == NULL) return false;
+    next->control_mode = mode;
+    return ptx_config_commit(next);
+}
+
+uint8_t ptx_oven_get_control_mode(void) {
+    return ptx_oven_get_config()->control_mode;
+}
+
+bool ptx_oven_set_pid_gains(float kp, float ki, float kd) {
+    ptx_oven_config_t* next = ptx_config_begin_write();
+    if (next == NULL) return false;
+    next->pid_kp = kp;
+    next->pid_ki = ki;
+    next->pid_kd = kd;
+    return ptx_config_commit(next);
+}
+
+float ptx_oven_get_pid_kp(void) {
+    return ptx_oven_get_config()->pid_kp;
+}
+
+float ptx_oven_get_pid_ki(void) {
+    return ptx_oven_get_config()->pid_ki;
+}
+
+float ptx_oven_get_pid_kd(void) {
+    return ptx_oven_get_config()->pid_kd;
+}
+
+bool ptx_oven_set_pid_window_ms(uint32_t window_ms) {
+    ptx_oven_config_t* next = ptx_config_begin_write();
+    if (next == NULL) return false;
+    next->pid_window_ms = window_ms;
+    return ptx_config_commit(next);
+}
+
+uint32_t ptx_oven_get_pid_window_ms(void) {
+    return ptx_oven_get_config()->pid_window_ms;
+}
+
+bool ptx_oven_set_predict_lead_ms(uint32_t lead_ms) {
+    ptx_oven_config_t* next = ptx_config_begin_write();
+    if (next == NULL) return false;
+    next->predict_lead_ms = lead_ms;
+    return ptx_config_commit(next);
+}
+
+uint32_t ptx_oven_get_predict_lead_ms(void) {
+    return ptx_oven_get_config()->predict_lead_ms;
+}
+
+bool ptx_oven_set_preignite_enabled(uint8_t enabled) {
+    ptx_oven_config_t* next = ptx_config_begin_write();
+    if (next == NULL) return false;
+    next->preignite_enabled = enabled;
+    return ptx_config_commit(next);
+}
+
+uint8_t ptx_oven_get_preignite_enabled(void) {
+    return ptx_oven_get_config()->preignite_enabled;
 }
@@ -3,6 +3,8 @@
  * @brief Configuration parameters for oven controller
  * @details Centralized timing, sensor thresholds, and safety parameters.
  *          All parameters are runtime-configurable via setter functions.
+ *          Storage is double-buffered so updates from a serial handler or ISR
+ *          never tear the configuration read by the control tick.
  */
 #ifndef PTX_OVEN_CONFIG_H
 #define PTX_OVEN_CONFIG_H
@@ -14,6 +16,15 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Temperature control law
+ */
+typedef enum {
+    PTX_CONTROL_MODE_HYSTERESIS = 0,  /**< Bang-bang: ON at target - delta, OFF at target + delta */
+    PTX_CONTROL_MODE_PI,              /**< PI duty cycle in time-proportioning burner windows */
+    PTX_CONTROL_MODE_PID              /**< As PI, plus derivative on the measurement */
+} ptx_control_mode_t;
+
 /**
  * @brief Oven configuration structure with runtime-adjustable parameters
  */
@@ -31,31 +42,125 @@ typedef struct {
     uint8_t  max_ignition_attempts;   /**< Maximum number of ignition retry attempts (default: 3) */
     uint32_t purge_time_ms;           /**< Gas purge time after failed ignition (default: 2500ms) */
     float    flame_detect_temp_rise_c; /**< Minimum temperature rise to detect flame (default: 2.0°C) */
+
+    /* Temperature control law (see ptx_pid.h) */
+    uint8_t  control_mode;            /**< ptx_control_mode_t (default: hysteresis) */
+    float    pid_kp;                  /**< Proportional gain, duty per °C (default: 0.05) */
+    float    pid_ki;                  /**< Integral gain, duty per °C·s (default: 0.0005) */
+    float    pid_kd;                  /**< Derivative gain, duty per °C/s, PID mode only (default: 0.5) */
+    uint32_t pid_window_ms;           /**< Burner time-proportioning window (default: 30000ms) */
+    uint32_t predict_lead_ms;         /**< Rate-of-rise lookahead for early cut/relight, 0 = off (default: 0) */
+    uint8_t  preignite_enabled;       /**< Start ignition ahead of the ON threshold while falling, 0/1 (default: 0) */
 } ptx_oven_config_t;
 
+/** Ratiometric fixed point: signal/vref ratio scaled by 2^16 */
+#define PTX_RATIO_Q16_ONE 65536UL
+
+/** Valid sensor window, 10%..90% of vref inclusive, as Q16 ratios rounded down
+    (the measured ratio is truncated, so a reading exactly on a limit is in range) */
+#define PTX_SIGNAL_LO_Q16 (PTX_RATIO_Q16_ONE / 10UL)
+#define PTX_SIGNAL_HI_Q16 (PTX_RATIO_Q16_ONE * 9UL / 10UL)
+
+/**
+ * @brief Hot-path form of the configuration, derived on every publish
+ * @details Thresholds are integers in the units the control tick already has:
+ *          vref limits in mV and temperature thresholds as signal/vref ratios
+ *          in Q16, so the tick compares integers without float math.
+ */
+typedef struct {
+    uint32_t version;         /**< Incremented on every published configuration */
+    uint16_t vref_min_mv;     /**< vref_min_v in millivolts */
+    uint16_t vref_max_mv;     /**< vref_max_v in millivolts */
+    uint32_t signal_lo_q16;   /**< Lowest valid signal ratio (10% of vref, -10 °C) */
+    uint32_t signal_hi_q16;   /**< Highest valid signal ratio (90% of vref, 300 °C) */
+    uint32_t temp_on_q16;     /**< Ratio at temp_target_c - temp_delta_c (heat on) */
+    uint32_t temp_off_q16;    /**< Ratio at temp_target_c + temp_delta_c (heat off) */
+    uint32_t flame_rise_q16;  /**< Ratio increase equal to flame_detect_temp_rise_c */
+} ptx_oven_config_compiled_t;
+
 /**
  * @brief Get pointer to current configuration (read-only access)
  * @return Pointer to const configuration structure
+ * @note Points at the published slot; a concurrent writer may publish a new
+ *       slot at any time. Use ptx_oven_config_pin() for multi-field reads
+ *       that must be consistent.
  */
 const ptx_oven_config_t* ptx_oven_get_config(void);
 
+/**
+ * @brief Pin the published configuration slot for a consistent read
+ * @return Pointer to the pinned configuration; stays valid and unmodified
+ *         until ptx_oven_config_unpin()
+ * @note Used by the control tick. Only one pin may be held at a time. While
+ *       pinned, one writer can still publish into the other slot; further
+ *       writes are rejected until unpin, so writers never block the reader.
+ */
+const ptx_oven_config_t* ptx_oven_config_pin(void);
+
+/**
+ * @brief Release the slot pinned by ptx_oven_config_pin()
+ */
+void ptx_oven_config_unpin(void);
+
+/**
+ * @brief Get the compiled form of the slot held by ptx_oven_config_pin()
+ * @return Pointer to compiled thresholds, or NULL if nothing is pinned
+ */
+const ptx_oven_config_compiled_t* ptx_oven_config_pinned_compiled(void);
+
+/**
+ * @brief Get the compiled form of the published configuration
+ * @return Pointer to compiled thresholds of the current slot
+ */
+const ptx_oven_config_compiled_t* ptx_oven_get_compiled_config(void);
+
+/**
+ * @brief Derive hot-path thresholds from a configuration
+ * @param config Source configuration (must be valid)
+ * @param compiled Destination; version is left untouched
+ */
+void ptx_oven_config_compile(const ptx_oven_config_t* config, ptx_oven_config_compiled_t* compiled);
+
+/**
+ * @brief Convert a temperature to its signal/vref ratio (Q16)
+ * @param temp_c Temperature in °C (not clamped to the sensor range)
+ * @return Ratio in Q16, saturated at 0
+ */
+uint32_t ptx_oven_temp_to_ratio_q16(float temp_c);
+
+/**
+ * @brief Check every field of a configuration against its allowed range
+ * @param config Configuration to check
+ * @return true if the configuration may be published
+ */
+bool ptx_oven_config_validate(const ptx_oven_config_t* config);
+
 /**
  * @brief Update oven configuration with new parameters
  * @param config Pointer to new configuration structure
+ * @return true if published; false if invalid or the inactive slot is busy
  * @note Changes take effect immediately on next control update
  */
-void ptx_oven_set_config(const ptx_oven_config_t* config);
+bool ptx_oven_set_config(const ptx_oven_config_t* config);
 
 /**
  * @brief Reset configuration to default values
+ * @return true if published; false if the inactive slot is busy
  */
-void ptx_oven_reset_config_to_defaults(void);
+bool ptx_oven_reset_config_to_defaults(void);
+
+/**
+ * @brief Copy the built-in default configuration
+ * @param config Destination (must not be NULL)
+ */
+void ptx_oven_get_default_config(ptx_oven_config_t* config);
 
 /**
  * @brief Set ignition duration (milliseconds)
  * @param duration_ms Duration igniter stays ON after gas opens
+ * @return true if published; false if out of range or a write is in progress
  */
-void ptx_oven_set_ignition_duration_ms(uint32_t duration_ms);
+bool ptx_oven_set_ignition_duration_ms(uint32_t duration_ms);
 
 /**
  * @brief Get ignition duration (milliseconds)
@@ -66,8 +171,9 @@ uint32_t ptx_oven_get_ignition_duration_ms(void);
 /**
  * @brief Set periodic log interval (milliseconds)
  * @param interval_ms Interval between status logs
+ * @return true if published; false if out of range or a write is in progress
  */
-void ptx_oven_set_periodic_log_ms(uint32_t interval_ms);
+bool ptx_oven_set_periodic_log_ms(uint32_t interval_ms);
 
 /**
  * @brief Get periodic log interval (milliseconds)
@@ -78,8 +184,9 @@ uint32_t ptx_oven_get_periodic_log_ms(void);
 /**
  * @brief Set sensor fault window (milliseconds)
  * @param window_ms Duration out-of-range must persist to latch fault
+ * @return true if published; false if out of range or a write is in progress
  */
-void ptx_oven_set_sensor_fault_window_ms(uint32_t window_ms);
+bool ptx_oven_set_sensor_fault_window_ms(uint32_t window_ms);
 
 /**
  * @brief Get sensor fault window (milliseconds)
@@ -90,8 +197,9 @@ uint32_t ptx_oven_get_sensor_fault_window_ms(void);
 /**
  * @brief Set auto-resume delay (milliseconds)
  * @param delay_ms Duration of valid readings required before clearing fault
+ * @return true if published; false if out of range or a write is in progress
  */
-void ptx_oven_set_auto_resume_delay_ms(uint32_t delay_ms);
+bool ptx_oven_set_auto_resume_delay_ms(uint32_t delay_ms);
 
 /**
  * @brief Get auto-resume delay (milliseconds)
@@ -103,8 +211,9 @@ uint32_t ptx_oven_get_auto_resume_delay_ms(void);
  * @brief Set reference voltage range (volts)
  * @param min_v Minimum acceptable vref
  * @param max_v Maximum acceptable vref
+ * @return true if published; false if out of range or a write is in progress
  */
-void ptx_oven_set_vref_range_v(float min_v, float max_v);
+bool ptx_oven_set_vref_range_v(float min_v, float max_v);
 
 /**
  * @brief Get minimum reference voltage (volts)
@@ -121,8 +230,9 @@ float ptx_oven_get_vref_max_v(void);
 /**
  * @brief Set target temperature (°C)
  * @param target_c Desired control temperature
+ * @return true if published; false if out of range or a write is in progress
  */
-void ptx_oven_set_temp_target_c(float target_c);
+bool ptx_oven_set_temp_target_c(float target_c);
 
 /**
  * @brief Get target temperature (°C)
@@ -133,8 +243,9 @@ float ptx_oven_get_temp_target_c(void);
 /**
  * @brief Set hysteresis half-band (°C)
  * @param delta_c Half-band around target for ON/OFF thresholds
+ * @return true if published; false if out of range or a write is in progress
  */
-void ptx_oven_set_temp_delta_c(float delta_c);
+bool ptx_oven_set_temp_delta_c(float delta_c);
 
 /**
  * @brief Get hysteresis half-band (°C)
@@ -145,8 +256,9 @@ float ptx_oven_get_temp_delta_c(void);
 /**
  * @brief Set maximum ignition attempts
  * @param attempts Maximum number of ignition retry attempts (1-5)
+ * @return true if published; false if out of range or a write is in progress
  */
-void ptx_oven_set_max_ignition_attempts(uint8_t attempts);
+bool ptx_oven_set_max_ignition_attempts(uint8_t attempts);
 
 /**
  * @brief Get maximum ignition attempts
@@ -157,8 +269,9 @@ uint8_t ptx_oven_get_max_ignition_attempts(void);
 /**
  * @brief Set purge time after failed ignition (milliseconds)
  * @param purge_ms Gas purge duration before retry
+ * @return true if published; false if out of range or a write is in progress
  */
-void ptx_oven_set_purge_time_ms(uint32_t purge_ms);
+bool ptx_oven_set_purge_time_ms(uint32_t purge_ms);
 
 /**
  * @brief Get purge time after failed ignition (milliseconds)
@@ -169,8 +282,9 @@ uint32_t ptx_oven_get_purge_time_ms(void);
 /**
  * @brief Set flame detection temperature rise threshold (°C)
  * @param temp_rise_c Minimum temperature rise to confirm ignition
+ * @return true if published; false if out of range or a write is in progress
  */
-void ptx_oven_set_flame_detect_temp_rise_c(float temp_rise_c);
+bool ptx_oven_set_flame_detect_temp_rise_c(float temp_rise_c);
 
 /**
  * @brief Get flame detection temperature rise threshold (°C)
@@ -178,6 +292,88 @@ void ptx_oven_set_flame_detect_temp_rise_c(float temp_rise_c);
  */
 float ptx_oven_get_flame_detect_temp_rise_c(void);
 
+/**
+ * @brief Set temperature control law
+ * @param mode ptx_control_mode_t
+ * @return true if published; false if out of range or a write is in progress
+ */
+bool ptx_oven_set_control_mode(uint8_t mode);
+
+/**
+ * @brief Get temperature control law
+ * @return Current ptx_control_mode_t
+ */
+uint8_t ptx_oven_get_control_mode(void);
+
+/**
+ * @brief Set PI/PID gains
+ * @param kp Proportional gain (duty per °C)
+ * @param ki Integral gain (duty per °C·s)
+ * @param kd Derivative gain (duty per °C/s)
+ * @return true if published; false if out of range or a write is in progress
+ */
+bool ptx_oven_set_pid_gains(float kp, float ki, float kd);
+
+/**
+ * @brief Get proportional gain
+ * @return Current kp
+ */
+float ptx_oven_get_pid_kp(void);
+
+/**
+ * @brief Get integral gain
+ * @return Current ki
+ */
+float ptx_oven_get_pid_ki(void);
+
+/**
+ * @brief Get derivative gain
+ * @return Current kd
+ */
+float ptx_oven_get_pid_kd(void);
+
+/**
+ * @brief Set burner time-proportioning window (milliseconds)
+ * @param window_ms Window length; must hold one ignition and one purge
+ * @return true if published; false if out of range or a write is in progress
+ */
+bool ptx_oven_set_pid_window_ms(uint32_t window_ms);
+
+/**
+ * @brief Get burner time-proportioning window (milliseconds)
+ * @return Current window length
+ */
+uint32_t ptx_oven_get_pid_window_ms(void);
+
+/**
+ * @brief Set the predictive switching lookahead (milliseconds)
+ * @param lead_ms Time the temperature is extrapolated ahead at its current rate
+ *        of rise; about the heat dead time plus the filter delay. 0 disables it.
+ * @return true if published; false if out of range or a write is in progress
+ */
+bool ptx_oven_set_predict_lead_ms(uint32_t lead_ms);
+
+/**
+ * @brief Get the predictive switching lookahead (milliseconds)
+ * @return Current lookahead, 0 when disabled
+ */
+uint32_t ptx_oven_get_predict_lead_ms(void);
+
+/**
+ * @brief Enable or disable ignition pre-scheduling
+ * @param enabled 1: in hysteresis mode, start the ignition ignition_duration_ms
+ *        before the falling temperature is predicted to reach the ON threshold,
+ *        so the burner is lit when it gets there. 0: ignite at the threshold.
+ * @return true if published; false if out of range or a write is in progress
+ */
+bool ptx_oven_set_preignite_enabled(uint8_t enabled);
+
+/**
+ * @brief Get whether ignition pre-scheduling is enabled
+ * @return 1 if enabled, 0 otherwise
+ */
+uint8_t ptx_oven_get_preignite_enabled(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -9,81 +9,184 @@
  */
 #include "ptx_oven_control.h"
 #include "ptx_oven_config.h"
+#include "ptx_oven_profile.h"
+#include "ptx_oven_status_packed.h"
 #include "ptx_sensor_filter.h"
 #include "ptx_actuator.h"
+#include "ptx_trace.h"
+#include "ptx_pid.h"
+#include "ptx_autotune.h"
+#include "ptx_rate_estimator.h"
+#include "ptx_recipe.h"
 #include "api.h"
 #include "ptx_logging.h"
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__AVR__)
+#include <avr/pgmspace.h>
+#else
+#define PROGMEM
+#define memcpy_P memcpy
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#endif
+
+/* Build options:
+ * -DPTX_OVEN_PROFILE=<ptx_oven_profile_id_t> bakes a compile-time profile into the
+ * control tick (see ptx_oven_profile.h); otherwise the runtime config is used. */
 
 /* Feature flags */
 #ifndef PTX_FLAME_DETECT_ENABLED
 #define PTX_FLAME_DETECT_ENABLED 0  /* Disable flame detection by default (assume ignition success) */
 #endif
 
-/* Internal state */
-static ptx_oven_status_t pti_status;
-static uint32_t pti_ignition_start_ms = 0;
-static uint32_t pti_last_log_ms = 0;
+/* Pre-ignition guardrails: quiet time after a door opening, fault, out-of-range
+ * reading, inhibit or startup, and the samples the rate fit needs before its
+ * slope is trusted */
+#ifndef PTX_PREIGNITE_SETTLE_MS
+#define PTX_PREIGNITE_SETTLE_MS 10000U
+#endif
+#ifndef PTX_PREIGNITE_MIN_SAMPLES
+#define PTX_PREIGNITE_MIN_SAMPLES 8U
+#endif
 
-/* Timed sensor fault management */
-static uint32_t pti_out_of_range_since_ms = 0;   /* 0 means not currently out of range */
-static uint32_t pti_valid_since_ms = 0;          /* 0 means not in continuous valid window */
+/* Cycle-profiling hook: marks the end of each tick stage. The AVR harness in
+ * tools/avr defines it to read a hardware timer; empty in normal builds. */
+#ifndef PTX_PROFILE_MARK
+#define PTX_PROFILE_MARK(stage) ((void)0)
+#endif
 
-/* Ignition retry management */
-static uint8_t pti_ignition_attempt = 0;         /* Current attempt number (0 = not started) */
-static uint32_t pti_purge_start_ms = 0;          /* Start time of purge phase */
-static float pti_temp_at_ignition_start = 0.0f;  /* Temperature when ignition started (for flame detection) */
+/* Default instance behind the single-burner API */
+static ptx_oven_ctx_t pti_default_ctx;
+
+/* Config view over a pinned runtime slot or a ctx-private config; same accessors as ptx_oven_profile_view<> */
+struct pti_runtime_cfg_view {
+    const ptx_oven_config_t* cfg;
+    const ptx_oven_config_compiled_t* cc;
+
+    uint32_t ignition_duration_ms() const   { return cfg->ignition_duration_ms; }
+    uint32_t periodic_log_ms() const        { return cfg->periodic_log_ms; }
+    uint32_t sensor_fault_window_ms() const { return cfg->sensor_fault_window_ms; }
+    uint32_t auto_resume_delay_ms() const   { return cfg->auto_resume_delay_ms; }
+    uint8_t  max_ignition_attempts() const  { return cfg->max_ignition_attempts; }
+    uint32_t purge_time_ms() const          { return cfg->purge_time_ms; }
+    uint16_t vref_min_mv() const            { return cc->vref_min_mv; }
+    uint16_t vref_max_mv() const            { return cc->vref_max_mv; }
+    uint32_t signal_lo_q16() const          { return cc->signal_lo_q16; }
+    uint32_t signal_hi_q16() const          { return cc->signal_hi_q16; }
+    uint32_t temp_on_q16() const            { return cc->temp_on_q16; }
+    uint32_t temp_off_q16() const           { return cc->temp_off_q16; }
+    uint32_t flame_rise_q16() const         { return cc->flame_rise_q16; }
+    uint8_t  control_mode() const           { return cfg->control_mode; }
+    float    temp_target_c() const          { return cfg->temp_target_c; }
+    float    temp_delta_c() const           { return cfg->temp_delta_c; }
+    float    pid_kp() const                 { return cfg->pid_kp; }
+    float    pid_ki() const                 { return cfg->pid_ki; }
+    float    pid_kd() const                 { return cfg->pid_kd; }
+    uint32_t pid_window_ms() const          { return cfg->pid_window_ms; }
+    uint32_t predict_lead_ms() const        { return cfg->predict_lead_ms; }
+    uint8_t  preignite_enabled() const      { return cfg->preignite_enabled; }
+};
+
+/* A running recipe moves the setpoint: the ON/OFF thresholds keep the configured
+   half-band around it and PI/PID track it. Otherwise this is the config view. */
+template <typename View>
+struct pti_recipe_view : View {
+    const ptx_recipe_t* recipe;
+
+    pti_recipe_view(const View& base, const ptx_recipe_t* r) : View(base), recipe(r) {}
+
+    uint32_t half_band_q16() const { return (View::temp_off_q16() - View::temp_on_q16()) >> 1; }
+    uint32_t temp_on_q16() const {
+        if (!ptx_recipe_running(recipe)) return View::temp_on_q16();
+        uint32_t sp = ptx_recipe_setpoint_q16(recipe);
+        return (sp > half_band_q16()) ? sp - half_band_q16() : 0U;
+    }
+    uint32_t temp_off_q16() const {
+        return ptx_recipe_running(recipe) ? ptx_recipe_setpoint_q16(recipe) + half_band_q16() : View::temp_off_q16();
+    }
+    float temp_target_c() const {
+        return ptx_recipe_running(recipe) ? ptx_recipe_setpoint_c(recipe) : View::temp_target_c();
+    }
+};
 
-static bool ptx_read_door_open(void) {
-    return pti_status.door_open;
+static bool ptx_read_door_open(const ptx_oven_ctx_t* ctx) {
+    return ctx->status.door_open;
 }
 
-static void ptx_eval_sensor_faults_with_timing(uint32_t now_ms, float vref_mv, float signal_mv) {
-    const ptx_oven_config_t* cfg = ptx_oven_get_config();
-    
-    /* Update instantaneous readings */
-    pti_status.vref_volts   = vref_mv / 1000.0f;
-    pti_status.signal_volts = signal_mv / 1000.0f;
+static uint32_t ptx_signal_ratio_q16(uint16_t vref_mv, uint16_t signal_mv) {
+    if (vref_mv == 0) return 0;
+    return ((uint32_t)signal_mv << 16) / vref_mv;
+}
 
-    /* Instantaneous violations (not latched) */
-    bool vref_bad = (pti_status.vref_volts < cfg->vref_min_v) || (pti_status.vref_volts > cfg->vref_max_v);
+template <typename View>
+static void ptx_eval_sensor_faults_with_timing(ptx_oven_ctx_t* ctx, const View& v, uint32_t now_ms,
+                                               uint16_t vref_mv, uint16_t signal_mv) {
+    /* Update instantaneous readings (status only; decisions below are integer) */
+    ctx->status.vref_volts   = (float)vref_mv / 1000.0f;
+    ctx->status.signal_volts = (float)signal_mv / 1000.0f;
 
-    float lo = 0.10f * vref_mv;
-    float hi = 0.90f * vref_mv;
-    bool signal_bad = (signal_mv < lo) || (signal_mv > hi);
+    /* Instantaneous violations (not latched) */
+    bool vref_bad = (vref_mv < v.vref_min_mv()) || (vref_mv > v.vref_max_mv());
+    /* 10-90% of vref, inclusive: exact in integers, where the truncated Q16 ratio is not */
+    bool signal_bad = ((uint32_t)signal_mv * 10U < vref_mv) || ((uint32_t)signal_mv * 10U > (uint32_t)vref_mv * 9U);
 
-    pti_status.vref_fault = vref_bad;        /* expose instantaneous state */
-    pti_status.signal_fault = signal_bad;
+    ctx->status.vref_fault = vref_bad;        /* expose instantaneous state */
+    ctx->status.signal_fault = signal_bad;
 
     bool out_of_range = vref_bad || signal_bad;
 
     if (out_of_range) {
         /* Reset valid window and start/continue out-of-range window */
-        pti_valid_since_ms = 0;
-        if (pti_out_of_range_since_ms == 0) {
-            pti_out_of_range_since_ms = now_ms;
+        ctx->valid_since_ms = 0;
+        if (ctx->out_of_range_since_ms == 0) {
+            ctx->out_of_range_since_ms = now_ms;
         }
         /* Latch fault only if persists beyond window */
-        if (!pti_status.sensor_fault && (now_ms - pti_out_of_range_since_ms) > cfg->sensor_fault_window_ms) {
-            pti_status.sensor_fault = true;
+        if (!ctx->status.sensor_fault && (now_ms - ctx->out_of_range_since_ms) > v.sensor_fault_window_ms()) {
+            ctx->status.sensor_fault = true;
             PTX_LOGF("sensor fault latched");
         }
     } else {
         /* Readings are valid; clear out-of-range window */
-        pti_out_of_range_since_ms = 0;
+        ctx->out_of_range_since_ms = 0;
         
-        if (pti_status.sensor_fault) {
+        if (ctx->status.sensor_fault) {
             /* If fault was latched, require continuous validity before auto-resume */
-            if (pti_valid_since_ms == 0) {
-                pti_valid_since_ms = now_ms;
+            if (ctx->valid_since_ms == 0) {
+                ctx->valid_since_ms = now_ms;
             }
-            if ((now_ms - pti_valid_since_ms) >= cfg->auto_resume_delay_ms) {
-                pti_status.sensor_fault = false; /* clear latched fault */
-                pti_valid_since_ms = 0;
+            if ((now_ms - ctx->valid_since_ms) >= v.auto_resume_delay_ms()) {
+                ctx->status.sensor_fault = false; /* clear latched fault */
+                ctx->valid_since_ms = 0;
                 PTX_LOGF("sensor fault cleared");
             }
         } else {
             /* No latched fault; keep valid_since reset */
-            pti_valid_since_ms = 0;
+            ctx->valid_since_ms = 0;
+        }
+    }
+}
+
+/* Latch/clear the actuator fault from readback samples, like the sensor fault */
+template <typename View>
+static void ptx_eval_actuator_fault(ptx_oven_ctx_t* ctx, const View& v, uint32_t now_ms) {
+    if (ctx->readback_bad_samples >= PTX_ACTUATOR_VERIFY_LATCH) {
+        ctx->readback_ok_since_ms = 0;
+    ctx->resync_countdown = PTX_ACTUATOR_RESYNC_TICKS;
+        if (!ctx->status.actuator_fault) {
+            ctx->status.actuator_fault = true;
+            PTX_LOGF("actuator fault latched, mismatches=%u", (unsigned)ctx->status.actuator_mismatches);
+        }
+    } else if (ctx->status.actuator_fault && ctx->readback_bad_samples == 0) {
+        if (ctx->readback_ok_since_ms == 0) {
+            ctx->readback_ok_since_ms = now_ms;
+        }
+        if ((now_ms - ctx->readback_ok_since_ms) >= v.auto_resume_delay_ms()) {
+            ctx->status.actuator_fault = false;
+            ctx->readback_ok_since_ms = 0;
+    ctx->resync_countdown = PTX_ACTUATOR_RESYNC_TICKS;
+            PTX_LOGF("actuator fault cleared");
         }
     }
 }
@@ -108,239 +211,728 @@ static int ptx_temp_to_int(float temp_c) {
     }
 }
 
-static void ptx_apply_outputs(void) {
-    ptx_actuator_set_gas(pti_status.gas_on);
-    ptx_actuator_set_igniter(pti_status.igniter_on);
+/* Door, sensor/actuator faults and supervisor inhibit force a shutdown */
+static bool ptx_shutdown_requested(const ptx_oven_ctx_t* ctx) {
+    return ctx->status.door_open || ctx->status.sensor_fault || ctx->status.actuator_fault || ctx->inhibit;
+}
+
+/* Control law in effect: an autotune session cycles the relay (hysteresis) */
+template <typename View>
+static uint8_t ptx_control_mode(const ptx_oven_ctx_t* ctx, const View& v) {
+    return ptx_autotune_running(&ctx->autotune) ? (uint8_t)PTX_CONTROL_MODE_HYSTERESIS : v.control_mode();
+}
+
+/* Move to `next` and record it; a row that stays in its state is not a transition */
+static void ptx_heating_enter(ptx_oven_ctx_t* ctx, uint32_t now_ms, uint8_t next, uint8_t cause) {
+    uint8_t from = (uint8_t)ctx->status.state;
+    if (from == next) return;
+    ctx->status.state = (ptx_heating_state_t)next;
+    ptx_transition_ring_push(&ctx->transitions, now_ms, from, next, cause,
+                             (int16_t)ptx_temp_to_int(ctx->status.temperature_c * 10.0f));
+    if (next == PTX_HEATING_STATE_LOCKOUT) {
+        /* Post-mortem: the path into lockout, while it is still in the ring */
+        ptx_transition_ring_log(&ctx->transitions);
+    }
+}
+
+static void ptx_apply_outputs(const ptx_oven_ctx_t* ctx) {
+    ptx_actuator_set_gas(ctx->status.gas_on);
+    ptx_actuator_set_igniter(ctx->status.igniter_on);
 
     /* Optional LED debug (guard with your own defines to avoid build errors)
        Example:
-    // set_output(LED_STATUS, pti_status.sensor_fault ? 1 : 0);
+    // set_output(LED_STATUS, ctx->status.sensor_fault ? 1 : 0);
     */
 }
 
-static void ptx_update_heating(uint32_t now_ms) {
-    const ptx_oven_config_t* cfg = ptx_oven_get_config();
-    
-    /* Door and sensor faults override everything - force shutdown regardless of state */
-    if (pti_status.door_open || pti_status.sensor_fault) {
-        if (pti_status.gas_on || pti_status.igniter_on) {
-            PTX_LOGF("shutdown: door open or sensor fault");
+/* Heating state machine as a transition table.
+ *
+ * Each row is (from, guard, action, next): in state `from`, the first row whose
+ * guard holds runs its action and moves to `next`; no row firing means stay.
+ * Rows are grouped by state, and pti_heating_fsm<View>::first[] gives the first
+ * row of every state, so a tick indexes straight into its state's rows instead
+ * of walking a chain of compares. Shape checks run at compile time.
+ *
+ * Both tables live in flash (PROGMEM on AVR, where .rodata would be copied to
+ * SRAM); a tick copies one row at a time. Guards and actions are indirect calls
+ * and are not inlined into the tick. */
+
+template <typename View>
+struct pti_heating_row {
+    uint8_t from;                                                    /* ptx_heating_state_t */
+    bool (*guard)(const ptx_oven_ctx_t* ctx, const View& v, uint32_t now_ms);  /* NULL: always */
+    void (*action)(ptx_oven_ctx_t* ctx, const View& v, uint32_t now_ms);
+    uint8_t next;                                                    /* ptx_heating_state_t */
+    uint8_t cause;                                                   /* ptx_transition_cause_t */
+};
+
+/* Index of the first row of `state` (or of a later state); rows must be grouped by state */
+template <typename Row, size_t N>
+constexpr uint8_t ptx_fsm_first(const Row (&rows)[N], uint8_t state, size_t i = 0) {
+    return (i >= N || rows[i].from >= state) ? (uint8_t)i : ptx_fsm_first(rows, state, i + 1);
+}
+
+template <typename Row, size_t N>
+constexpr bool ptx_fsm_grouped(const Row (&rows)[N], size_t i = 1) {
+    return (i >= N) || (rows[i - 1].from <= rows[i].from && ptx_fsm_grouped(rows, i + 1));
+}
+
+template <typename Row, size_t N>
+constexpr bool ptx_fsm_in_range(const Row (&rows)[N], uint8_t count, size_t i = 0) {
+    return (i >= N) || (rows[i].from < count && rows[i].next < count && rows[i].action != NULL &&
+                        ptx_fsm_in_range(rows, count, i + 1));
+}
+
+/* States entered in one transition from any state in `mask` */
+template <typename Row, size_t N>
+constexpr uint8_t ptx_fsm_successors(const Row (&rows)[N], uint8_t mask, size_t i = 0) {
+    return (i >= N) ? 0U
+        : (uint8_t)((((mask >> rows[i].from) & 1U) ? (1U << rows[i].next) : 0U) |
+                    ptx_fsm_successors(rows, mask, i + 1));
+}
+
+template <typename Row, size_t N>
+constexpr uint8_t ptx_fsm_reachable(const Row (&rows)[N], uint8_t mask, uint8_t rounds) {
+    return (rounds == 0) ? mask
+        : ptx_fsm_reachable(rows, (uint8_t)(mask | ptx_fsm_successors(rows, mask)), (uint8_t)(rounds - 1));
+}
+
+/* Guards */
+
+/* Predictive switching: rising, the earlier of now and the prediction reaches
+   OFF; falling, the earlier one reaches ON. Equal to the ratio when disabled. */
+static uint32_t ptx_ratio_high(const ptx_oven_ctx_t* ctx) {
+    return (ctx->predicted_ratio_q16 > ctx->signal_ratio_q16) ? ctx->predicted_ratio_q16 : ctx->signal_ratio_q16;
+}
+
+static uint32_t ptx_ratio_low(const ptx_oven_ctx_t* ctx) {
+    return (ctx->predicted_ratio_q16 < ctx->signal_ratio_q16) ? ctx->predicted_ratio_q16 : ctx->signal_ratio_q16;
+}
+
+template <typename View>
+static bool ptx_heat_demand(const ptx_oven_ctx_t* ctx, const View& v, uint32_t now_ms) {
+    (void)now_ms;
+    if (ptx_control_mode(ctx, v) == PTX_CONTROL_MODE_HYSTERESIS) {
+        return ptx_ratio_low(ctx) <= v.temp_on_q16();
+    }
+    /* PI/PID: the burner window decides; never light above the OFF threshold */
+    return ctx->burner_demand && ptx_ratio_high(ctx) < v.temp_off_q16();
+}
+
+/* Pre-ignition (hysteresis mode): falling, start the ignition when the ON threshold
+   is predicted within ignition_duration_ms, so HEATING begins at the threshold.
+   Never on a retry, during autotune, while vref or signal is out of range (before
+   the fault latches), within PTX_PREIGNITE_SETTLE_MS of a shutdown or such a
+   reading, or on a fit with too few samples; the regular heat demand row always wins. */
+template <typename View>
+static bool ptx_preignite_due(const ptx_oven_ctx_t* ctx, const View& v, uint32_t now_ms) {
+    if (!v.preignite_enabled() || v.control_mode() != PTX_CONTROL_MODE_HYSTERESIS ||
+        ptx_autotune_running(&ctx->autotune) || ctx->ignition_attempt != 0 ||
+        ctx->status.vref_fault || ctx->status.signal_fault) {
+        return false;
+    }
+    if ((now_ms - ctx->shutdown_ms) < PTX_PREIGNITE_SETTLE_MS ||
+        ptx_rate_estimator_samples(&ctx->rate) < PTX_PREIGNITE_MIN_SAMPLES) {
+        return false;
+    }
+    float slope = ptx_rate_estimator_slope(&ctx->rate);
+    if (slope >= 0.0f) return false;
+    float at_lit = (float)ptx_ratio_low(ctx) + slope * (float)v.ignition_duration_ms() * 0.001f;
+    return at_lit <= (float)v.temp_on_q16();
+}
+
+template <typename View>
+static bool ptx_ignition_elapsed(const ptx_oven_ctx_t* ctx, const View& v, uint32_t now_ms) {
+    return (now_ms - ctx->ignition_start_ms) >= v.ignition_duration_ms();
+}
+
+template <typename View>
+static bool ptx_ignition_lit(const ptx_oven_ctx_t* ctx, const View& v, uint32_t now_ms) {
+#if (PTX_FLAME_DETECT_ENABLED)
+    return ptx_ignition_elapsed(ctx, v, now_ms) &&
+           ctx->signal_ratio_q16 > ctx->ratio_at_ignition_start_q16 + v.flame_rise_q16();
+#else
+    /* Flame detection disabled - assume success */
+    return ptx_ignition_elapsed(ctx, v, now_ms);
+#endif
+}
+
+template <typename View>
+static bool ptx_ignition_exhausted(const ptx_oven_ctx_t* ctx, const View& v, uint32_t now_ms) {
+    return ptx_ignition_elapsed(ctx, v, now_ms) && ctx->ignition_attempt >= v.max_ignition_attempts();
+}
+
+template <typename View>
+static bool ptx_at_temperature(const ptx_oven_ctx_t* ctx, const View& v, uint32_t now_ms) {
+    (void)now_ms;
+    /* The OFF threshold stays an over-temperature cut in PI/PID mode */
+    return ptx_ratio_high(ctx) >= v.temp_off_q16() ||
+           (ptx_control_mode(ctx, v) != PTX_CONTROL_MODE_HYSTERESIS && !ctx->burner_demand);
+}
+
+template <typename View>
+static bool ptx_purge_elapsed(const ptx_oven_ctx_t* ctx, const View& v, uint32_t now_ms) {
+    return (now_ms - ctx->purge_start_ms) >= v.purge_time_ms();
+}
+
+/* Actions (the engine stores the next state afterwards) */
+
+template <typename View>
+static void ptx_start_ignition(ptx_oven_ctx_t* ctx, const View& v, uint32_t now_ms) {
+    (void)v;
+    ctx->ignition_attempt++;
+    ctx->status.gas_on = true;
+    ctx->status.igniter_on = true;
+    ctx->ignition_start_ms = now_ms;
+    ctx->ratio_at_ignition_start_q16 = ctx->signal_ratio_q16;
+    PTX_LOGF("ignite start attempt=%d temp=%dC", ctx->ignition_attempt,
+             ptx_temp_to_int(ctx->status.temperature_c));
+}
+
+template <typename View>
+static void ptx_ignition_success(ptx_oven_ctx_t* ctx, const View& v, uint32_t now_ms) {
+    (void)v;
+    (void)now_ms;
+    ctx->status.igniter_on = false;
+    ctx->ignition_attempt = 0;
+#if (PTX_FLAME_DETECT_ENABLED)
+    PTX_LOGF("ignition success, temp=%dC", ptx_temp_to_int(ctx->status.temperature_c));
+#else
+    PTX_LOGF("ignition assumed success (flame detect disabled)");
+#endif
+}
+
+template <typename View>
+static void ptx_ignition_lockout(ptx_oven_ctx_t* ctx, const View& v, uint32_t now_ms) {
+    (void)v;
+    (void)now_ms;
+    ctx->status.gas_on = false;
+    ctx->status.igniter_on = false;
+    ctx->status.ignition_lockout = true;
+    PTX_LOGF("ignition lockout after %d attempts", ctx->ignition_attempt);
+}
+
+template <typename View>
+static void ptx_ignition_failed(ptx_oven_ctx_t* ctx, const View& v, uint32_t now_ms) {
+    (void)v;
+    /* No flame detected: purge before retry */
+    ctx->status.gas_on = false;
+    ctx->status.igniter_on = false;
+    ctx->purge_start_ms = now_ms;
+    PTX_LOGF("ignition failed attempt=%d, purging", ctx->ignition_attempt);
+}
+
+template <typename View>
+static void ptx_heat_off(ptx_oven_ctx_t* ctx, const View& v, uint32_t now_ms) {
+    (void)v;
+    (void)now_ms;
+    ctx->status.gas_on = false;
+    ctx->status.igniter_on = false;
+    ctx->ignition_attempt = 0; /* Successful heating cycle */
+    PTX_LOGF("heat off temp=%dC", ptx_temp_to_int(ctx->status.temperature_c));
+}
+
+template <typename View>
+static void ptx_purge_done(ptx_oven_ctx_t* ctx, const View& v, uint32_t now_ms) {
+    (void)v;
+    (void)now_ms;
+    PTX_LOGF("purge complete, attempt=%d", ctx->ignition_attempt);
+}
+
+template <typename View>
+static void ptx_hold_lockout(ptx_oven_ctx_t* ctx, const View& v, uint32_t now_ms) {
+    (void)v;
+    (void)now_ms;
+    /* Require manual reset - no automatic recovery (ptx_oven_reset_ignition_lockout()) */
+    ctx->status.gas_on = false;
+    ctx->status.igniter_on = false;
+    ctx->status.ignition_lockout = true;
+}
+
+template <typename View>
+struct pti_heating_fsm {
+    typedef pti_heating_row<View> row_t;
+
+    static constexpr row_t rows[] PROGMEM = {
+        { PTX_HEATING_STATE_IDLE,     &ptx_heat_demand<View>,        &ptx_start_ignition<View>,   PTX_HEATING_STATE_IGNITING,
+          PTX_TRANSITION_CAUSE_HEAT_DEMAND },
+        { PTX_HEATING_STATE_IDLE,     &ptx_preignite_due<View>,      &ptx_start_ignition<View>,   PTX_HEATING_STATE_IGNITING,
+          PTX_TRANSITION_CAUSE_PREIGNITE },
+        { PTX_HEATING_STATE_IGNITING, &ptx_ignition_lit<View>,       &ptx_ignition_success<View>, PTX_HEATING_STATE_HEATING,
+          PTX_TRANSITION_CAUSE_IGNITION_LIT },
+        { PTX_HEATING_STATE_IGNITING, &ptx_ignition_exhausted<View>, &ptx_ignition_lockout<View>, PTX_HEATING_STATE_LOCKOUT,
+          PTX_TRANSITION_CAUSE_IGNITION_EXHAUSTED },
+        { PTX_HEATING_STATE_IGNITING, &ptx_ignition_elapsed<View>,   &ptx_ignition_failed<View>,  PTX_HEATING_STATE_PURGING,
+          PTX_TRANSITION_CAUSE_IGNITION_FAILED },
+        { PTX_HEATING_STATE_HEATING,  &ptx_at_temperature<View>,     &ptx_heat_off<View>,         PTX_HEATING_STATE_IDLE,
+          PTX_TRANSITION_CAUSE_AT_TEMPERATURE },
+        { PTX_HEATING_STATE_PURGING,  &ptx_purge_elapsed<View>,      &ptx_purge_done<View>,       PTX_HEATING_STATE_IDLE,
+          PTX_TRANSITION_CAUSE_PURGE_DONE },
+        { PTX_HEATING_STATE_LOCKOUT,  NULL,                          &ptx_hold_lockout<View>,     PTX_HEATING_STATE_LOCKOUT,
+          0 },
+    };
+
+    static constexpr uint8_t first[PTX_HEATING_STATE_COUNT + 1] PROGMEM = {
+        ptx_fsm_first(rows, PTX_HEATING_STATE_IDLE),
+        ptx_fsm_first(rows, PTX_HEATING_STATE_IGNITING),
+        ptx_fsm_first(rows, PTX_HEATING_STATE_HEATING),
+        ptx_fsm_first(rows, PTX_HEATING_STATE_PURGING),
+        ptx_fsm_first(rows, PTX_HEATING_STATE_LOCKOUT),
+        ptx_fsm_first(rows, PTX_HEATING_STATE_COUNT),
+    };
+};
+
+template <typename View>
+constexpr pti_heating_row<View> pti_heating_fsm<View>::rows[];
+template <typename View>
+constexpr uint8_t pti_heating_fsm<View>::first[];
+
+/* Run the transition table for the current state; returns true if a row fired */
+template <typename View>
+static bool ptx_heating_step(ptx_oven_ctx_t* ctx, const View& v, uint32_t now_ms) {
+    typedef pti_heating_fsm<View> fsm;
+    static_assert(PTX_HEATING_STATE_COUNT == 5 && sizeof(fsm::first) == PTX_HEATING_STATE_COUNT + 1,
+                  "first[] must list every heating state");
+    static_assert(PTX_HEATING_STATE_COUNT <= 16, "states are recorded as nibbles in the transition ring");
+    static_assert(ptx_fsm_grouped(fsm::rows), "transition rows must be grouped by state");
+    static_assert(ptx_fsm_in_range(fsm::rows, PTX_HEATING_STATE_COUNT), "row state out of range or no action");
+    static_assert(fsm::first[PTX_HEATING_STATE_COUNT] == sizeof(fsm::rows) / sizeof(fsm::rows[0]),
+                  "row for an unknown state");
+    static_assert(ptx_fsm_reachable(fsm::rows, 1U << PTX_HEATING_STATE_IDLE, PTX_HEATING_STATE_COUNT) ==
+                  (1U << PTX_HEATING_STATE_COUNT) - 1U, "heating state unreachable from IDLE");
+
+    uint8_t state = (uint8_t)ctx->status.state;
+    uint8_t end = pgm_read_byte(&fsm::first[state + 1]);
+    for (uint8_t i = pgm_read_byte(&fsm::first[state]); i < end; i++) {
+        pti_heating_row<View> row;
+        memcpy_P(&row, &fsm::rows[i], sizeof(row));
+        if (row.guard == NULL || row.guard(ctx, v, now_ms)) {
+            row.action(ctx, v, now_ms);
+            ptx_heating_enter(ctx, now_ms, row.next, row.cause);
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename View>
+static void ptx_update_heating(ptx_oven_ctx_t* ctx, const View& v, uint32_t now_ms) {
+    /* Door, sensor/actuator faults and supervisor inhibit override everything - force shutdown regardless of state */
+    if (ptx_shutdown_requested(ctx)) {
+        if (ctx->status.gas_on || ctx->status.igniter_on) {
+            PTX_LOGF("shutdown: door open, sensor/actuator fault or inhibit");
+        }
+        ctx->status.gas_on = false;
+        ctx->status.igniter_on = false;
+        ctx->shutdown_ms = now_ms;
+        /* Lockout requires a manual reset; a shutdown must not clear it */
+        if (ctx->status.state != PTX_HEATING_STATE_LOCKOUT) {
+            uint8_t cause = ctx->status.door_open      ? PTX_TRANSITION_CAUSE_DOOR_OPEN
+                          : ctx->status.sensor_fault   ? PTX_TRANSITION_CAUSE_SENSOR_FAULT
+                          : ctx->status.actuator_fault ? PTX_TRANSITION_CAUSE_ACTUATOR_FAULT
+                          : PTX_TRANSITION_CAUSE_INHIBIT;
+            ptx_heating_enter(ctx, now_ms, PTX_HEATING_STATE_IDLE, cause);
+            ctx->ignition_attempt = 0; /* Reset attempt counter on fault */
         }
-        pti_status.gas_on = false;
-        pti_status.igniter_on = false;
-        pti_status.state = PTX_HEATING_STATE_IDLE;
-        pti_ignition_attempt = 0; /* Reset attempt counter on fault */
         return;
     }
 
     /* Do not allow ignition until system has been running for at least 2 seconds (sensor stabilization) */
     if (now_ms < 2000) {
-        pti_status.gas_on = false;
-        pti_status.igniter_on = false;
-        pti_status.state = PTX_HEATING_STATE_IDLE;
+        ctx->status.gas_on = false;
+        ctx->status.igniter_on = false;
+        ctx->shutdown_ms = now_ms;
+        ptx_heating_enter(ctx, now_ms, PTX_HEATING_STATE_IDLE, PTX_TRANSITION_CAUSE_STARTUP);
         return;
     }
 
-    /* Hysteresis thresholds */
-    float temp_on = cfg->temp_target_c - cfg->temp_delta_c;
-    float temp_off = cfg->temp_target_c + cfg->temp_delta_c;
-    
-    /* State machine logic */
-    switch (pti_status.state) {
-        case PTX_HEATING_STATE_IDLE:
-            /* Check if heating is needed */
-            if (pti_status.temperature_c <= temp_on) {
-                /* Start ignition sequence */
-                pti_ignition_attempt++;
-                pti_status.gas_on = true;
-                pti_status.igniter_on = true;
-                pti_status.state = PTX_HEATING_STATE_IGNITING;
-                pti_ignition_start_ms = now_ms;
-                pti_temp_at_ignition_start = pti_status.temperature_c;
-                PTX_LOGF("ignite start attempt=%d temp=%dC", pti_ignition_attempt, 
-                         ptx_temp_to_int(pti_status.temperature_c));
-            }
-            break;
+    if ((unsigned)ctx->status.state >= PTX_HEATING_STATE_COUNT) {
+        /* Invalid state - reset to IDLE */
+        PTX_LOGF("invalid state %d, reset to IDLE", (int)ctx->status.state);
+        ptx_heating_enter(ctx, now_ms, PTX_HEATING_STATE_IDLE, PTX_TRANSITION_CAUSE_INVALID_STATE);
+        ctx->status.gas_on = false;
+        ctx->status.igniter_on = false;
+        return;
+    }
 
-        case PTX_HEATING_STATE_IGNITING:
-            /* Wait for ignition period to complete */
-            if ((now_ms - pti_ignition_start_ms) >= cfg->ignition_duration_ms) {
-                /* Ignition period ended, check for flame */
-                float temp_rise = pti_status.temperature_c - pti_temp_at_ignition_start;
+    /* Out-of-range readings skew the rate fit before a fault latches: restart the
+       pre-ignition settle window as a shutdown would */
+    if (ctx->status.vref_fault || ctx->status.signal_fault) {
+        ctx->shutdown_ms = now_ms;
+    }
 
-#if (PTX_FLAME_DETECT_ENABLED)
-                if (temp_rise > cfg->flame_detect_temp_rise_c) {
-                    /* Flame detected - successful ignition */
-                    pti_status.igniter_on = false;
-                    pti_status.state = PTX_HEATING_STATE_HEATING;
-                    pti_ignition_attempt = 0;
-                    PTX_LOGF("ignition success, temp_rise=%dC", ptx_temp_to_int(temp_rise));
-                } else {
-                    /* No flame detected - failed ignition */
-                    pti_status.gas_on = false;
-                    pti_status.igniter_on = false;
-                    
-                    if (pti_ignition_attempt >= cfg->max_ignition_attempts) {
-                        /* Max attempts reached - enter lockout */
-                        pti_status.state = PTX_HEATING_STATE_LOCKOUT;
-                        pti_status.ignition_lockout = true;
-                        PTX_LOGF("ignition lockout after %d attempts", pti_ignition_attempt);
-                    } else {
-                        /* Start purge before retry */
-                        pti_status.state = PTX_HEATING_STATE_PURGING;
-                        pti_purge_start_ms = now_ms;
-                        PTX_LOGF("ignition failed attempt=%d, purging", pti_ignition_attempt);
-                    }
-                }
-#else
-                /* Flame detection disabled - assume success */
-                pti_status.igniter_on = false;
-                pti_status.state = PTX_HEATING_STATE_HEATING;
-                pti_ignition_attempt = 0;
-                PTX_LOGF("ignition assumed success (flame detect disabled)");
-#endif
-            }
-            /* Else keep igniter on and wait */
-            break;
-
-        case PTX_HEATING_STATE_HEATING:
-            /* Check if reached upper temperature threshold */
-            if (pti_status.temperature_c >= temp_off) {
-                pti_status.gas_on = false;
-                pti_status.igniter_on = false;
-                pti_status.state = PTX_HEATING_STATE_IDLE;
-                pti_ignition_attempt = 0; /* Successful heating cycle */
-                PTX_LOGF("heat off temp=%dC", ptx_temp_to_int(pti_status.temperature_c));
-            }
-            /* Else keep heating */
-            break;
-
-        case PTX_HEATING_STATE_PURGING:
-            /* Wait for purge time to complete */
-            if ((now_ms - pti_purge_start_ms) >= cfg->purge_time_ms) {
-                pti_status.state = PTX_HEATING_STATE_IDLE;
-                PTX_LOGF("purge complete, attempt=%d", pti_ignition_attempt);
-            }
-            /* Else keep purging (gas and igniter already off) */
-            break;
-
-        case PTX_HEATING_STATE_LOCKOUT:
-            /* Require manual reset - no automatic recovery */
-            pti_status.gas_on = false;
-            pti_status.igniter_on = false;
-            pti_status.ignition_lockout = true;
-            /* Stay in lockout until ptx_oven_reset_ignition_lockout() called */
-            break;
-
-        default:
-            /* Invalid state - reset to IDLE */
-            PTX_LOGF("invalid state %d, reset to IDLE", (int)pti_status.state);
-            pti_status.state = PTX_HEATING_STATE_IDLE;
-            pti_status.gas_on = false;
-            pti_status.igniter_on = false;
-            break;
+    if (ptx_control_mode(ctx, v) != PTX_CONTROL_MODE_HYSTERESIS) {
+        /* Duty from the PI/PID law, executed as burner time in fixed windows */
+        float duty = ptx_pid_update(&ctx->pid, now_ms, v.temp_target_c(), ctx->status.temperature_c,
+                                    v.pid_kp(), v.pid_ki(),
+                                    (v.control_mode() == PTX_CONTROL_MODE_PID) ? v.pid_kd() : 0.0f);
+        ctx->burner_demand = ptx_pid_burner_demand(&ctx->pid, now_ms, v.pid_window_ms(),
+                                                   v.ignition_duration_ms(), v.purge_time_ms());
+        ctx->status.heat_duty_pct = (uint8_t)(duty * 100.0f + 0.5f);
+    } else {
+        ctx->status.heat_duty_pct = 0;  /* hysteresis or autotune relay: no duty */
     }
+
+    /* Hysteresis thresholds are precompiled as signal ratios (temp_on/temp_off) */
+    ptx_heating_step(ctx, v, now_ms);
 }
 
-static void ptx_oven_run_log(uint32_t now_ms) {
-    const ptx_oven_config_t* cfg = ptx_oven_get_config();
-    
-    if ((now_ms - pti_last_log_ms) < cfg->periodic_log_ms) return;
-    pti_last_log_ms = now_ms;
+template <typename View>
+static void ptx_oven_run_log(ptx_oven_ctx_t* ctx, const View& v, uint32_t now_ms) {
+    if ((now_ms - ctx->last_log_ms) < v.periodic_log_ms()) return;
+    ctx->last_log_ms = now_ms;
 
-    int vref_mV = (int)(pti_status.vref_volts * 1000.0f + 0.5f);
-    int signal_mV = (int)(pti_status.signal_volts * 1000.0f + 0.5f);
+    /* Telemetry is emitted from the packed snapshot (integer fields only) */
+    ptx_oven_status_packed_t snap;
+    ptx_oven_status_pack(&ctx->status, &snap);
     
-    /* Main status log */
+    /* Main status log; the temperature is rounded once from the float, not from 0.1 °C */
     PTX_LOGF("temp=%dC door=%s state=%d gas=%d ign=%d attempt=%d lockout=%d",
-             ptx_temp_to_int(pti_status.temperature_c),
-             pti_status.door_open ? "OPEN" : "CLOSED",
-             (int)pti_status.state,
-             pti_status.gas_on ? 1 : 0,
-             pti_status.igniter_on ? 1 : 0,
-             pti_status.ignition_attempt,
-             pti_status.ignition_lockout ? 1 : 0);
+             ptx_temp_to_int(ctx->status.temperature_c),
+             (snap.flags & PTX_STATUS_FLAG_DOOR_OPEN) ? "OPEN" : "CLOSED",
+             (int)ptx_oven_status_packed_state(&snap),
+             (snap.flags & PTX_STATUS_FLAG_GAS_ON) ? 1 : 0,
+             (snap.flags & PTX_STATUS_FLAG_IGNITER_ON) ? 1 : 0,
+             ptx_oven_status_packed_attempt(&snap),
+             (snap.flags & PTX_STATUS_FLAG_IGNITION_LOCKOUT) ? 1 : 0);
     
     /* Sensor and fault log */
     PTX_LOGF("vref=%dmV signal=%dmV vref_fault=%d signal_fault=%d sensor_fault=%d",
-             vref_mV,
-             signal_mV,
-             pti_status.vref_fault ? 1 : 0,
-             pti_status.signal_fault ? 1 : 0,
-             pti_status.sensor_fault ? 1 : 0);
+             (int)snap.vref_mv,
+             (int)snap.signal_mv,
+             (snap.flags & PTX_STATUS_FLAG_VREF_FAULT) ? 1 : 0,
+             (snap.flags & PTX_STATUS_FLAG_SIGNAL_FAULT) ? 1 : 0,
+             (snap.flags & PTX_STATUS_FLAG_SENSOR_FAULT) ? 1 : 0);
+}
+
+/* One control tick against a config view (runtime slot, ctx config or compile-time profile) */
+template <typename View>
+static void ptx_oven_tick(ptx_oven_ctx_t* ctx, const View& base, uint32_t now,
+                          uint16_t raw_vref_mv, uint16_t raw_signal_mv) {
+    const pti_recipe_view<View> v(base, &ctx->recipe);
+
+    /* Filter sensor data */
+    ptx_sensor_reading_t filtered = ptx_sensor_filter_ctx_update(&ctx->filter, raw_vref_mv, raw_signal_mv);
+    uint32_t ratio_q16 = ptx_signal_ratio_q16(filtered.vref_mv, filtered.signal_mv);
+    PTX_PROFILE_MARK(filter);
+
+    /* Evaluate faults with timing first. */
+    ptx_eval_sensor_faults_with_timing(ctx, v, now, filtered.vref_mv, filtered.signal_mv);
+    ptx_eval_actuator_fault(ctx, v, now);
+    ctx->status.door_open = ptx_read_door_open(ctx);
+
+    /* Clamp to the sensor range, as the temperature map does, for control decisions */
+    if (ratio_q16 < v.signal_lo_q16()) ratio_q16 = v.signal_lo_q16();
+    if (ratio_q16 > v.signal_hi_q16()) ratio_q16 = v.signal_hi_q16();
+    ctx->signal_ratio_q16 = ratio_q16;
+
+    /* Recipe setpoint: the thresholds follow it from this tick on */
+    if (ptx_recipe_running(&ctx->recipe)) {
+        uint8_t segment = ctx->recipe.segment;
+        ptx_recipe_update(&ctx->recipe, now, ratio_q16, v.half_band_q16());
+        if (ctx->recipe.state == PTX_RECIPE_DONE) {
+            PTX_LOGF("recipe %u done", (unsigned)ctx->recipe.recipe_id);
+        } else if (ctx->recipe.segment != segment) {
+            PTX_LOGF("recipe %u segment %u/%u", (unsigned)ctx->recipe.recipe_id,
+                     (unsigned)ctx->recipe.segment + 1U, (unsigned)ctx->recipe.segments);
+        }
+    }
+
+    /* Rate of rise, fitted relative to the configured OFF threshold to keep the sums small */
+    ctx->predicted_ratio_q16 = ratio_q16;
+    if (v.predict_lead_ms() > 0 || v.preignite_enabled()) {
+        float slope = ptx_rate_estimator_update(&ctx->rate, now,
+                                                (float)((int32_t)ratio_q16 - (int32_t)base.temp_off_q16()));
+        int32_t predicted = (int32_t)ratio_q16 + (int32_t)(slope * (float)v.predict_lead_ms() * 0.001f);
+        ctx->predicted_ratio_q16 = (predicted > 0) ? (uint32_t)predicted : 0U;
+    }
+    PTX_PROFILE_MARK(faults);
+
+    /* Compute temperature (for display/log); control will still be overridden on faults. */
+    ctx->status.temperature_c = ptx_compute_temperature((float)filtered.vref_mv, (float)filtered.signal_mv);
+    PTX_PROFILE_MARK(temperature);
+
+    /* Control decision. */
+    ptx_update_heating(ctx, v, now);
+    if (ptx_autotune_running(&ctx->autotune)) {
+        /* A forced shutdown or lockout breaks the limit cycle */
+        if (ptx_shutdown_requested(ctx) || ctx->status.state == PTX_HEATING_STATE_LOCKOUT) {
+            ptx_autotune_abort(&ctx->autotune);
+            PTX_LOGF("autotune aborted");
+        } else {
+            ptx_autotune_sample(&ctx->autotune, now, ctx->status.temperature_c,
+                                v.temp_target_c() + v.temp_delta_c(), ctx->status.gas_on);
+        }
+    }
+    if (ptx_recipe_running(&ctx->recipe) && ctx->status.state == PTX_HEATING_STATE_LOCKOUT) {
+        ptx_recipe_abort(&ctx->recipe);
+        PTX_LOGF("recipe aborted: ignition lockout");
+    }
+    PTX_PROFILE_MARK(heating);
+
+    /* Log. */
+    ptx_oven_run_log(ctx, v, now);
+    PTX_PROFILE_MARK(log);
+    
+    /* Update public status */
+    ctx->status.ignition_attempt = ctx->ignition_attempt;
 }
 
 /* Public API */
-const ptx_oven_status_t* ptx_oven_get_status(void) {
-    return &pti_status;
+void ptx_oven_ctx_init(ptx_oven_ctx_t* ctx) {
+    ctx->status.vref_volts = 0.0f;
+    ctx->status.signal_volts = 0.0f;
+    ctx->status.temperature_c = -10.0f;
+    ctx->status.door_open = false;
+    ctx->status.gas_on = false;
+    ctx->status.igniter_on = false;
+    ctx->status.state = PTX_HEATING_STATE_IDLE;
+    ctx->status.vref_fault = false;
+    ctx->status.signal_fault = false;
+    ctx->status.sensor_fault = false;
+    ctx->status.ignition_attempt = 0;
+    ctx->status.ignition_lockout = false;
+    ctx->status.actuator_fault = false;
+    ctx->status.actuator_mismatches = 0;
+    ctx->status.heat_duty_pct = 0;
+
+    ctx->ignition_start_ms = 0;
+    ctx->last_log_ms = 0;
+    ctx->ignition_attempt = 0;
+    ctx->purge_start_ms = 0;
+    ctx->ratio_at_ignition_start_q16 = 0;
+    ctx->signal_ratio_q16 = 0;
+    ctx->out_of_range_since_ms = 0;
+    ctx->valid_since_ms = 0;
+    ctx->inhibit = false;
+    ctx->config = NULL;
+    ctx->verify_countdown = PTX_ACTUATOR_VERIFY_TICKS;
+    ctx->readback_bad_samples = 0;
+    ctx->readback_ok_since_ms = 0;
+    ctx->resync_countdown = PTX_ACTUATOR_RESYNC_TICKS;
+
+    ptx_sensor_filter_ctx_init(&ctx->filter, 5);
+    ptx_transition_ring_init(&ctx->transitions);
+    ptx_pid_init(&ctx->pid);
+    ctx->burner_demand = false;
+    ptx_autotune_init(&ctx->autotune);
+    ptx_recipe_init(&ctx->recipe);
+    ptx_rate_estimator_init(&ctx->rate);
+    ctx->predicted_ratio_q16 = 0;
+    ctx->shutdown_ms = 0;
 }
 
-void ptx_oven_control_init(void) {
-    pti_status.vref_volts = 0.0f;
-    pti_status.signal_volts = 0.0f;
-    pti_status.temperature_c = -10.0f;
-    pti_status.door_open = false;
-    pti_status.gas_on = false;
-    pti_status.igniter_on = false;
-    pti_status.state = PTX_HEATING_STATE_IDLE;
-    pti_status.vref_fault = false;
-    pti_status.signal_fault = false;
-    pti_status.sensor_fault = false;
-    pti_status.ignition_attempt = 0;
-    pti_status.ignition_lockout = false;
-
-    pti_ignition_start_ms = 0;
-    pti_last_log_ms = 0;
-    pti_ignition_attempt = 0;
-    pti_purge_start_ms = 0;
-    pti_temp_at_ignition_start = 0.0f;
-    pti_out_of_range_since_ms = 0;
-    pti_valid_since_ms = 0;
-    
-    /* Initialize actuators and sensor filter */
-    ptx_actuator_init();
-    ptx_sensor_filter_init(5);
+bool ptx_oven_ctx_set_config(ptx_oven_ctx_t* ctx, const ptx_oven_config_t* config) {
+#if defined(PTX_OVEN_PROFILE)
+    (void)ctx;
+    (void)config;
+    return false;  /* the tick runs on the baked-in profile */
+#else
+    if (config != NULL) {
+        if (!ptx_oven_config_validate(config)) return false;
+        ptx_oven_config_compile(config, &ctx->compiled);
+    }
+    ctx->config = config;
+    return true;
+#endif
+}
 
-    PTX_LOGF("oven control init");
+/* Write a finished autotune result into the shared configuration, outside the tick;
+   a private configuration belongs to the caller, who applies the result itself */
+static void ptx_oven_apply_autotune(ptx_oven_ctx_t* ctx) {
+    ptx_autotune_t* at = &ctx->autotune;
+    if (at->state != PTX_AUTOTUNE_DONE || at->applied) return;
+    at->applied = true;
+    PTX_LOGF("autotune: Ku=%d/1000 Tu=%ds L=%ds", ptx_temp_to_int(at->ku * 1000.0f),
+             ptx_temp_to_int(at->tu_s), ptx_temp_to_int(at->dead_time_s));
+#if !defined(PTX_OVEN_PROFILE)
+    if (ctx->config != NULL) return;
+    ptx_oven_config_t cfg = *ptx_oven_get_config();
+    (void)ptx_autotune_apply(at, &cfg);
+    if (!ptx_oven_set_config(&cfg)) PTX_LOGF("autotune: gains rejected by config");
+#endif
 }
 
-void ptx_oven_control_update(void) {
+void ptx_oven_ctx_step(ptx_oven_ctx_t* ctx, uint32_t now_ms, uint16_t raw_vref_mv, uint16_t raw_signal_mv) {
+#if defined(PTX_OVEN_PROFILE)
+    /* Thresholds and timings are constant expressions; runtime config is not consulted */
+    ptx_oven_tick(ctx, ptx_oven_profile_view<PTX_OVEN_PROFILE>(), now_ms, raw_vref_mv, raw_signal_mv);
+#else
+    if (ctx->config != NULL) {
+        pti_runtime_cfg_view view = { ctx->config, &ctx->compiled };
+        ptx_oven_tick(ctx, view, now_ms, raw_vref_mv, raw_signal_mv);
+    } else {
+        /* Pin one config slot for the whole tick; concurrent writers publish into the other slot */
+        pti_runtime_cfg_view view = { ptx_oven_config_pin(), ptx_oven_config_pinned_compiled() };
+        ptx_oven_tick(ctx, view, now_ms, raw_vref_mv, raw_signal_mv);
+        ptx_oven_config_unpin();
+    }
+#endif
+    ptx_oven_apply_autotune(ctx);
+}
+
+void ptx_oven_ctx_update(ptx_oven_ctx_t* ctx) {
+    PTX_PROFILE_MARK(start);
     uint32_t now = millis();
+    uint16_t raw_vref_mv   = read_voltage(TEMPERATURE_SENSOR_REFERENCE);
+    uint16_t raw_signal_mv = read_voltage(TEMPERATURE_SENSOR);
 
-    /* Read and filter sensor data */
-    ptx_sensor_reading_t filtered = ptx_sensor_filter_read_and_update();
-    
-    float vref_mv   = (float)filtered.vref_mv;
-    float signal_mv = (float)filtered.signal_mv;
+    if (ctx == &pti_default_ctx) {
+        ptx_trace_record_tick(now, raw_vref_mv, raw_signal_mv);
+    }
+    PTX_PROFILE_MARK(inputs);
+    bool fault_latched = ctx->status.actuator_fault;
+    ptx_oven_ctx_step(ctx, now, raw_vref_mv, raw_signal_mv);
+    ptx_apply_outputs(ctx);
+    if (ctx->status.actuator_fault && !fault_latched) {
+        /* The shutdown may not change the shadow (a pin stuck on while commanded off) */
+        ptx_actuator_resync();
+    }
+#if (PTX_ACTUATOR_VERIFY_TICKS > 0)
+    /* Decimated readback: a decrement and compare on most ticks */
+    if (--ctx->verify_countdown == 0) {
+        ctx->verify_countdown = PTX_ACTUATOR_VERIFY_TICKS;
+        uint8_t mismatch = ptx_actuator_readback_mismatch();
+        bool match = (mismatch & (PTX_ACTUATOR_CHANNEL_BIT(GAS_VALVE) |
+                                  PTX_ACTUATOR_CHANNEL_BIT(IGNITER))) == 0;
+        ptx_oven_ctx_note_readback(ctx, match);
+        /* Drive a disagreeing pin back now instead of waiting for the periodic resync */
+        if (!match) ptx_actuator_resync();
+    }
+#endif
+#if (PTX_ACTUATOR_RESYNC_TICKS > 0)
+    /* Outputs are written on change only; rewrite them now and then so a drifted pin recovers */
+    if (--ctx->resync_countdown == 0) {
+        ctx->resync_countdown = PTX_ACTUATOR_RESYNC_TICKS;
+        ptx_actuator_resync();
+    }
+#endif
+    PTX_PROFILE_MARK(outputs);
+}
 
-    /* Evaluate faults with timing first. */
-    ptx_eval_sensor_faults_with_timing(now, vref_mv, signal_mv);
-    pti_status.door_open = ptx_read_door_open();
+void ptx_oven_ctx_note_readback(ptx_oven_ctx_t* ctx, bool match) {
+    if (match) {
+        ctx->readback_bad_samples = 0;
+        return;
+    }
+    if (ctx->readback_bad_samples < 0xFFU) ctx->readback_bad_samples++;
+    if (ctx->status.actuator_mismatches < 0xFFFFU) ctx->status.actuator_mismatches++;
+}
 
-    /* Compute temperature (for display/log); control will still be overridden on faults. */
-    pti_status.temperature_c = ptx_compute_temperature(vref_mv, signal_mv);
+const ptx_oven_status_t* ptx_oven_ctx_get_status(const ptx_oven_ctx_t* ctx) {
+    return &ctx->status;
+}
 
-    /* Control decision. */
-    ptx_update_heating(now);
+const ptx_transition_ring_t* ptx_oven_ctx_get_transitions(const ptx_oven_ctx_t* ctx) {
+    return &ctx->transitions;
+}
 
-    /* Apply outputs and log. */
-    ptx_apply_outputs();
-    ptx_oven_run_log(now);
-    
-    /* Update public status */
-    pti_status.ignition_attempt = pti_ignition_attempt;
+bool ptx_oven_ctx_start_autotune(ptx_oven_ctx_t* ctx, uint8_t target_mode, uint8_t cycles) {
+    /* Relay cycles around a moving setpoint would not measure the plant */
+    if (ptx_recipe_running(&ctx->recipe)) return false;
+#if defined(PTX_OVEN_PROFILE)
+    /* Tuned gains could never reach the baked-in profile */
+    (void)target_mode;
+    (void)cycles;
+    return false;
+#endif
+    if (!ptx_autotune_start(&ctx->autotune, target_mode, cycles)) return false;
+    PTX_LOGF("autotune started: %u cycles", (unsigned)cycles);
+    return true;
 }
 
-void ptx_oven_set_door_state(bool open) {
-    pti_status.door_open = open;
+const ptx_autotune_t* ptx_oven_ctx_get_autotune(const ptx_oven_ctx_t* ctx) {
+    return &ctx->autotune;
 }
 
-void ptx_oven_reset_ignition_lockout(void) {
-    if (pti_status.state == PTX_HEATING_STATE_LOCKOUT) {
-        pti_status.state = PTX_HEATING_STATE_IDLE;
-        pti_status.ignition_lockout = false;
-        pti_ignition_attempt = 0;
-        pti_status.ignition_attempt = 0;
+bool ptx_oven_ctx_start_recipe(ptx_oven_ctx_t* ctx, uint8_t recipe_id) {
+    if (ptx_autotune_running(&ctx->autotune)) return false;
+    if (!ptx_recipe_start(&ctx->recipe, recipe_id)) return false;
+    PTX_LOGF("recipe %u started: %u segments", (unsigned)recipe_id, (unsigned)ctx->recipe.segments);
+    return true;
+}
+
+void ptx_oven_ctx_stop_recipe(ptx_oven_ctx_t* ctx) {
+    if (!ptx_recipe_running(&ctx->recipe)) return;
+    ptx_recipe_abort(&ctx->recipe);
+    PTX_LOGF("recipe %u stopped", (unsigned)ctx->recipe.recipe_id);
+}
+
+const ptx_recipe_t* ptx_oven_ctx_get_recipe(const ptx_oven_ctx_t* ctx) {
+    return &ctx->recipe;
+}
+
+void ptx_oven_ctx_set_door_state(ptx_oven_ctx_t* ctx, bool open) {
+    if (ctx == &pti_default_ctx && ptx_trace_is_recording()) {
+        ptx_trace_note_door(millis(), open);
+    }
+    ctx->status.door_open = open;
+}
+
+void ptx_oven_ctx_set_inhibit(ptx_oven_ctx_t* ctx, bool inhibit) {
+    ctx->inhibit = inhibit;
+}
+
+void ptx_oven_ctx_reset_ignition_lockout(ptx_oven_ctx_t* ctx) {
+    if (ctx->status.state == PTX_HEATING_STATE_LOCKOUT) {
+        ptx_heating_enter(ctx, millis(), PTX_HEATING_STATE_IDLE, PTX_TRANSITION_CAUSE_MANUAL_RESET);
+        ctx->status.ignition_lockout = false;
+        ctx->ignition_attempt = 0;
+        ctx->status.ignition_attempt = 0;
         PTX_LOGF("ignition lockout reset");
     }
-}
\ No newline at end of file
+}
+
+ptx_oven_ctx_t* ptx_oven_default_ctx(void) {
+    return &pti_default_ctx;
+}
+
+/* Single-burner API: wrappers around the default instance */
+const ptx_oven_status_t* ptx_oven_get_status(void) {
+    return ptx_oven_ctx_get_status(&pti_default_ctx);
+}
+
+const ptx_transition_ring_t* ptx_oven_get_transitions(void) {
+    return ptx_oven_ctx_get_transitions(&pti_default_ctx);
+}
+
+bool ptx_oven_start_autotune(uint8_t target_mode, uint8_t cycles) {
+    return ptx_oven_ctx_start_autotune(&pti_default_ctx, target_mode, cycles);
+}
+
+const ptx_autotune_t* ptx_oven_get_autotune(void) {
+    return ptx_oven_ctx_get_autotune(&pti_default_ctx);
+}
+
+bool ptx_oven_start_recipe(uint8_t recipe_id) {
+    return ptx_oven_ctx_start_recipe(&pti_default_ctx, recipe_id);
+}
+
+void ptx_oven_stop_recipe(void) {
+    ptx_oven_ctx_stop_recipe(&pti_default_ctx);
+}
+
+const ptx_recipe_t* ptx_oven_get_recipe(void) {
+    return ptx_oven_ctx_get_recipe(&pti_default_ctx);
+}
+
+void ptx_oven_control_init(void) {
+    ptx_oven_ctx_init(&pti_default_ctx);
+
+    /* Initialize actuators */
+    ptx_actuator_init();
+
+    PTX_LOGF("oven control init");
+}
+
+void ptx_oven_control_update(void) {
+    ptx_oven_ctx_update(&pti_default_ctx);
+}
+
+void ptx_oven_set_door_state(bool open) {
+    ptx_oven_ctx_set_door_state(&pti_default_ctx, open);
+}
+
+void ptx_oven_reset_ignition_lockout(void) {
+    ptx_oven_ctx_reset_ignition_lockout(&pti_default_ctx);
+}
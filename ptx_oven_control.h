@@ -9,6 +9,13 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "ptx_oven_config.h"
+#include "ptx_sensor_filter.h"
+#include "ptx_transition_ring.h"
+#include "ptx_pid.h"
+#include "ptx_autotune.h"
+#include "ptx_rate_estimator.h"
+#include "ptx_recipe.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -28,7 +35,8 @@ typedef enum {
     PTX_HEATING_STATE_IGNITING,   /**< First 5 seconds after gas turns on (igniter ON). */
     PTX_HEATING_STATE_HEATING,    /**< Post-ignition; flame expected; igniter OFF. */
     PTX_HEATING_STATE_PURGING,    /**< Gas purge after failed ignition before retry. */
-    PTX_HEATING_STATE_LOCKOUT     /**< Safety lockout after max failed attempts. */
+    PTX_HEATING_STATE_LOCKOUT,    /**< Safety lockout after max failed attempts. */
+    PTX_HEATING_STATE_COUNT       /**< Number of states (not a state). */
 } ptx_heating_state_t;
 
 /**
@@ -49,8 +57,192 @@ typedef struct {
     
     uint8_t ignition_attempt;  /**< Current ignition attempt counter (1-based). */
     bool    ignition_lockout;  /**< True if in safety lockout after failed ignitions. */
+
+    bool     actuator_fault;       /**< Latched: output readback disagreed with the command. */
+    uint16_t actuator_mismatches;  /**< Readback samples that disagreed (saturates). */
+
+    uint8_t  heat_duty_pct;        /**< PI/PID burner duty (0-100); 0 in hysteresis mode. */
 } ptx_oven_status_t;
 
+/**
+ * @brief Controller instance: all state of one burner's control loop.
+ * @details Members are private to ptx_oven_control.cpp; the struct is public only
+ *          so instances can be allocated statically or by value. Several controllers
+ *          (burners, simulated ovens) can run in one image.
+ *
+ *          Instances are independent across threads only with a private config
+ *          (ptx_oven_ctx_set_config()) and driven through ptx_oven_ctx_step().
+ *          Otherwise they share the global config slots (pinning is not
+ *          synchronized), ptx_oven_ctx_update() drives the global GAS_VALVE/IGNITER
+ *          outputs, and an autotune result is written to the shared config.
+ *          A private config is referenced, not copied: only its compiled form
+ *          lives in the instance.
+ */
+typedef struct {
+    ptx_oven_status_t status;
+
+    uint32_t ignition_start_ms;
+    uint32_t last_log_ms;
+    uint32_t out_of_range_since_ms;          /**< 0 means not currently out of range */
+    uint32_t valid_since_ms;                 /**< 0 means not in continuous valid window */
+    uint8_t  ignition_attempt;               /**< Current attempt number (0 = not started) */
+    uint32_t purge_start_ms;
+    uint32_t ratio_at_ignition_start_q16;    /**< Signal ratio when ignition started */
+    uint32_t signal_ratio_q16;               /**< Clamped signal/vref ratio of the current tick */
+    uint32_t predicted_ratio_q16;            /**< signal_ratio_q16 extrapolated by predict_lead_ms */
+    ptx_rate_estimator_t rate;               /**< Rate of rise of the ratio */
+    uint32_t shutdown_ms;                    /**< Last tick held off by a shutdown, startup or out-of-range reading (pre-ignition guardrail) */
+
+    ptx_sensor_filter_t filter;
+
+    bool inhibit;                            /**< External shutdown request (zone supervisor) */
+
+    uint8_t  verify_countdown;               /**< Ticks until the next readback sample */
+    uint8_t  readback_bad_samples;           /**< Consecutive mismatching readback samples */
+    uint32_t readback_ok_since_ms;           /**< 0 means not in continuous matching window */
+    uint8_t  resync_countdown;               /**< Ticks until every output is rewritten */
+
+    ptx_transition_ring_t transitions;       /**< Last heating state changes */
+
+    ptx_pid_t pid;                           /**< PI/PID duty controller and burner window */
+    bool burner_demand;                      /**< PI/PID: burner wanted in the current window */
+
+    ptx_autotune_t autotune;                 /**< Relay autotune session */
+    ptx_recipe_t recipe;                     /**< Staged setpoint profile */
+
+    const ptx_oven_config_t* config;         /**< Caller-owned private config; NULL uses the shared one */
+    ptx_oven_config_compiled_t compiled;     /**< Compiled form of config (unused while config is NULL) */
+} ptx_oven_ctx_t;
+
+/**
+ * @brief Initialize a controller instance (state, sensor filter; uses the shared config).
+ * @param ctx Instance to initialize.
+ * @note Does not touch actuators; ptx_oven_control_init() does that for the default instance.
+ */
+void ptx_oven_ctx_init(ptx_oven_ctx_t* ctx);
+
+/**
+ * @brief Give an instance its own configuration instead of the shared one.
+ * @param ctx Instance.
+ * @param config Caller-owned configuration, or NULL to return to the shared
+ *        configuration. It must outlive its use by the instance; after changing
+ *        it, call this again so the compiled thresholds follow.
+ * @return true if applied, false if config failed ptx_oven_config_validate()
+ *         or the build bakes in a profile (PTX_OVEN_PROFILE).
+ * @note Not synchronized with ptx_oven_ctx_step(); call between ticks of that instance.
+ */
+bool ptx_oven_ctx_set_config(ptx_oven_ctx_t* ctx, const ptx_oven_config_t* config);
+
+/**
+ * @brief Run one control iteration on raw sensor values without touching hardware.
+ * @param ctx Instance.
+ * @param now_ms Current time (ms).
+ * @param raw_vref_mv Unfiltered reference voltage (mV).
+ * @param raw_signal_mv Unfiltered signal voltage (mV).
+ * @details Output commands are left in ptx_oven_ctx_get_status(ctx)->gas_on / igniter_on.
+ */
+void ptx_oven_ctx_step(ptx_oven_ctx_t* ctx, uint32_t now_ms, uint16_t raw_vref_mv, uint16_t raw_signal_mv);
+
+/**
+ * @brief Execute one control iteration: read sensors, step, drive actuators.
+ * @param ctx Instance.
+ */
+void ptx_oven_ctx_update(ptx_oven_ctx_t* ctx);
+
+/**
+ * @brief Status snapshot of an instance.
+ * @param ctx Instance.
+ * @return Pointer to the instance's status.
+ */
+const ptx_oven_status_t* ptx_oven_ctx_get_status(const ptx_oven_ctx_t* ctx);
+
+/**
+ * @brief Heating state transitions recorded by an instance.
+ * @param ctx Instance.
+ * @return Pointer to the instance's transition ring.
+ * @note Entering LOCKOUT also prints the ring through PTX_LOGF.
+ */
+const ptx_transition_ring_t* ptx_oven_ctx_get_transitions(const ptx_oven_ctx_t* ctx);
+
+/**
+ * @brief Start a relay autotune session on an instance.
+ * @param ctx Instance.
+ * @param target_mode PTX_CONTROL_MODE_PI or PTX_CONTROL_MODE_PID.
+ * @param cycles Limit cycles to average (1..PTX_AUTOTUNE_MAX_CYCLES).
+ * @return false if an argument is out of range, a recipe runs, or the build
+ *         bakes in a profile (tuned gains could not be applied).
+ * @details The instance heats with its hysteresis thresholds until the cycles are
+ *          measured, then writes the gains and target_mode into the shared
+ *          configuration at the end of that tick. A private configuration is the
+ *          caller's: apply the result with ptx_autotune_apply() and
+ *          ptx_oven_ctx_set_config(). A shutdown or lockout aborts the session.
+ */
+bool ptx_oven_ctx_start_autotune(ptx_oven_ctx_t* ctx, uint8_t target_mode, uint8_t cycles);
+
+/**
+ * @brief Autotune session of an instance (state, progress and results).
+ */
+const ptx_autotune_t* ptx_oven_ctx_get_autotune(const ptx_oven_ctx_t* ctx);
+
+/**
+ * @brief Run a built-in recipe on an instance.
+ * @param ctx Instance.
+ * @param recipe_id 1..ptx_recipe_count().
+ * @return false for an unknown id or while an autotune session runs.
+ * @details The setpoint ramps from the current temperature through the recipe's
+ *          segments; the ON/OFF thresholds keep the configured half-band around
+ *          it. A running recipe is restarted. An ignition lockout aborts it.
+ */
+bool ptx_oven_ctx_start_recipe(ptx_oven_ctx_t* ctx, uint8_t recipe_id);
+
+/**
+ * @brief Stop the recipe of an instance; the configured target applies again.
+ */
+void ptx_oven_ctx_stop_recipe(ptx_oven_ctx_t* ctx);
+
+/**
+ * @brief Recipe executor of an instance (state, segment and setpoint).
+ */
+const ptx_recipe_t* ptx_oven_ctx_get_recipe(const ptx_oven_ctx_t* ctx);
+
+/**
+ * @brief Update the door state of an instance.
+ * @param ctx Instance.
+ * @param open true if door is open, false if closed.
+ */
+void ptx_oven_ctx_set_door_state(ptx_oven_ctx_t* ctx, bool open);
+
+/**
+ * @brief Report one output readback sample of an instance.
+ * @param ctx Instance.
+ * @param match true if the pins of the instance's outputs agree with their command.
+ * @details PTX_ACTUATOR_VERIFY_LATCH mismatches in a row latch actuator_fault on the
+ *          next tick, which shuts the burner down like sensor_fault; it clears after
+ *          auto_resume_delay_ms of matching samples. ptx_oven_ctx_update() samples
+ *          every PTX_ACTUATOR_VERIFY_TICKS ticks; the zone layer samples its own.
+ */
+void ptx_oven_ctx_note_readback(ptx_oven_ctx_t* ctx, bool match);
+
+/**
+ * @brief Force an instance's burner off (external supervisor), or release it.
+ * @param ctx Instance.
+ * @param inhibit true to hold outputs off and the state machine in IDLE.
+ * @note An ignition lockout is kept while inhibited; it still needs a manual reset.
+ */
+void ptx_oven_ctx_set_inhibit(ptx_oven_ctx_t* ctx, bool inhibit);
+
+/**
+ * @brief Reset ignition lockout of an instance.
+ * @param ctx Instance.
+ */
+void ptx_oven_ctx_reset_ignition_lockout(ptx_oven_ctx_t* ctx);
+
+/**
+ * @brief Default instance used by the single-burner API below.
+ * @return Pointer to the default instance.
+ */
+ptx_oven_ctx_t* ptx_oven_default_ctx(void);
+
 /**
  * @brief Initialize oven control module.
  * @note Does not configure hardware I/O; relies on api.h setup.
@@ -67,6 +259,39 @@ void ptx_oven_control_update(void);
  */
 const ptx_oven_status_t* ptx_oven_get_status(void);
 
+/**
+ * @brief Heating state transitions of the default instance (zone 0)
+ * @return Pointer to the transition ring
+ */
+const ptx_transition_ring_t* ptx_oven_get_transitions(void);
+
+/**
+ * @brief Start a relay autotune session on the default instance
+ * @see ptx_oven_ctx_start_autotune()
+ */
+bool ptx_oven_start_autotune(uint8_t target_mode, uint8_t cycles);
+
+/**
+ * @brief Autotune session of the default instance
+ */
+const ptx_autotune_t* ptx_oven_get_autotune(void);
+
+/**
+ * @brief Run a built-in recipe on the default instance
+ * @see ptx_oven_ctx_start_recipe()
+ */
+bool ptx_oven_start_recipe(uint8_t recipe_id);
+
+/**
+ * @brief Stop the recipe of the default instance
+ */
+void ptx_oven_stop_recipe(void);
+
+/**
+ * @brief Recipe executor of the default instance
+ */
+const ptx_recipe_t* ptx_oven_get_recipe(void);
+
 /**
  * @brief Reset ignition lockout (manual reset after failed attempts)
  * @note Clears lockout state and resets attempt counter
@@ -0,0 +1,167 @@
+/**
+ * @file ptx_oven_profile.h
+ * @brief Compile-time configuration profiles (C++ only)
+ * @details A profile is a specialization of ptx_oven_profile<> holding the
+ *          configuration as constexpr values. Building ptx_oven_control.cpp with
+ *          -DPTX_OVEN_PROFILE=<profile id> instantiates the controller against
+ *          ptx_oven_profile_view<>, so thresholds and timings fold into
+ *          immediates and the tick does no config pointer loads. Without the
+ *          define the controller reads the runtime-configurable pinned slot.
+ *
+ *          The runtime config is not consulted in a profile build, so writes
+ *          to it are refused rather than silently ignored: the ptx_oven_set_*
+ *          setters, ptx_oven_ctx_set_config() and ptx_oven_ctx_start_autotune()
+ *          return false, SET_FIELD answers REJECTED and SAVE_CONFIG UNKNOWN_CMD.
+ */
+#ifndef PTX_OVEN_PROFILE_H
+#define PTX_OVEN_PROFILE_H
+
+#include <stdint.h>
+#include "ptx_oven_config.h"
+
+/* Same math as ptx_oven_temp_to_ratio_q16(); usable in constant expressions */
+constexpr uint32_t ptx_temp_to_ratio_q16_constexpr(float temp_c) {
+    return (0.10f + 0.80f * (temp_c + 10.0f) / 310.0f <= 0.0f)
+        ? 0U
+        : (uint32_t)((0.10f + 0.80f * (temp_c + 10.0f) / 310.0f) * (float)PTX_RATIO_Q16_ONE + 0.5f);
+}
+
+/* Temperature difference (°C) as a signal ratio difference (Q16) */
+constexpr uint32_t ptx_temp_rise_to_ratio_q16_constexpr(float rise_c) {
+    return (uint32_t)(0.80f * rise_c / 310.0f * (float)PTX_RATIO_Q16_ONE + 0.5f);
+}
+
+constexpr uint16_t ptx_volts_to_mv_constexpr(float volts) {
+    return (uint16_t)(volts * 1000.0f + 0.5f);
+}
+
+/**
+ * @brief Profile identifiers for -DPTX_OVEN_PROFILE=...
+ */
+typedef enum {
+    PTX_OVEN_PROFILE_BAKERY_180C = 1,  /**< Cookie oven: 180 °C ± 5 °C, stock timings */
+    PTX_OVEN_PROFILE_PIZZA_250C        /**< Deck oven: 250 °C ± 5 °C, longer ignition */
+} ptx_oven_profile_id_t;
+
+/** Primary template intentionally undefined: unknown profile ids fail to compile */
+template <ptx_oven_profile_id_t Id>
+struct ptx_oven_profile;
+
+template <>
+struct ptx_oven_profile<PTX_OVEN_PROFILE_BAKERY_180C> {
+    static constexpr uint32_t ignition_duration_ms     = 5000U;
+    static constexpr uint32_t periodic_log_ms          = 1000U;
+    static constexpr uint32_t sensor_fault_window_ms   = 1000U;
+    static constexpr uint32_t auto_resume_delay_ms     = 3000U;
+    static constexpr float    vref_min_v               = 4.5f;
+    static constexpr float    vref_max_v               = 5.5f;
+    static constexpr float    temp_target_c            = 180.0f;
+    static constexpr float    temp_delta_c             = 5.0f;
+    static constexpr uint8_t  max_ignition_attempts    = 3U;
+    static constexpr uint32_t purge_time_ms            = 2500U;
+    static constexpr float    flame_detect_temp_rise_c = 2.0f;
+    static constexpr uint8_t  control_mode             = PTX_CONTROL_MODE_HYSTERESIS;
+    static constexpr float    pid_kp                   = 0.05f;
+    static constexpr float    pid_ki                   = 0.0005f;
+    static constexpr float    pid_kd                   = 0.5f;
+    static constexpr uint32_t pid_window_ms            = 30000U;
+    static constexpr uint32_t predict_lead_ms          = 0U;
+    static constexpr uint8_t  preignite_enabled        = 0U;
+};
+
+template <>
+struct ptx_oven_profile<PTX_OVEN_PROFILE_PIZZA_250C> {
+    static constexpr uint32_t ignition_duration_ms     = 7000U;
+    static constexpr uint32_t periodic_log_ms          = 1000U;
+    static constexpr uint32_t sensor_fault_window_ms   = 1000U;
+    static constexpr uint32_t auto_resume_delay_ms     = 3000U;
+    static constexpr float    vref_min_v               = 4.5f;
+    static constexpr float    vref_max_v               = 5.5f;
+    static constexpr float    temp_target_c            = 250.0f;
+    static constexpr float    temp_delta_c             = 5.0f;
+    static constexpr uint8_t  max_ignition_attempts    = 3U;
+    static constexpr uint32_t purge_time_ms            = 3000U;
+    static constexpr float    flame_detect_temp_rise_c = 3.0f;
+    static constexpr uint8_t  control_mode             = PTX_CONTROL_MODE_HYSTERESIS;
+    static constexpr float    pid_kp                   = 0.05f;
+    static constexpr float    pid_ki                   = 0.0005f;
+    static constexpr float    pid_kd                   = 0.5f;
+    static constexpr uint32_t pid_window_ms            = 30000U;
+    static constexpr uint32_t predict_lead_ms          = 0U;
+    static constexpr uint8_t  preignite_enabled        = 0U;
+};
+
+/**
+ * @brief Controller view of a profile: every accessor is a constant expression
+ * @details Mirrors the accessors of the runtime view in ptx_oven_control.cpp.
+ */
+template <ptx_oven_profile_id_t Id>
+struct ptx_oven_profile_view {
+    typedef ptx_oven_profile<Id> P;
+
+    /* Same ranges as ptx_oven_config_validate(), checked at compile time */
+    static_assert(P::ignition_duration_ms >= 1000 && P::ignition_duration_ms <= 30000, "ignition_duration_ms");
+    static_assert(P::periodic_log_ms >= 100 && P::periodic_log_ms <= 60000, "periodic_log_ms");
+    static_assert(P::sensor_fault_window_ms >= 100 && P::sensor_fault_window_ms <= 10000, "sensor_fault_window_ms");
+    static_assert(P::auto_resume_delay_ms >= 1000 && P::auto_resume_delay_ms <= 30000, "auto_resume_delay_ms");
+    static_assert(P::vref_min_v >= 0.0f && P::vref_max_v <= 10.0f && P::vref_min_v < P::vref_max_v, "vref range");
+    static_assert(P::temp_target_c >= 0.0f && P::temp_target_c <= 300.0f, "temp_target_c");
+    static_assert(P::temp_delta_c >= 0.1f && P::temp_delta_c <= 50.0f, "temp_delta_c");
+    static_assert(P::max_ignition_attempts >= 1 && P::max_ignition_attempts <= 10, "max_ignition_attempts");
+    static_assert(P::purge_time_ms >= 1000 && P::purge_time_ms <= 10000, "purge_time_ms");
+    static_assert(P::flame_detect_temp_rise_c > 0.0f && P::flame_detect_temp_rise_c <= 50.0f, "flame_detect_temp_rise_c");
+    static_assert(P::control_mode <= PTX_CONTROL_MODE_PID, "control_mode");
+    static_assert(P::pid_kp >= 0.0f && P::pid_kp <= 10.0f && P::pid_ki >= 0.0f && P::pid_ki <= 1.0f &&
+                  P::pid_kd >= 0.0f && P::pid_kd <= 100.0f, "pid gains");
+    static_assert(P::pid_window_ms <= 600000U && (P::control_mode == PTX_CONTROL_MODE_HYSTERESIS ||
+                  P::pid_window_ms >= P::ignition_duration_ms + P::purge_time_ms), "pid_window_ms");
+    static_assert(P::predict_lead_ms <= 30000U, "predict_lead_ms");
+    static_assert(P::preignite_enabled <= 1U, "preignite_enabled");
+
+    static constexpr uint32_t ignition_duration_ms()   { return P::ignition_duration_ms; }
+    static constexpr uint32_t periodic_log_ms()        { return P::periodic_log_ms; }
+    static constexpr uint32_t sensor_fault_window_ms() { return P::sensor_fault_window_ms; }
+    static constexpr uint32_t auto_resume_delay_ms()   { return P::auto_resume_delay_ms; }
+    static constexpr uint8_t  max_ignition_attempts()  { return P::max_ignition_attempts; }
+    static constexpr uint32_t purge_time_ms()          { return P::purge_time_ms; }
+    static constexpr uint16_t vref_min_mv()            { return ptx_volts_to_mv_constexpr(P::vref_min_v); }
+    static constexpr uint16_t vref_max_mv()            { return ptx_volts_to_mv_constexpr(P::vref_max_v); }
+    static constexpr uint32_t signal_lo_q16()          { return PTX_SIGNAL_LO_Q16; }
+    static constexpr uint32_t signal_hi_q16()          { return PTX_SIGNAL_HI_Q16; }
+    static constexpr uint32_t temp_on_q16()  { return ptx_temp_to_ratio_q16_constexpr(P::temp_target_c - P::temp_delta_c); }
+    static constexpr uint32_t temp_off_q16() { return ptx_temp_to_ratio_q16_constexpr(P::temp_target_c + P::temp_delta_c); }
+    static constexpr uint32_t flame_rise_q16() { return ptx_temp_rise_to_ratio_q16_constexpr(P::flame_detect_temp_rise_c); }
+    static constexpr uint8_t  control_mode()           { return P::control_mode; }
+    static constexpr float    temp_target_c()          { return P::temp_target_c; }
+    static constexpr float    temp_delta_c()           { return P::temp_delta_c; }
+    static constexpr float    pid_kp()                 { return P::pid_kp; }
+    static constexpr float    pid_ki()                 { return P::pid_ki; }
+    static constexpr float    pid_kd()                 { return P::pid_kd; }
+    static constexpr uint32_t pid_window_ms()          { return P::pid_window_ms; }
+    static constexpr uint32_t predict_lead_ms()        { return P::predict_lead_ms; }
+    static constexpr uint8_t  preignite_enabled()      { return P::preignite_enabled; }
+
+    /** Expand the profile into a runtime config (tests, EEPROM seeding) */
+    static void to_config(ptx_oven_config_t* cfg) {
+        cfg->ignition_duration_ms     = P::ignition_duration_ms;
+        cfg->periodic_log_ms          = P::periodic_log_ms;
+        cfg->sensor_fault_window_ms   = P::sensor_fault_window_ms;
+        cfg->auto_resume_delay_ms     = P::auto_resume_delay_ms;
+        cfg->vref_min_v               = P::vref_min_v;
+        cfg->vref_max_v               = P::vref_max_v;
+        cfg->temp_target_c            = P::temp_target_c;
+        cfg->temp_delta_c             = P::temp_delta_c;
+        cfg->max_ignition_attempts    = P::max_ignition_attempts;
+        cfg->purge_time_ms            = P::purge_time_ms;
+        cfg->flame_detect_temp_rise_c = P::flame_detect_temp_rise_c;
+        cfg->control_mode             = P::control_mode;
+        cfg->pid_kp                   = P::pid_kp;
+        cfg->pid_ki                   = P::pid_ki;
+        cfg->pid_kd                   = P::pid_kd;
+        cfg->pid_window_ms            = P::pid_window_ms;
+        cfg->predict_lead_ms          = P::predict_lead_ms;
+        cfg->preignite_enabled        = P::preignite_enabled;
+    }
+};
+
+#endif /* PTX_OVEN_PROFILE_H */
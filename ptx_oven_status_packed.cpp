@@ -0,0 +1,62 @@
+/**
+ * @file ptx_oven_status_packed.cpp
+ * @brief Conversion between ptx_oven_status_t and its packed form
+ */
+#include "ptx_oven_status_packed.h"
+
+/* Packed layout is part of the telemetry format; keep it pinned */
+static_assert(sizeof(ptx_oven_status_packed_t) == 8, "packed status must stay 8 bytes");
+static_assert(PTX_HEATING_STATE_LOCKOUT <= PTX_STATUS_STATE_MASK, "heating state must fit in 3 bits");
+
+static int16_t ptx_pack_deci(float value) {
+    float scaled = value * 10.0f;
+    if (scaled >= 32767.0f) return 32767;
+    if (scaled <= -32768.0f) return -32768;
+    /* Round half away from zero, same as the controller's log rounding */
+    return (int16_t)(scaled >= 0.0f ? scaled + 0.5f : scaled - 0.5f);
+}
+
+static uint16_t ptx_pack_mv(float volts) {
+    float mv = volts * 1000.0f;
+    if (mv <= 0.0f) return 0;
+    if (mv >= 65535.0f) return 65535U;
+    return (uint16_t)(mv + 0.5f);
+}
+
+void ptx_oven_status_pack(const ptx_oven_status_t* status, ptx_oven_status_packed_t* packed) {
+    uint8_t flags = 0;
+    if (status->door_open)        flags |= PTX_STATUS_FLAG_DOOR_OPEN;
+    if (status->gas_on)           flags |= PTX_STATUS_FLAG_GAS_ON;
+    if (status->igniter_on)       flags |= PTX_STATUS_FLAG_IGNITER_ON;
+    if (status->vref_fault)       flags |= PTX_STATUS_FLAG_VREF_FAULT;
+    if (status->signal_fault)     flags |= PTX_STATUS_FLAG_SIGNAL_FAULT;
+    if (status->sensor_fault)     flags |= PTX_STATUS_FLAG_SENSOR_FAULT;
+    if (status->ignition_lockout) flags |= PTX_STATUS_FLAG_IGNITION_LOCKOUT;
+    if (status->actuator_fault)   flags |= PTX_STATUS_FLAG_ACTUATOR_FAULT;
+
+    uint8_t attempt = status->ignition_attempt;
+    if (attempt > PTX_STATUS_ATTEMPT_MAX) attempt = PTX_STATUS_ATTEMPT_MAX;
+
+    packed->temperature_dc = ptx_pack_deci(status->temperature_c);
+    packed->vref_mv        = ptx_pack_mv(status->vref_volts);
+    packed->signal_mv      = ptx_pack_mv(status->signal_volts);
+    packed->flags          = flags;
+    packed->state_attempt  = (uint8_t)(((uint8_t)status->state & PTX_STATUS_STATE_MASK) |
+                                       (uint8_t)(attempt << PTX_STATUS_ATTEMPT_SHIFT));
+}
+
+void ptx_oven_status_unpack(const ptx_oven_status_packed_t* packed, ptx_oven_status_t* status) {
+    status->temperature_c    = (float)packed->temperature_dc / 10.0f;
+    status->vref_volts       = (float)packed->vref_mv / 1000.0f;
+    status->signal_volts     = (float)packed->signal_mv / 1000.0f;
+    status->door_open        = (packed->flags & PTX_STATUS_FLAG_DOOR_OPEN) != 0;
+    status->gas_on           = (packed->flags & PTX_STATUS_FLAG_GAS_ON) != 0;
+    status->igniter_on       = (packed->flags & PTX_STATUS_FLAG_IGNITER_ON) != 0;
+    status->vref_fault       = (packed->flags & PTX_STATUS_FLAG_VREF_FAULT) != 0;
+    status->signal_fault     = (packed->flags & PTX_STATUS_FLAG_SIGNAL_FAULT) != 0;
+    status->sensor_fault     = (packed->flags & PTX_STATUS_FLAG_SENSOR_FAULT) != 0;
+    status->ignition_lockout = (packed->flags & PTX_STATUS_FLAG_IGNITION_LOCKOUT) != 0;
+    status->actuator_fault   = (packed->flags & PTX_STATUS_FLAG_ACTUATOR_FAULT) != 0;
+    status->state            = ptx_oven_status_packed_state(packed);
+    status->ignition_attempt = ptx_oven_status_packed_attempt(packed);
+}
@@ -0,0 +1,81 @@
+/**
+ * @file ptx_oven_status_packed.h
+ * @brief Compact 8-byte representation of ptx_oven_status_t
+ * @details Packed form used for history buffers and telemetry frames.
+ *          Temperature is stored as signed deci-degrees, voltages as millivolts,
+ *          fault/output flags share one byte, and the heating state and ignition
+ *          attempt counter share another. Byte layout is fixed (little-endian on
+ *          both AVR and host), so the struct can be copied to the wire as-is.
+ */
+#ifndef PTX_OVEN_STATUS_PACKED_H
+#define PTX_OVEN_STATUS_PACKED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ptx_oven_control.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Bits of ptx_oven_status_packed_t::flags */
+#define PTX_STATUS_FLAG_DOOR_OPEN        (1U << 0)
+#define PTX_STATUS_FLAG_GAS_ON           (1U << 1)
+#define PTX_STATUS_FLAG_IGNITER_ON       (1U << 2)
+#define PTX_STATUS_FLAG_VREF_FAULT       (1U << 3)
+#define PTX_STATUS_FLAG_SIGNAL_FAULT     (1U << 4)
+#define PTX_STATUS_FLAG_SENSOR_FAULT     (1U << 5)
+#define PTX_STATUS_FLAG_IGNITION_LOCKOUT (1U << 6)
+#define PTX_STATUS_FLAG_ACTUATOR_FAULT   (1U << 7)
+
+/* Layout of ptx_oven_status_packed_t::state_attempt */
+#define PTX_STATUS_STATE_MASK            0x07U  /**< bits 0-2: ptx_heating_state_t */
+#define PTX_STATUS_ATTEMPT_SHIFT         3U     /**< bits 3-7: ignition attempt (0-31) */
+#define PTX_STATUS_ATTEMPT_MAX           31U
+
+/**
+ * @brief Packed status snapshot (8 bytes, no padding)
+ */
+typedef struct {
+    int16_t  temperature_dc;  /**< Computed temperature (0.1 °C). */
+    uint16_t vref_mv;         /**< Reference voltage (mV). */
+    uint16_t signal_mv;       /**< Sensor signal (mV). */
+    uint8_t  flags;           /**< PTX_STATUS_FLAG_* bits. */
+    uint8_t  state_attempt;   /**< Heating state (3 bits) and ignition attempt (5 bits). */
+} ptx_oven_status_packed_t;
+
+/**
+ * @brief Pack a full status snapshot into its compact form
+ * @param status Source status (must not be NULL)
+ * @param packed Destination (must not be NULL)
+ * @note Temperature is rounded to 0.1 °C and voltages to 1 mV; out-of-range
+ *       values saturate.
+ */
+void ptx_oven_status_pack(const ptx_oven_status_t* status, ptx_oven_status_packed_t* packed);
+
+/**
+ * @brief Expand a packed snapshot back into the full status structure
+ * @param packed Source packed snapshot (must not be NULL)
+ * @param status Destination (must not be NULL)
+ */
+void ptx_oven_status_unpack(const ptx_oven_status_packed_t* packed, ptx_oven_status_t* status);
+
+/**
+ * @brief Extract heating state from a packed snapshot
+ */
+static inline ptx_heating_state_t ptx_oven_status_packed_state(const ptx_oven_status_packed_t* packed) {
+    return (ptx_heating_state_t)(packed->state_attempt & PTX_STATUS_STATE_MASK);
+}
+
+/**
+ * @brief Extract ignition attempt counter from a packed snapshot
+ */
+static inline uint8_t ptx_oven_status_packed_attempt(const ptx_oven_status_packed_t* packed) {
+    return (uint8_t)(packed->state_attempt >> PTX_STATUS_ATTEMPT_SHIFT);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PTX_OVEN_STATUS_PACKED_H */
@@ -0,0 +1,198 @@
+/**
+ * @file ptx_oven_zones.cpp
+ * @brief Implementation of multi-zone control and the shared safety supervisor
+ */
+#include "ptx_oven_zones.h"
+#include "ptx_actuator.h"
+#include "ptx_trace.h"
+#include "api.h"
+#include "ptx_logging.h"
+#include <stddef.h>
+
+/* Single-burner builds (the sketch default) drive the default instance directly;
+   the second zone's instance and I/O table are not linked in */
+#if (PTX_OVEN_MULTI_ZONE_ENABLED)
+
+typedef struct {
+    input_t  vref_input;
+    input_t  signal_input;
+    output_t gas_output;
+    output_t igniter_output;
+} pti_zone_io_t;
+
+static const pti_zone_io_t pti_zone_io[PTX_OVEN_MAX_ZONES] = {
+    { TEMPERATURE_SENSOR_REFERENCE,   TEMPERATURE_SENSOR,   GAS_VALVE,   IGNITER },
+    { TEMPERATURE_SENSOR_2_REFERENCE, TEMPERATURE_SENSOR_2, GAS_VALVE_2, IGNITER_2 },
+};
+
+/* Zone 0 is the default instance so the single-burner API keeps reporting it */
+static ptx_oven_ctx_t pti_zone_ctx_extra[PTX_OVEN_MAX_ZONES - 1];
+static ptx_oven_zone_stats_t pti_zone_stats[PTX_OVEN_MAX_ZONES];
+static uint8_t pti_zone_count = 1;
+static volatile bool pti_door_open = false;
+static bool pti_tripped = false;
+static uint32_t pti_tick_us = 0;
+static uint8_t pti_verify_countdown = PTX_ACTUATOR_VERIFY_TICKS;
+static uint8_t pti_resync_countdown = PTX_ACTUATOR_RESYNC_TICKS;
+
+static ptx_oven_ctx_t* ptx_zone_ctx(uint8_t zone) {
+    return (zone == 0) ? ptx_oven_default_ctx() : &pti_zone_ctx_extra[zone - 1];
+}
+
+/* Shared safety decision: door open or a gas fault in any zone shuts down every zone */
+static bool ptx_zones_supervise(bool door_open) {
+    if (door_open) return true;
+    for (uint8_t z = 0; z < pti_zone_count; z++) {
+        const ptx_oven_status_t* st = ptx_oven_ctx_get_status(ptx_zone_ctx(z));
+        if (st->ignition_lockout || st->sensor_fault || st->actuator_fault) return true;
+    }
+    return false;
+}
+
+void ptx_oven_zones_init(uint8_t count) {
+    if (count < 1) count = 1;
+    if (count > PTX_OVEN_MAX_ZONES) count = PTX_OVEN_MAX_ZONES;
+    pti_zone_count = count;
+    pti_tripped = false;
+    pti_verify_countdown = PTX_ACTUATOR_VERIFY_TICKS;
+    pti_resync_countdown = PTX_ACTUATOR_RESYNC_TICKS;
+
+    for (uint8_t z = 0; z < PTX_OVEN_MAX_ZONES; z++) {
+        ptx_oven_ctx_init(ptx_zone_ctx(z));
+        ptx_oven_ctx_set_door_state(ptx_zone_ctx(z), pti_door_open);
+    }
+    ptx_oven_zones_reset_stats();
+    ptx_actuator_init();
+
+    PTX_LOGF("oven zones init count=%d", (int)count);
+}
+
+uint8_t ptx_oven_zones_count(void) {
+    return pti_zone_count;
+}
+
+bool ptx_oven_zones_set_override(uint8_t zone, const ptx_oven_config_t* config) {
+    if (zone >= pti_zone_count) return false;
+    return ptx_oven_ctx_set_config(ptx_zone_ctx(zone), config);
+}
+
+void ptx_oven_zones_update(void) {
+    uint32_t tick_start_us = get_micros();
+    uint32_t now = millis();
+    bool door_open = pti_door_open;
+    bool fault_latched = false;
+
+    for (uint8_t z = 0; z < pti_zone_count; z++) {
+        ptx_oven_ctx_t* ctx = ptx_zone_ctx(z);
+        const pti_zone_io_t* io = &pti_zone_io[z];
+        uint16_t raw_vref_mv   = read_voltage(io->vref_input);
+        uint16_t raw_signal_mv = read_voltage(io->signal_input);
+
+        if (ptx_oven_ctx_get_status(ctx)->door_open != door_open) {
+            ptx_oven_ctx_set_door_state(ctx, door_open);  /* only edges reach the trace */
+        }
+        ptx_oven_ctx_set_inhibit(ctx, pti_tripped);
+        if (z == 0) {
+            /* Zone 0 is the traced default instance (replayed as a single burner) */
+            ptx_trace_record_tick(now, raw_vref_mv, raw_signal_mv);
+        }
+
+        bool had_fault = ptx_oven_ctx_get_status(ctx)->actuator_fault;
+        uint32_t t0 = get_micros();
+        ptx_oven_ctx_step(ctx, now, raw_vref_mv, raw_signal_mv);
+        uint32_t dt = get_micros() - t0;
+        if (ptx_oven_ctx_get_status(ctx)->actuator_fault && !had_fault) fault_latched = true;
+
+        ptx_oven_zone_stats_t* stats = &pti_zone_stats[z];
+        stats->last_us = dt;
+        if (dt > stats->max_us) stats->max_us = dt;
+        stats->total_us += dt;
+        stats->ticks++;
+    }
+
+    /* Decide on this tick's results so a new fault never reaches the outputs */
+    bool tripped = ptx_zones_supervise(door_open);
+    if (tripped != pti_tripped) {
+        PTX_LOGF("zone supervisor %s", tripped ? "trip: all burners off" : "released");
+        pti_tripped = tripped;
+    }
+
+    for (uint8_t z = 0; z < pti_zone_count; z++) {
+        const ptx_oven_status_t* st = ptx_oven_ctx_get_status(ptx_zone_ctx(z));
+        ptx_actuator_set_channel(pti_zone_io[z].gas_output, !tripped && st->gas_on);
+        ptx_actuator_set_channel(pti_zone_io[z].igniter_output, !tripped && st->igniter_on);
+    }
+    if (fault_latched) {
+        /* The shutdown may not change the shadow (a pin stuck on while commanded off) */
+        ptx_actuator_resync();
+    }
+
+#if (PTX_ACTUATOR_VERIFY_TICKS > 0)
+    /* One readback serves every zone; each zone judges its own pins */
+    if (--pti_verify_countdown == 0) {
+        pti_verify_countdown = PTX_ACTUATOR_VERIFY_TICKS;
+        uint8_t mismatch = ptx_actuator_readback_mismatch();
+        bool any = false;
+        for (uint8_t z = 0; z < pti_zone_count; z++) {
+            uint8_t mine = (uint8_t)(PTX_ACTUATOR_CHANNEL_BIT(pti_zone_io[z].gas_output) |
+                                     PTX_ACTUATOR_CHANNEL_BIT(pti_zone_io[z].igniter_output));
+            ptx_oven_ctx_note_readback(ptx_zone_ctx(z), (mismatch & mine) == 0);
+            if (mismatch & mine) any = true;
+        }
+        /* Drive a disagreeing pin back now instead of waiting for the periodic resync */
+        if (any) ptx_actuator_resync();
+    }
+#endif
+#if (PTX_ACTUATOR_RESYNC_TICKS > 0)
+    /* One rewrite covers every zone's pins */
+    if (--pti_resync_countdown == 0) {
+        pti_resync_countdown = PTX_ACTUATOR_RESYNC_TICKS;
+        ptx_actuator_resync();
+    }
+#endif
+
+    pti_tick_us = get_micros() - tick_start_us;
+}
+
+void ptx_oven_zones_set_door_state(bool open) {
+    pti_door_open = open;
+    for (uint8_t z = 0; z < pti_zone_count; z++) {
+        ptx_oven_ctx_set_door_state(ptx_zone_ctx(z), open);
+    }
+}
+
+void ptx_oven_zones_reset_ignition_lockout(void) {
+    for (uint8_t z = 0; z < pti_zone_count; z++) {
+        ptx_oven_ctx_reset_ignition_lockout(ptx_zone_ctx(z));
+    }
+}
+
+bool ptx_oven_zones_tripped(void) {
+    return pti_tripped;
+}
+
+const ptx_oven_status_t* ptx_oven_zones_get_status(uint8_t zone) {
+    if (zone >= pti_zone_count) return NULL;
+    return ptx_oven_ctx_get_status(ptx_zone_ctx(zone));
+}
+
+const ptx_oven_zone_stats_t* ptx_oven_zones_get_stats(uint8_t zone) {
+    if (zone >= pti_zone_count) return NULL;
+    return &pti_zone_stats[zone];
+}
+
+uint32_t ptx_oven_zones_get_tick_us(void) {
+    return pti_tick_us;
+}
+
+void ptx_oven_zones_reset_stats(void) {
+    for (uint8_t z = 0; z < PTX_OVEN_MAX_ZONES; z++) {
+        pti_zone_stats[z].last_us = 0;
+        pti_zone_stats[z].max_us = 0;
+        pti_zone_stats[z].total_us = 0;
+        pti_zone_stats[z].ticks = 0;
+    }
+    pti_tick_us = 0;
+}
+
+#endif /* PTX_OVEN_MULTI_ZONE_ENABLED */
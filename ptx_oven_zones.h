@@ -0,0 +1,113 @@
+/**
+ * @file ptx_oven_zones.h
+ * @brief Multi-zone oven: one controller instance per burner, shared safety supervisor
+ * @details Each zone has its own sensor pair, median filter, hysteresis state
+ *          machine and ignition sequence (a ptx_oven_ctx_t). Zones use the shared
+ *          runtime configuration unless given a per-zone override. One call to
+ *          ptx_oven_zones_update() ticks every zone, then the supervisor decides
+ *          in one place whether all burners must be shut down:
+ *          - door open (the door is shared by every zone)
+ *          - gas fault in any zone: ignition lockout, latched sensor fault or
+ *            latched actuator fault (output readback disagrees with the command)
+ *          While tripped, every zone is inhibited and all outputs are written off.
+ *
+ *          Zone 0 is the default controller instance, so the single-burner API
+ *          (ptx_oven_get_status(), serial GET_STATUS) reports zone 0.
+ */
+#ifndef PTX_OVEN_ZONES_H
+#define PTX_OVEN_ZONES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ptx_oven_control.h"
+#include "ptx_oven_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Build options */
+#ifndef PTX_OVEN_MULTI_ZONE_ENABLED
+#define PTX_OVEN_MULTI_ZONE_ENABLED 0  /* Sketch drives a single burner by default; 0 compiles ptx_oven_zones.cpp out */
+#endif
+
+#define PTX_OVEN_MAX_ZONES 2U  /**< Zones with I/O channels in api.h */
+
+/**
+ * @brief Per-zone step timing (get_micros() based)
+ */
+typedef struct {
+    uint32_t last_us;   /**< Duration of the latest step */
+    uint32_t max_us;    /**< Longest step since init/reset */
+    uint32_t total_us;  /**< Sum of step durations (wraps) */
+    uint32_t ticks;     /**< Number of steps measured */
+} ptx_oven_zone_stats_t;
+
+/**
+ * @brief Initialize zones and drive all burners off
+ * @param count Number of zones in use (clamped to 1..PTX_OVEN_MAX_ZONES)
+ */
+void ptx_oven_zones_init(uint8_t count);
+
+/**
+ * @brief Number of zones in use
+ */
+uint8_t ptx_oven_zones_count(void);
+
+/**
+ * @brief Give a zone its own configuration, or return it to the shared one
+ * @param zone Zone index
+ * @param config Caller-owned override (kept by reference, must outlive its
+ *        use), or NULL for the shared configuration
+ * @return false if zone is out of range or config fails ptx_oven_config_validate()
+ */
+bool ptx_oven_zones_set_override(uint8_t zone, const ptx_oven_config_t* config);
+
+/**
+ * @brief One control tick for every zone, then supervisor and outputs
+ */
+void ptx_oven_zones_update(void);
+
+/**
+ * @brief Update the shared door state (ISR safe)
+ * @param open true if door is open
+ */
+void ptx_oven_zones_set_door_state(bool open);
+
+/**
+ * @brief Reset ignition lockout in every zone
+ */
+void ptx_oven_zones_reset_ignition_lockout(void);
+
+/**
+ * @brief Whether the supervisor currently holds every zone off
+ */
+bool ptx_oven_zones_tripped(void);
+
+/**
+ * @brief Status of one zone
+ * @return Zone status, or NULL if zone is out of range
+ */
+const ptx_oven_status_t* ptx_oven_zones_get_status(uint8_t zone);
+
+/**
+ * @brief Step timing of one zone
+ * @return Zone stats, or NULL if zone is out of range
+ */
+const ptx_oven_zone_stats_t* ptx_oven_zones_get_stats(uint8_t zone);
+
+/**
+ * @brief Duration of the latest full tick (all zones, supervisor and outputs) in µs
+ */
+uint32_t ptx_oven_zones_get_tick_us(void);
+
+/**
+ * @brief Clear timing stats of every zone
+ */
+void ptx_oven_zones_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PTX_OVEN_ZONES_H */
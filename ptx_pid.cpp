@@ -0,0 +1,83 @@
+/**
+ * @file ptx_pid.cpp
+ * @brief Implementation of the PI/PID duty controller and burner windows
+ */
+#include "ptx_pid.h"
+
+/* Sample gaps longer than this restart the history (burner was shut down) */
+#define PTX_PID_MAX_GAP_MS (4U * PTX_PID_SAMPLE_MS)
+
+static float ptx_pid_clamp01(float v) {
+    if (v < 0.0f) return 0.0f;
+    if (v > 1.0f) return 1.0f;
+    return v;
+}
+
+void ptx_pid_init(ptx_pid_t* pid) {
+    pid->integral = 0.0f;
+    pid->prev_temp_c = 0.0f;
+    pid->duty = 0.0f;
+    pid->last_sample_ms = 0;
+    pid->primed = false;
+    pid->window_running = false;
+    pid->window_start_ms = 0;
+    pid->window_on_ms = 0;
+}
+
+float ptx_pid_update(ptx_pid_t* pid, uint32_t now_ms, float setpoint_c, float temp_c,
+                     float kp, float ki, float kd) {
+    uint32_t dt_ms = now_ms - pid->last_sample_ms;
+    if (pid->primed && dt_ms < PTX_PID_SAMPLE_MS) return pid->duty;
+
+    float error = setpoint_c - temp_c;
+    float p = kp * error;
+    float d = 0.0f;
+    float integral = pid->integral;
+
+    if (pid->primed && dt_ms <= PTX_PID_MAX_GAP_MS) {
+        float dt_s = (float)dt_ms * 0.001f;
+        d = -kd * (temp_c - pid->prev_temp_c) / dt_s;
+
+        /* Conditional integration: do not push further into saturation */
+        float candidate = integral + ki * error * dt_s;
+        float u = p + candidate + d;
+        if (!((u > 1.0f && error > 0.0f) || (u < 0.0f && error < 0.0f))) {
+            integral = candidate;
+        }
+        integral = ptx_pid_clamp01(integral);
+    }
+
+    pid->integral = integral;
+    pid->prev_temp_c = temp_c;
+    pid->last_sample_ms = now_ms;
+    pid->primed = true;
+    pid->duty = ptx_pid_clamp01(p + integral + d);
+    return pid->duty;
+}
+
+uint32_t ptx_pid_window_on_ms(float duty, uint32_t window_ms, uint32_t min_on_ms, uint32_t min_off_ms) {
+    uint32_t on_ms = (uint32_t)(ptx_pid_clamp01(duty) * (float)window_ms + 0.5f);
+    if (on_ms > window_ms) on_ms = window_ms;
+
+    /* Too short to finish an ignition: skip, or run the minimum (round to nearest) */
+    if (on_ms > 0 && on_ms < min_on_ms) {
+        on_ms = (2U * on_ms >= min_on_ms) ? min_on_ms : 0U;
+    }
+    /* Gap too short to purge: stay lit through it, or widen it */
+    uint32_t off_ms = window_ms - on_ms;
+    if (on_ms > 0 && off_ms > 0 && off_ms < min_off_ms) {
+        on_ms = (2U * off_ms >= min_off_ms && window_ms > min_off_ms) ? window_ms - min_off_ms : window_ms;
+    }
+    return on_ms;
+}
+
+bool ptx_pid_burner_demand(ptx_pid_t* pid, uint32_t now_ms, uint32_t window_ms,
+                           uint32_t min_on_ms, uint32_t min_off_ms) {
+    if (!pid->window_running || (now_ms - pid->window_start_ms) >= window_ms) {
+        pid->window_start_ms = pid->window_running ? pid->window_start_ms + window_ms : now_ms;
+        if ((now_ms - pid->window_start_ms) >= window_ms) pid->window_start_ms = now_ms;  /* fell behind */
+        pid->window_on_ms = ptx_pid_window_on_ms(pid->duty, window_ms, min_on_ms, min_off_ms);
+        pid->window_running = true;
+    }
+    return (now_ms - pid->window_start_ms) < pid->window_on_ms;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file ptx_pid.h
+ * @brief PI/PID temperature controller with time-proportioning burner windows
+ * @details The gas burner is on/off, so the controller output is a duty cycle
+ *          (0..1) turned into burner time inside a fixed window: the burner
+ *          runs for duty * window_ms at the start of each window. Windows
+ *          shorter than the minimum on-time are dropped or stretched, and an
+ *          off-gap shorter than the minimum off-time is dropped or widened, so
+ *          every lit window covers a full ignition and every relight follows a
+ *          full purge. At 100 % duty the burner stays lit across windows, so
+ *          it does not relight.
+ *
+ *          The integral term is clamped to the output range and frozen while
+ *          the output is saturated in the error's direction (anti-windup).
+ *          The derivative acts on the measurement, not the error, so setpoint
+ *          changes do not kick the output.
+ */
+#ifndef PTX_PID_H
+#define PTX_PID_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PTX_PID_SAMPLE_MS 1000U  /**< Controller update period */
+
+/**
+ * @brief Controller instance
+ * @note Members are private to ptx_pid.cpp; exposed only so that instances can
+ *       be embedded by value (e.g. in ptx_oven_ctx_t).
+ */
+typedef struct {
+    float    integral;         /**< Integral term, in duty units */
+    float    prev_temp_c;      /**< Measurement at the previous sample */
+    float    duty;             /**< Last output, 0..1 */
+    uint32_t last_sample_ms;
+    bool     primed;           /**< prev_temp_c / last_sample_ms are valid */
+    bool     window_running;
+    uint32_t window_start_ms;
+    uint32_t window_on_ms;     /**< Burner time of the current window */
+} ptx_pid_t;
+
+/**
+ * @brief Reset a controller (integral, history and window)
+ */
+void ptx_pid_init(ptx_pid_t* pid);
+
+/**
+ * @brief Run one controller sample if PTX_PID_SAMPLE_MS has elapsed
+ * @param pid Instance
+ * @param now_ms Current time
+ * @param setpoint_c Target temperature
+ * @param temp_c Measured temperature
+ * @param kp Proportional gain (duty per °C)
+ * @param ki Integral gain (duty per °C·s)
+ * @param kd Derivative gain (duty per °C/s); 0 for PI
+ * @return Current duty cycle, 0..1
+ * @note A gap of several sample periods (e.g. while the burner was shut down
+ *       by the door) restarts the sample history instead of integrating it.
+ */
+float ptx_pid_update(ptx_pid_t* pid, uint32_t now_ms, float setpoint_c, float temp_c,
+                     float kp, float ki, float kd);
+
+/**
+ * @brief Whether the burner should be lit now under the current duty
+ * @param pid Instance
+ * @param now_ms Current time
+ * @param window_ms Time-proportioning window
+ * @param min_on_ms Shortest burner run (ignition must complete)
+ * @param min_off_ms Shortest gap between runs (purge before relight)
+ * @return true while inside the on-part of the current window
+ */
+bool ptx_pid_burner_demand(ptx_pid_t* pid, uint32_t now_ms, uint32_t window_ms,
+                           uint32_t min_on_ms, uint32_t min_off_ms);
+
+/**
+ * @brief Burner time for one window after applying the minimum on/off times
+ * @param duty Duty cycle 0..1
+ * @param window_ms Window length
+ * @param min_on_ms Shortest burner run
+ * @param min_off_ms Shortest gap between runs
+ * @return Burner time in ms: 0, window_ms, or within [min_on_ms, window_ms - min_off_ms]
+ */
+uint32_t ptx_pid_window_on_ms(float duty, uint32_t window_ms, uint32_t min_on_ms, uint32_t min_off_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PTX_PID_H */
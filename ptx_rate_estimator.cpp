@@ -0,0 +1,50 @@
+/**
+ * @file ptx_rate_estimator.cpp
+ * @brief Implementation of the incremental least-squares slope
+ */
+#include "ptx_rate_estimator.h"
+
+/* Longer gaps (e.g. skipped ticks) restart the fit instead of spanning them */
+#define PTX_RATE_MAX_GAP_MS (8U * PTX_RATE_SAMPLE_MS)
+
+void ptx_rate_estimator_init(ptx_rate_estimator_t* est) {
+    est->s0 = 0.0f;
+    est->st = 0.0f;
+    est->stt = 0.0f;
+    est->sy = 0.0f;
+    est->sty = 0.0f;
+    est->slope = 0.0f;
+    est->last_ms = 0;
+    est->samples = 0;
+}
+
+float ptx_rate_estimator_update(ptx_rate_estimator_t* est, uint32_t now_ms, float value) {
+    uint32_t dt_ms = now_ms - est->last_ms;
+    if (est->samples > 0 && dt_ms < PTX_RATE_SAMPLE_MS) return est->slope;
+    if (est->samples > 0 && dt_ms > PTX_RATE_MAX_GAP_MS) ptx_rate_estimator_init(est);
+
+    if (est->samples > 0) {
+        /* Move the time origin to the new sample: t -> t - dt */
+        float dt = (float)dt_ms * 0.001f;
+        est->sty -= dt * est->sy;
+        est->stt -= dt * (2.0f * est->st - dt * est->s0);
+        est->st  -= dt * est->s0;
+
+        est->s0  *= PTX_RATE_DECAY;
+        est->st  *= PTX_RATE_DECAY;
+        est->stt *= PTX_RATE_DECAY;
+        est->sy  *= PTX_RATE_DECAY;
+        est->sty *= PTX_RATE_DECAY;
+    }
+    /* New point at t = 0 only adds to the weight and value sums */
+    est->s0 += 1.0f;
+    est->sy += value;
+    est->last_ms = now_ms;
+    if (est->samples < 0xFFU) est->samples++;
+
+    float det = est->s0 * est->stt - est->st * est->st;
+    if (est->samples >= 3 && det > 0.0f) {
+        est->slope = (est->s0 * est->sty - est->st * est->sy) / det;
+    }
+    return est->slope;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file ptx_rate_estimator.h
+ * @brief Incremental least-squares slope (rate of rise) of a sampled signal
+ * @details Fits a line to the recent samples by exponentially weighted least
+ *          squares. Only five running sums are kept; each sample shifts the
+ *          time origin to itself, decays the sums by PTX_RATE_DECAY and adds
+ *          the new point, so an update is a handful of multiply-adds and the
+ *          history never grows. Samples are decimated to PTX_RATE_SAMPLE_MS;
+ *          a gap of several sample periods restarts the fit.
+ */
+#ifndef PTX_RATE_ESTIMATOR_H
+#define PTX_RATE_ESTIMATOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Build options */
+#ifndef PTX_RATE_SAMPLE_MS
+#define PTX_RATE_SAMPLE_MS 250U  /* Fit sample period */
+#endif
+#ifndef PTX_RATE_DECAY
+#define PTX_RATE_DECAY 0.875f    /* Weight kept per sample (about 8 samples, 2 s, of memory) */
+#endif
+
+/**
+ * @brief Estimator state
+ * @note Members are private to ptx_rate_estimator.cpp.
+ */
+typedef struct {
+    float    s0;       /**< Sum of weights */
+    float    st;       /**< Sum of w*t (t in s, relative to the last sample) */
+    float    stt;      /**< Sum of w*t^2 */
+    float    sy;       /**< Sum of w*y */
+    float    sty;      /**< Sum of w*t*y */
+    float    slope;    /**< Last fitted slope, units of y per second */
+    uint32_t last_ms;
+    uint8_t  samples;  /**< Samples since the fit restarted (saturates) */
+} ptx_rate_estimator_t;
+
+/**
+ * @brief Reset the fit
+ */
+void ptx_rate_estimator_init(ptx_rate_estimator_t* est);
+
+/**
+ * @brief Add a sample if PTX_RATE_SAMPLE_MS has elapsed since the last one
+ * @param est Estimator
+ * @param now_ms Current time
+ * @param value Signal value
+ * @return Current slope in value units per second (0 until 3 samples are in)
+ */
+float ptx_rate_estimator_update(ptx_rate_estimator_t* est, uint32_t now_ms, float value);
+
+/**
+ * @brief Last fitted slope in value units per second
+ */
+static inline float ptx_rate_estimator_slope(const ptx_rate_estimator_t* est) { return est->slope; }
+
+/**
+ * @brief Samples in the current fit (saturates at 255)
+ */
+static inline uint8_t ptx_rate_estimator_samples(const ptx_rate_estimator_t* est) { return est->samples; }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PTX_RATE_ESTIMATOR_H */
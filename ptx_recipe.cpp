@@ -0,0 +1,151 @@
+/**
+ * @file ptx_recipe.cpp
+ * @brief Built-in recipe table and the setpoint executor
+ */
+#include "ptx_recipe.h"
+#include "ptx_oven_config.h"
+#include <string.h>
+
+#if defined(__AVR__)
+#include <avr/pgmspace.h>
+#else
+#define PROGMEM
+#define memcpy_P memcpy
+#endif
+
+/* Longest tick the ramp integrates; a stalled loop must not jump the setpoint */
+#define PTX_RECIPE_MAX_STEP_MS 1000U
+
+/* Ramp step in Q32 ratio per ms for 0.1 °C/min: the sensor map spans 80 % of
+   vref over 310 °C. Used once per segment. */
+#define PTX_RECIPE_Q32_PER_MS_PER_DC_MIN (0.1f / 60000.0f * 0.80f / 310.0f * 4294967296.0f)
+
+/* Segments of all built-in recipes, back to back */
+static const ptx_recipe_segment_t pti_recipe_segments[] PROGMEM = {
+    /* 1: cookies - preheat to 200 °C, hold 10 min; down to 170 °C at 10 °C/min, hold 12 min */
+    { 2000,   0,  600 },
+    { 1700, 100,  720 },
+    /* 2: bread - preheat to 230 °C, hold 10 min; down to 200 °C at 5 °C/min, hold 25 min */
+    { 2300,   0,  600 },
+    { 2000,  50, 1500 },
+    /* 3: slow roast - up to 160 °C at 4 °C/min, hold 1 h; down to 120 °C at 2 °C/min, hold 90 min */
+    { 1600,  40, 3600 },
+    { 1200,  20, 5400 },
+};
+
+typedef struct {
+    uint8_t first;  /* Index in pti_recipe_segments */
+    uint8_t count;
+} pti_recipe_entry_t;
+
+/* Recipe id - 1 -> its segments */
+static const pti_recipe_entry_t pti_recipes[] PROGMEM = {
+    { 0, 2 },
+    { 2, 2 },
+    { 4, 2 },
+};
+
+#define PTX_RECIPE_COUNT ((uint8_t)(sizeof(pti_recipes) / sizeof(pti_recipes[0])))
+
+static_assert(sizeof(ptx_recipe_segment_t) == 6, "segment layout is stored in flash");
+
+static bool ptx_recipe_entry(uint8_t recipe_id, pti_recipe_entry_t* e) {
+    if (recipe_id == 0 || recipe_id > PTX_RECIPE_COUNT) return false;
+    memcpy_P(e, &pti_recipes[recipe_id - 1], sizeof(*e));
+    return true;
+}
+
+/* Copy the current segment out of flash and derive its fixed-point form */
+static void ptx_recipe_load_segment(ptx_recipe_t* r) {
+    ptx_recipe_segment_t seg;
+    memcpy_P(&seg, &pti_recipe_segments[r->first + r->segment], sizeof(seg));
+    r->target_q32 = ptx_oven_temp_to_ratio_q16((float)seg.target_dc * 0.1f) << 16;
+    r->step_q32_per_ms = (uint32_t)((float)seg.ramp_dc_per_min * PTX_RECIPE_Q32_PER_MS_PER_DC_MIN + 0.5f);
+    r->hold_ms = (uint32_t)seg.hold_s * 1000UL;
+    r->phase = PTX_RECIPE_PHASE_RAMP;
+}
+
+uint8_t ptx_recipe_count(void) {
+    return PTX_RECIPE_COUNT;
+}
+
+bool ptx_recipe_get_segment(uint8_t recipe_id, uint8_t index, ptx_recipe_segment_t* out) {
+    pti_recipe_entry_t e;
+    if (!ptx_recipe_entry(recipe_id, &e) || index >= e.count) return false;
+    memcpy_P(out, &pti_recipe_segments[e.first + index], sizeof(*out));
+    return true;
+}
+
+void ptx_recipe_init(ptx_recipe_t* r) {
+    memset(r, 0, sizeof(*r));
+    r->state = PTX_RECIPE_IDLE;
+}
+
+bool ptx_recipe_start(ptx_recipe_t* r, uint8_t recipe_id) {
+    pti_recipe_entry_t e;
+    if (!ptx_recipe_entry(recipe_id, &e)) return false;
+    ptx_recipe_init(r);
+    r->state = PTX_RECIPE_RUNNING;
+    r->recipe_id = recipe_id;
+    r->first = e.first;
+    r->segments = e.count;
+    ptx_recipe_load_segment(r);
+    /* Reported until the first update, which restarts the ramp from the oven */
+    r->setpoint_q32 = r->target_q32;
+    return true;
+}
+
+void ptx_recipe_abort(ptx_recipe_t* r) {
+    if (r->state == PTX_RECIPE_RUNNING) r->state = PTX_RECIPE_ABORTED;
+}
+
+void ptx_recipe_update(ptx_recipe_t* r, uint32_t now_ms, uint32_t ratio_q16, uint32_t half_band_q16) {
+    if (r->state != PTX_RECIPE_RUNNING) return;
+    if (!r->sampled) {
+        /* Ramp from where the oven is */
+        r->sampled = true;
+        r->last_ms = now_ms;
+        r->setpoint_q32 = ratio_q16 << 16;
+    }
+    uint32_t dt_ms = now_ms - r->last_ms;
+    r->last_ms = now_ms;
+    if (dt_ms > PTX_RECIPE_MAX_STEP_MS) dt_ms = PTX_RECIPE_MAX_STEP_MS;
+
+    if (r->phase == PTX_RECIPE_PHASE_RAMP) {
+        uint32_t move = (r->step_q32_per_ms == 0) ? UINT32_MAX : r->step_q32_per_ms * dt_ms;
+        if (r->setpoint_q32 < r->target_q32) {
+            r->setpoint_q32 = (r->target_q32 - r->setpoint_q32 > move) ? r->setpoint_q32 + move : r->target_q32;
+        } else {
+            r->setpoint_q32 = (r->setpoint_q32 - r->target_q32 > move) ? r->setpoint_q32 - move : r->target_q32;
+        }
+        if (r->setpoint_q32 == r->target_q32) r->phase = PTX_RECIPE_PHASE_SOAK;
+    }
+    if (r->phase == PTX_RECIPE_PHASE_SOAK) {
+        /* The hold counts from when the oven itself reaches the band */
+        uint32_t target_q16 = r->target_q32 >> 16;
+        if (ratio_q16 + half_band_q16 >= target_q16 && ratio_q16 <= target_q16 + half_band_q16) {
+            r->phase = PTX_RECIPE_PHASE_HOLD;
+            r->hold_start_ms = now_ms;
+        }
+    }
+    if (r->phase == PTX_RECIPE_PHASE_HOLD && (now_ms - r->hold_start_ms) >= r->hold_ms) {
+        if (r->segment + 1U < r->segments) {
+            r->segment++;
+            ptx_recipe_load_segment(r);
+        } else {
+            r->state = PTX_RECIPE_DONE;
+        }
+    }
+}
+
+float ptx_recipe_setpoint_c(const ptx_recipe_t* r) {
+    /* Inverse of the sensor map; the scale is a constant, so no division at run time */
+    return ((float)ptx_recipe_setpoint_q16(r) - 0.10f * (float)PTX_RATIO_Q16_ONE) *
+           (310.0f / (0.80f * (float)PTX_RATIO_Q16_ONE)) - 10.0f;
+}
+
+uint32_t ptx_recipe_hold_left_ms(const ptx_recipe_t* r, uint32_t now_ms) {
+    if (r->state != PTX_RECIPE_RUNNING || r->phase != PTX_RECIPE_PHASE_HOLD) return 0;
+    uint32_t held = now_ms - r->hold_start_ms;
+    return (held < r->hold_ms) ? r->hold_ms - held : 0;
+}
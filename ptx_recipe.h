@@ -0,0 +1,146 @@
+/**
+ * @file ptx_recipe.h
+ * @brief Staged time-temperature recipes and their setpoint executor
+ * @details A recipe is a short list of segments kept in flash (PROGMEM on AVR):
+ *          ramp the setpoint toward a target at a given rate, wait until the
+ *          oven is within the hysteresis band of it, then hold for a time. The
+ *          executor copies one segment into RAM when it starts, so flash is
+ *          read once per segment, not per tick.
+ *
+ *          The setpoint is kept as a signal ratio (Q32, i.e. Q16 ratio with 16
+ *          fraction bits), the unit of the control thresholds. The sensor map
+ *          is linear, so a constant ramp in degrees is a constant ratio step
+ *          per millisecond; a tick is one multiply and add, with no float
+ *          math. A recipe starts ramping from the oven's current temperature.
+ *
+ *          When the last hold ends the recipe is DONE and the controller goes
+ *          back to the configured temp_target_c.
+ */
+#ifndef PTX_RECIPE_H
+#define PTX_RECIPE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief One segment as stored in flash (6 bytes)
+ */
+typedef struct {
+    int16_t  target_dc;        /**< Segment target, 0.1 °C */
+    uint16_t ramp_dc_per_min;  /**< Setpoint ramp toward the target, 0.1 °C/min; 0 = step */
+    uint16_t hold_s;           /**< Hold once the oven is in band around the target */
+} ptx_recipe_segment_t;
+
+/**
+ * @brief Executor state
+ */
+typedef enum {
+    PTX_RECIPE_IDLE = 0,   /**< Never started */
+    PTX_RECIPE_RUNNING,    /**< Setpoint follows the recipe */
+    PTX_RECIPE_DONE,       /**< Last hold complete */
+    PTX_RECIPE_ABORTED     /**< Stopped, or ended by a lockout */
+} ptx_recipe_state_t;
+
+/**
+ * @brief Phase of the current segment
+ */
+typedef enum {
+    PTX_RECIPE_PHASE_RAMP = 0,  /**< Setpoint moving toward the target */
+    PTX_RECIPE_PHASE_SOAK,      /**< Setpoint at target, oven not in band yet */
+    PTX_RECIPE_PHASE_HOLD       /**< Hold timer running */
+} ptx_recipe_phase_t;
+
+/**
+ * @brief Executor state of one oven
+ * @note Members other than state, recipe_id, segment, segments and phase are
+ *       private to ptx_recipe.cpp.
+ */
+typedef struct {
+    uint8_t  state;            /**< ptx_recipe_state_t */
+    uint8_t  recipe_id;        /**< 1..ptx_recipe_count() */
+    uint8_t  segment;          /**< Current segment, 0-based */
+    uint8_t  segments;         /**< Segments in the recipe */
+    uint8_t  phase;            /**< ptx_recipe_phase_t */
+    uint8_t  first;            /**< Flash index of the recipe's first segment */
+    bool     sampled;          /**< Start setpoint and last_ms are set (first update seen) */
+    uint32_t setpoint_q32;     /**< Effective setpoint, signal ratio Q32 */
+    uint32_t target_q32;       /**< Segment target, signal ratio Q32 */
+    uint32_t step_q32_per_ms;  /**< Ramp step; 0 = step change */
+    uint32_t hold_ms;
+    uint32_t hold_start_ms;
+    uint32_t last_ms;
+} ptx_recipe_t;
+
+/**
+ * @brief Number of built-in recipes (ids 1..count)
+ */
+uint8_t ptx_recipe_count(void);
+
+/**
+ * @brief Read one segment of a built-in recipe from flash
+ * @param recipe_id 1..ptx_recipe_count()
+ * @param index Segment index, 0-based
+ * @param out Segment copy
+ * @return false if the recipe or segment does not exist
+ */
+bool ptx_recipe_get_segment(uint8_t recipe_id, uint8_t index, ptx_recipe_segment_t* out);
+
+/**
+ * @brief Reset to PTX_RECIPE_IDLE
+ */
+void ptx_recipe_init(ptx_recipe_t* r);
+
+/**
+ * @brief Start (or restart) a recipe; the ramp begins at the next update
+ * @details Until that update the setpoint reads as the first segment's target.
+ * @param r Executor
+ * @param recipe_id 1..ptx_recipe_count()
+ * @return false (and no change) for an unknown id
+ */
+bool ptx_recipe_start(ptx_recipe_t* r, uint8_t recipe_id);
+
+/**
+ * @brief Stop a running recipe (PTX_RECIPE_ABORTED)
+ */
+void ptx_recipe_abort(ptx_recipe_t* r);
+
+/**
+ * @brief Advance the setpoint by one control tick
+ * @param r Executor
+ * @param now_ms Current time
+ * @param ratio_q16 Measured signal ratio of this tick
+ * @param half_band_q16 Hysteresis half-band as a ratio; the hold starts once
+ *        the measurement is within it of the target
+ */
+void ptx_recipe_update(ptx_recipe_t* r, uint32_t now_ms, uint32_t ratio_q16, uint32_t half_band_q16);
+
+/**
+ * @brief Whether the recipe drives the setpoint
+ */
+static inline bool ptx_recipe_running(const ptx_recipe_t* r) { return r->state == PTX_RECIPE_RUNNING; }
+
+/**
+ * @brief Effective setpoint as a Q16 signal ratio
+ */
+static inline uint32_t ptx_recipe_setpoint_q16(const ptx_recipe_t* r) { return r->setpoint_q32 >> 16; }
+
+/**
+ * @brief Effective setpoint in °C (for PI/PID and status)
+ */
+float ptx_recipe_setpoint_c(const ptx_recipe_t* r);
+
+/**
+ * @brief Time left in the current hold
+ * @return Remaining hold in ms, 0 outside PTX_RECIPE_PHASE_HOLD
+ */
+uint32_t ptx_recipe_hold_left_ms(const ptx_recipe_t* r, uint32_t now_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PTX_RECIPE_H */
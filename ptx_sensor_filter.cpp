@@ -6,18 +6,8 @@
 #include "api.h"
 #include <string.h>
 
-#define PTX_FILTER_MAX_WINDOW 10
-
-/* Filter state */
-static struct {
-    uint8_t window_size;
-    
-    /* History buffers for median calculation */
-    uint16_t vref_history[PTX_FILTER_MAX_WINDOW];
-    uint16_t signal_history[PTX_FILTER_MAX_WINDOW];
-    uint8_t history_count;  /* number of valid samples in buffer */
-    uint8_t history_index;  /* circular buffer write position */
-} pti_filter_state;
+/* Default instance behind the single-sensor API */
+static ptx_sensor_filter_t pti_filter_state;
 
 /* compute median of buffer (simple bubble sort for small arrays) */
 static uint16_t compute_median(const uint16_t* buffer, uint8_t count) {
@@ -43,37 +33,37 @@ static uint16_t compute_median(const uint16_t* buffer, uint8_t count) {
     }
 }
 
-void ptx_sensor_filter_init(uint8_t window_size) {
-    pti_filter_state.window_size = (window_size > PTX_FILTER_MAX_WINDOW) ? PTX_FILTER_MAX_WINDOW : window_size;
-    if (pti_filter_state.window_size < 3) pti_filter_state.window_size = 3; // minimum 3 for median
+void ptx_sensor_filter_ctx_init(ptx_sensor_filter_t* filter, uint8_t window_size) {
+    filter->window_size = (window_size > PTX_FILTER_MAX_WINDOW) ? PTX_FILTER_MAX_WINDOW : window_size;
+    if (filter->window_size < 3) filter->window_size = 3; // minimum 3 for median
     
-    ptx_sensor_filter_reset();
+    ptx_sensor_filter_ctx_reset(filter);
 }
 
-void ptx_sensor_filter_reset(void) {
-    pti_filter_state.history_count = 0;
-    pti_filter_state.history_index = 0;
-    memset(pti_filter_state.vref_history, 0, sizeof(pti_filter_state.vref_history));
-    memset(pti_filter_state.signal_history, 0, sizeof(pti_filter_state.signal_history));
+void ptx_sensor_filter_ctx_reset(ptx_sensor_filter_t* filter) {
+    filter->history_count = 0;
+    filter->history_index = 0;
+    memset(filter->vref_history, 0, sizeof(filter->vref_history));
+    memset(filter->signal_history, 0, sizeof(filter->signal_history));
 }
 
-ptx_sensor_reading_t ptx_sensor_filter_update(uint16_t raw_vref_mv, 
-                                                uint16_t raw_signal_mv) {
+ptx_sensor_reading_t ptx_sensor_filter_ctx_update(ptx_sensor_filter_t* filter,
+                                                  uint16_t raw_vref_mv, uint16_t raw_signal_mv) {
     ptx_sensor_reading_t result = {0};
     
     /* Add to circular buffer */
-    pti_filter_state.vref_history[pti_filter_state.history_index] = raw_vref_mv;
-    pti_filter_state.signal_history[pti_filter_state.history_index] = raw_signal_mv;
-    pti_filter_state.history_index = (pti_filter_state.history_index + 1) % pti_filter_state.window_size;
+    filter->vref_history[filter->history_index] = raw_vref_mv;
+    filter->signal_history[filter->history_index] = raw_signal_mv;
+    filter->history_index = (filter->history_index + 1) % filter->window_size;
     
-    if (pti_filter_state.history_count < pti_filter_state.window_size) {
-        pti_filter_state.history_count++;
+    if (filter->history_count < filter->window_size) {
+        filter->history_count++;
     }
     
     /* Need full window before filter is valid */
-    if (pti_filter_state.history_count >= pti_filter_state.window_size) {
-        result.vref_mv = compute_median(pti_filter_state.vref_history, pti_filter_state.window_size);
-        result.signal_mv = compute_median(pti_filter_state.signal_history, pti_filter_state.window_size);
+    if (filter->history_count >= filter->window_size) {
+        result.vref_mv = compute_median(filter->vref_history, filter->window_size);
+        result.signal_mv = compute_median(filter->signal_history, filter->window_size);
         result.valid = true;
     } else {
         /* Not enough samples yet; return raw */
@@ -85,6 +75,23 @@ ptx_sensor_reading_t ptx_sensor_filter_update(uint16_t raw_vref_mv,
     return result;
 }
 
+uint8_t ptx_sensor_filter_ctx_get_window_size(const ptx_sensor_filter_t* filter) {
+    return filter->window_size;
+}
+
+void ptx_sensor_filter_init(uint8_t window_size) {
+    ptx_sensor_filter_ctx_init(&pti_filter_state, window_size);
+}
+
+void ptx_sensor_filter_reset(void) {
+    ptx_sensor_filter_ctx_reset(&pti_filter_state);
+}
+
+ptx_sensor_reading_t ptx_sensor_filter_update(uint16_t raw_vref_mv, 
+                                                uint16_t raw_signal_mv) {
+    return ptx_sensor_filter_ctx_update(&pti_filter_state, raw_vref_mv, raw_signal_mv);
+}
+
 ptx_sensor_reading_t ptx_sensor_filter_read_and_update(void) {
     /* Read raw sensor values from hardware */
     uint16_t raw_vref_mv   = read_voltage(TEMPERATURE_SENSOR_REFERENCE);
@@ -95,5 +102,5 @@ ptx_sensor_reading_t ptx_sensor_filter_read_and_update(void) {
 }
 
 uint8_t ptx_sensor_filter_get_window_size(void) {
-    return pti_filter_state.window_size;
+    return ptx_sensor_filter_ctx_get_window_size(&pti_filter_state);
 }
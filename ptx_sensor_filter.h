@@ -23,6 +23,51 @@ typedef struct {
     bool     valid;             /**< True if filter has enough samples */
 } ptx_sensor_reading_t;
 
+#define PTX_FILTER_MAX_WINDOW 10  /**< Largest supported median window */
+
+/**
+ * @brief Filter instance (one per sensor pair)
+ * @note Members are private to ptx_sensor_filter.cpp; exposed only so that
+ *       instances can be embedded by value (e.g. in ptx_oven_ctx_t).
+ */
+typedef struct {
+    uint8_t  window_size;
+    uint16_t vref_history[PTX_FILTER_MAX_WINDOW];
+    uint16_t signal_history[PTX_FILTER_MAX_WINDOW];
+    uint8_t  history_count;  /**< Number of valid samples in buffer */
+    uint8_t  history_index;  /**< Circular buffer write position */
+} ptx_sensor_filter_t;
+
+/**
+ * @brief Initialize a filter instance
+ * @param filter Instance to initialize
+ * @param window_size Number of samples for median calculation (3-10, odd preferred)
+ */
+void ptx_sensor_filter_ctx_init(ptx_sensor_filter_t* filter, uint8_t window_size);
+
+/**
+ * @brief Reset a filter instance (clear history)
+ * @param filter Instance to reset
+ */
+void ptx_sensor_filter_ctx_reset(ptx_sensor_filter_t* filter);
+
+/**
+ * @brief Add one raw sample to a filter instance and return the filtered reading
+ * @param filter Instance to update
+ * @param raw_vref_mv Raw reference voltage (mV)
+ * @param raw_signal_mv Raw signal voltage (mV)
+ * @return Filtered reading (raw values until the window is full)
+ */
+ptx_sensor_reading_t ptx_sensor_filter_ctx_update(ptx_sensor_filter_t* filter,
+                                                  uint16_t raw_vref_mv, uint16_t raw_signal_mv);
+
+/**
+ * @brief Get the window size of a filter instance
+ * @param filter Instance to query
+ * @return Median filter window size
+ */
+uint8_t ptx_sensor_filter_ctx_get_window_size(const ptx_sensor_filter_t* filter);
+
 /**
  * @brief Initialize median sensor filter
  * @param window_size Number of samples for median calculation (3-10, odd preferred)
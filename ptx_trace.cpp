@@ -0,0 +1,220 @@
+/**
+ * @file ptx_trace.cpp
+ * @brief Implementation of the raw-input trace recorder and decoder
+ */
+#include "ptx_trace.h"
+#include <stddef.h>
+
+#define PTX_TRACE_DOOR_QUEUE 4U
+
+static_assert(PTX_TRACE_MAX_RECORD <= PTX_TRACE_CHUNK_SIZE, "a record must fit in one chunk");
+
+/* Recorder state */
+static ptx_trace_sink_t pti_sink = NULL;
+static uint8_t  pti_buf[PTX_TRACE_CHUNK_SIZE];
+static uint8_t  pti_buf_len = 0;
+static bool     pti_need_keyframe = true;
+static uint8_t  pti_ticks_since_keyframe = 0;
+static uint32_t pti_last_ms = 0;
+static uint16_t pti_last_vref_mv = 0;
+static uint16_t pti_last_signal_mv = 0;
+
+/* Door edges noted from the ISR, drained by the next tick */
+static volatile uint8_t pti_door_head = 0;
+static volatile uint8_t pti_door_tail = 0;
+static volatile int8_t  pti_door_noted = -1;  /* last state queued; -1 = none since start */
+static uint32_t pti_door_ms[PTX_TRACE_DOOR_QUEUE];
+static bool     pti_door_open[PTX_TRACE_DOOR_QUEUE];
+
+static uint8_t ptx_put_varint(uint8_t* p, uint32_t v) {
+    uint8_t n = 0;
+    while (v >= 0x80U) {
+        p[n++] = (uint8_t)(v | 0x80U);
+        v >>= 7;
+    }
+    p[n++] = (uint8_t)v;
+    return n;
+}
+
+static uint32_t ptx_zigzag(int32_t v) {
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static int32_t ptx_unzigzag(uint32_t v) {
+    return (int32_t)(v >> 1) ^ -(int32_t)(v & 1U);
+}
+
+/* Records never straddle two sink calls, so each chunk decodes on its own */
+static void ptx_trace_emit(const uint8_t* rec, uint8_t len) {
+    if (pti_buf_len + len > PTX_TRACE_CHUNK_SIZE) {
+        ptx_trace_flush();
+    }
+    for (uint8_t i = 0; i < len; i++) {
+        pti_buf[pti_buf_len++] = rec[i];
+    }
+}
+
+void ptx_trace_start(ptx_trace_sink_t sink) {
+    static const uint8_t header[PTX_TRACE_HEADER_SIZE] = { 'P', 'T', 'R', PTX_TRACE_VERSION, 0, 0 };
+
+    pti_sink = NULL;
+    pti_buf_len = 0;
+    pti_need_keyframe = true;
+    pti_ticks_since_keyframe = 0;
+    pti_door_tail = pti_door_head;
+    pti_door_noted = -1;
+    pti_sink = sink;
+    ptx_trace_emit(header, PTX_TRACE_HEADER_SIZE);
+}
+
+void ptx_trace_stop(void) {
+    ptx_trace_flush();
+    pti_sink = NULL;
+}
+
+bool ptx_trace_is_recording(void) {
+    return pti_sink != NULL;
+}
+
+void ptx_trace_note_door(uint32_t now_ms, bool open) {
+    if (pti_sink == NULL || pti_door_noted == (open ? 1 : 0)) return;
+    pti_door_noted = open ? 1 : 0;
+    uint8_t next = (uint8_t)((pti_door_head + 1U) % PTX_TRACE_DOOR_QUEUE);
+    if (next == pti_door_tail) {
+        /* Queue full (bouncing switch): overwrite the newest edge with the latest state */
+        next = pti_door_head;
+        pti_door_head = (uint8_t)((pti_door_head + PTX_TRACE_DOOR_QUEUE - 1U) % PTX_TRACE_DOOR_QUEUE);
+    }
+    pti_door_ms[pti_door_head] = now_ms;
+    pti_door_open[pti_door_head] = open;
+    pti_door_head = next;
+}
+
+void ptx_trace_record_tick(uint32_t now_ms, uint16_t vref_mv, uint16_t signal_mv) {
+    if (pti_sink == NULL) return;
+    uint8_t rec[PTX_TRACE_MAX_RECORD];
+    uint8_t n;
+
+    /* Door edges go before the tick that first sees them. Deltas need a keyframe,
+       so an edge between ptx_trace_start() and the first tick follows that tick. */
+    while (!pti_need_keyframe && pti_door_tail != pti_door_head) {
+        uint8_t i = pti_door_tail;
+        uint32_t door_ms = pti_door_ms[i];
+        if ((int32_t)(door_ms - pti_last_ms) < 0) door_ms = pti_last_ms;
+        n = 0;
+        rec[n++] = PTX_TRACE_TAG_DOOR;
+        n += ptx_put_varint(&rec[n], door_ms - pti_last_ms);
+        rec[n++] = pti_door_open[i] ? 1U : 0U;
+        ptx_trace_emit(rec, n);
+        pti_last_ms = door_ms;
+        pti_door_tail = (uint8_t)((i + 1U) % PTX_TRACE_DOOR_QUEUE);
+    }
+
+    n = 0;
+    if (pti_need_keyframe || pti_ticks_since_keyframe >= PTX_TRACE_KEYFRAME_INTERVAL) {
+        rec[n++] = PTX_TRACE_TAG_KEYFRAME;
+        n += ptx_put_varint(&rec[n], now_ms);
+        n += ptx_put_varint(&rec[n], vref_mv);
+        n += ptx_put_varint(&rec[n], signal_mv);
+        pti_need_keyframe = false;
+        pti_ticks_since_keyframe = 0;
+    } else {
+        rec[n++] = PTX_TRACE_TAG_TICK;
+        n += ptx_put_varint(&rec[n], now_ms - pti_last_ms);
+        n += ptx_put_varint(&rec[n], ptx_zigzag((int32_t)vref_mv - (int32_t)pti_last_vref_mv));
+        n += ptx_put_varint(&rec[n], ptx_zigzag((int32_t)signal_mv - (int32_t)pti_last_signal_mv));
+        pti_ticks_since_keyframe++;
+    }
+    ptx_trace_emit(rec, n);
+
+    pti_last_ms = now_ms;
+    pti_last_vref_mv = vref_mv;
+    pti_last_signal_mv = signal_mv;
+}
+
+void ptx_trace_flush(void) {
+    if (pti_sink != NULL && pti_buf_len > 0) {
+        pti_sink(pti_buf, pti_buf_len);
+    }
+    pti_buf_len = 0;
+}
+
+/* Decoder */
+static bool ptx_get_varint(ptx_trace_reader_t* r, uint32_t* out) {
+    uint32_t v = 0;
+    for (uint8_t shift = 0; shift < 35; shift += 7) {
+        if (r->pos >= r->length) return false;
+        uint8_t b = r->data[r->pos++];
+        v |= (uint32_t)(b & 0x7FU) << shift;
+        if ((b & 0x80U) == 0) {
+            *out = v;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ptx_trace_reader_init(ptx_trace_reader_t* reader, const uint8_t* data, size_t length) {
+    reader->data = data;
+    reader->length = length;
+    reader->pos = PTX_TRACE_HEADER_SIZE;
+    reader->last_ms = 0;
+    reader->last_vref_mv = 0;
+    reader->last_signal_mv = 0;
+    reader->synced = false;
+    return length >= PTX_TRACE_HEADER_SIZE && data[0] == 'P' && data[1] == 'T' && data[2] == 'R' &&
+           data[3] == PTX_TRACE_VERSION;
+}
+
+ptx_trace_read_result_t ptx_trace_read_next(ptx_trace_reader_t* reader, ptx_trace_event_t* event) {
+    size_t start = reader->pos;
+    if (start >= reader->length) return PTX_TRACE_READ_END;
+
+    uint8_t tag = reader->data[reader->pos++];
+    uint32_t a, b, c;
+    bool complete;
+
+    switch (tag) {
+        case PTX_TRACE_TAG_KEYFRAME:
+            complete = ptx_get_varint(reader, &a) && ptx_get_varint(reader, &b) && ptx_get_varint(reader, &c);
+            if (!complete) break;
+            reader->last_ms = a;
+            reader->last_vref_mv = (uint16_t)b;
+            reader->last_signal_mv = (uint16_t)c;
+            reader->synced = true;
+            break;
+
+        case PTX_TRACE_TAG_TICK:
+            if (!reader->synced) return PTX_TRACE_READ_CORRUPT;
+            complete = ptx_get_varint(reader, &a) && ptx_get_varint(reader, &b) && ptx_get_varint(reader, &c);
+            if (!complete) break;
+            reader->last_ms += a;
+            reader->last_vref_mv = (uint16_t)(reader->last_vref_mv + ptx_unzigzag(b));
+            reader->last_signal_mv = (uint16_t)(reader->last_signal_mv + ptx_unzigzag(c));
+            break;
+
+        case PTX_TRACE_TAG_DOOR:
+            if (!reader->synced) return PTX_TRACE_READ_CORRUPT;
+            complete = ptx_get_varint(reader, &a) && reader->pos < reader->length;
+            if (!complete) break;
+            reader->last_ms += a;
+            event->door_open = reader->data[reader->pos++] != 0;
+            break;
+
+        default:
+            reader->pos = start;
+            return PTX_TRACE_READ_CORRUPT;
+    }
+
+    if (!complete) {
+        reader->pos = start;  /* truncated record, e.g. capture cut mid-chunk */
+        return PTX_TRACE_READ_END;
+    }
+    event->tag = tag;
+    event->time_ms = reader->last_ms;
+    if (tag != PTX_TRACE_TAG_DOOR) {
+        event->vref_mv = reader->last_vref_mv;
+        event->signal_mv = reader->last_signal_mv;
+    }
+    return PTX_TRACE_READ_OK;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file ptx_trace.h
+ * @brief Compact binary trace of raw control-loop inputs (record and decode)
+ * @details A trace captures everything the controller reads: the raw
+ *          read_voltage() values and millis() timestamp of each tick, and door
+ *          edges. Replaying it through ptx_oven_control_update() reproduces the
+ *          run exactly (see tests/replay).
+ *
+ *          Layout: 6-byte header "PTR" version 0 0, then records:
+ *          - TICK     0x01 varint(dt_ms) zigzag(d_vref_mv) zigzag(d_signal_mv)
+ *          - DOOR     0x02 varint(dt_ms) open(u8)
+ *          - KEYFRAME 0x03 varint(time_ms) varint(vref_mv) varint(signal_mv)
+ *          Deltas are against the previous record. A keyframe is a tick with
+ *          absolute values; one starts the trace and one follows every
+ *          PTX_TRACE_KEYFRAME_INTERVAL ticks so readers can resynchronize and seek.
+ *          A steady 50 ms tick costs 4 bytes.
+ */
+#ifndef PTX_TRACE_H
+#define PTX_TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Build options */
+#ifndef PTX_TRACE_RECORD_ENABLED
+#define PTX_TRACE_RECORD_ENABLED 1  /* TRACE_CONTROL command can stream a trace over serial */
+#endif
+
+#define PTX_TRACE_VERSION            1U
+#define PTX_TRACE_HEADER_SIZE        6U
+#define PTX_TRACE_KEYFRAME_INTERVAL  64U   /**< Ticks between keyframes */
+#define PTX_TRACE_CHUNK_SIZE         24U   /**< Most bytes per sink call (fits one command frame) */
+#define PTX_TRACE_MAX_RECORD         16U   /**< Longest encoded record */
+
+#define PTX_TRACE_TAG_TICK     0x01U
+#define PTX_TRACE_TAG_DOOR     0x02U
+#define PTX_TRACE_TAG_KEYFRAME 0x03U
+
+/**
+ * @brief Receives encoded trace bytes (called from the control loop, never from an ISR)
+ */
+typedef void (*ptx_trace_sink_t)(const uint8_t* data, uint8_t length);
+
+/**
+ * @brief Start a new trace (header + keyframe on the next tick)
+ * @param sink Destination of the encoded bytes
+ */
+void ptx_trace_start(ptx_trace_sink_t sink);
+
+/**
+ * @brief Flush buffered bytes and stop recording
+ */
+void ptx_trace_stop(void);
+
+/**
+ * @brief Whether a trace is being recorded
+ */
+bool ptx_trace_is_recording(void);
+
+/**
+ * @brief Note a door edge (ISR safe); written before the next tick record
+ * @details Repeated calls with an unchanged state are ignored, so callers that
+ *          refresh the door state every tick (zone supervisor) record edges only.
+ * @param now_ms Time of the edge
+ * @param open New door state
+ */
+void ptx_trace_note_door(uint32_t now_ms, bool open);
+
+/**
+ * @brief Record the raw inputs of one control tick (no-op when not recording)
+ */
+void ptx_trace_record_tick(uint32_t now_ms, uint16_t vref_mv, uint16_t signal_mv);
+
+/**
+ * @brief Pass buffered bytes to the sink
+ */
+void ptx_trace_flush(void);
+
+/**
+ * @brief Decoded trace record
+ */
+typedef struct {
+    uint8_t  tag;        /**< PTX_TRACE_TAG_* (a keyframe is also a tick) */
+    uint32_t time_ms;
+    uint16_t vref_mv;    /**< Tick and keyframe only */
+    uint16_t signal_mv;  /**< Tick and keyframe only */
+    bool     door_open;  /**< Door only */
+} ptx_trace_event_t;
+
+/**
+ * @brief Result of ptx_trace_read_next()
+ */
+typedef enum {
+    PTX_TRACE_READ_OK = 0,
+    PTX_TRACE_READ_END,      /**< No more complete records */
+    PTX_TRACE_READ_CORRUPT   /**< Unknown tag or record before the first keyframe */
+} ptx_trace_read_result_t;
+
+/**
+ * @brief Sequential decoder over a trace held in memory
+ */
+typedef struct {
+    const uint8_t* data;
+    size_t   length;
+    size_t   pos;         /**< Offset of the next record; may be set to a keyframe offset to seek */
+    uint32_t last_ms;
+    uint16_t last_vref_mv;
+    uint16_t last_signal_mv;
+    bool     synced;      /**< A keyframe has been read */
+} ptx_trace_reader_t;
+
+/**
+ * @brief Start decoding a trace
+ * @param reader Reader to initialize
+ * @param data Trace bytes (header included)
+ * @param length Number of bytes
+ * @return false if the header is missing or has another version
+ */
+bool ptx_trace_reader_init(ptx_trace_reader_t* reader, const uint8_t* data, size_t length);
+
+/**
+ * @brief Decode the next record
+ */
+ptx_trace_read_result_t ptx_trace_read_next(ptx_trace_reader_t* reader, ptx_trace_event_t* event);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PTX_TRACE_H */
@@ -0,0 +1,54 @@
+/**
+ * @file ptx_transition_ring.cpp
+ * @brief Implementation of the heating transition ring
+ */
+#include "ptx_transition_ring.h"
+#include "ptx_logging.h"
+
+static_assert(sizeof(ptx_transition_t) == 8, "transition entry is part of the wire format");
+static_assert(PTX_TRANSITION_RING_DEPTH >= 2 && PTX_TRANSITION_RING_DEPTH <= 128 &&
+              (PTX_TRANSITION_RING_DEPTH & (PTX_TRANSITION_RING_DEPTH - 1)) == 0,
+              "PTX_TRANSITION_RING_DEPTH must be a power of two in 2..128");
+
+#define PTX_TRANSITION_RING_MASK (PTX_TRANSITION_RING_DEPTH - 1U)
+
+void ptx_transition_ring_init(ptx_transition_ring_t* ring) {
+    ring->head = 0;
+    ring->count = 0;
+    ring->total = 0;
+}
+
+void ptx_transition_ring_push(ptx_transition_ring_t* ring, uint32_t time_ms, uint8_t from, uint8_t to,
+                              uint8_t cause, int16_t temperature_dc) {
+    ptx_transition_t* t = &ring->entry[ring->head];
+    t->time_ms = time_ms;
+    t->temperature_dc = temperature_dc;
+    t->states = (uint8_t)((from << 4) | (to & 0x0FU));
+    t->cause = cause;
+
+    ring->head = (uint8_t)((ring->head + 1U) & PTX_TRANSITION_RING_MASK);
+    if (ring->count < PTX_TRANSITION_RING_DEPTH) ring->count++;
+    ring->total++;
+}
+
+uint8_t ptx_transition_ring_count(const ptx_transition_ring_t* ring) {
+    return ring->count;
+}
+
+bool ptx_transition_ring_get(const ptx_transition_ring_t* ring, uint8_t index, ptx_transition_t* out) {
+    if (index >= ring->count) return false;
+    uint8_t slot = (uint8_t)((ring->head - ring->count + index) & PTX_TRANSITION_RING_MASK);
+    *out = ring->entry[slot];
+    return true;
+}
+
+void ptx_transition_ring_log(const ptx_transition_ring_t* ring) {
+    PTX_LOGF("transitions: %u held, %u total", (unsigned)ring->count, (unsigned)ring->total);
+    for (uint8_t i = 0; i < ring->count; i++) {
+        ptx_transition_t t;
+        (void)ptx_transition_ring_get(ring, i, &t);
+        PTX_LOGF("  t=%lu %u->%u cause=%u temp=%ddC", (unsigned long)t.time_ms,
+                 (unsigned)ptx_transition_from(&t), (unsigned)ptx_transition_to(&t),
+                 (unsigned)t.cause, (int)t.temperature_dc);
+    }
+}
@@ -0,0 +1,112 @@
+/**
+ * @file ptx_transition_ring.h
+ * @brief Binary ring of heating state transitions for post-mortems
+ * @details Every state change of a controller instance is stored as one fixed
+ *          8-byte entry (time, from/to state, cause, temperature); recording is
+ *          a copy and an index increment, with no formatting. The ring keeps the
+ *          last PTX_TRANSITION_RING_DEPTH entries and is read back on demand
+ *          (serial GET_TRANSITIONS, or ptx_transition_ring_log()), so the history
+ *          leading to a lockout survives even if no console was attached.
+ */
+#ifndef PTX_TRANSITION_RING_H
+#define PTX_TRANSITION_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Build options */
+#ifndef PTX_TRANSITION_RING_DEPTH
+#define PTX_TRANSITION_RING_DEPTH 8U  /* Entries kept per controller instance (power of two) */
+#endif
+
+/**
+ * @brief Why a transition happened
+ */
+typedef enum {
+    PTX_TRANSITION_CAUSE_HEAT_DEMAND = 1,    /**< Temperature fell to the ON threshold */
+    PTX_TRANSITION_CAUSE_IGNITION_LIT,       /**< Ignition time elapsed, flame (or assumed) */
+    PTX_TRANSITION_CAUSE_IGNITION_EXHAUSTED, /**< Ignition failed on the last allowed attempt */
+    PTX_TRANSITION_CAUSE_IGNITION_FAILED,    /**< Ignition failed, retry after purge */
+    PTX_TRANSITION_CAUSE_AT_TEMPERATURE,     /**< Temperature reached the OFF threshold */
+    PTX_TRANSITION_CAUSE_PURGE_DONE,         /**< Purge time elapsed */
+    PTX_TRANSITION_CAUSE_DOOR_OPEN,          /**< Shutdown: door open */
+    PTX_TRANSITION_CAUSE_SENSOR_FAULT,       /**< Shutdown: latched sensor fault */
+    PTX_TRANSITION_CAUSE_ACTUATOR_FAULT,     /**< Shutdown: latched actuator fault */
+    PTX_TRANSITION_CAUSE_INHIBIT,            /**< Shutdown: zone supervisor inhibit */
+    PTX_TRANSITION_CAUSE_STARTUP,            /**< Forced idle during sensor stabilization */
+    PTX_TRANSITION_CAUSE_INVALID_STATE,      /**< Corrupt state reset to idle */
+    PTX_TRANSITION_CAUSE_MANUAL_RESET,       /**< ptx_oven_reset_ignition_lockout() */
+    PTX_TRANSITION_CAUSE_PREIGNITE           /**< Falling temperature predicted to reach ON within the ignition time */
+} ptx_transition_cause_t;
+
+/**
+ * @brief One recorded transition (8 bytes, wire layout of GET_TRANSITIONS)
+ */
+typedef struct {
+    uint32_t time_ms;         /**< millis() of the tick that changed state */
+    int16_t  temperature_dc;  /**< Temperature in deci-degrees C at that tick */
+    uint8_t  states;          /**< From state in the high nibble, to state in the low nibble */
+    uint8_t  cause;           /**< ptx_transition_cause_t */
+} ptx_transition_t;
+
+/**
+ * @brief Ring storage; embed one per controller instance
+ */
+typedef struct {
+    ptx_transition_t entry[PTX_TRANSITION_RING_DEPTH];
+    uint8_t  head;   /**< Next slot to write */
+    uint8_t  count;  /**< Valid entries (saturates at the depth) */
+    uint16_t total;  /**< Transitions recorded since init (wraps) */
+} ptx_transition_ring_t;
+
+/**
+ * @brief Empty the ring
+ */
+void ptx_transition_ring_init(ptx_transition_ring_t* ring);
+
+/**
+ * @brief Record one transition, overwriting the oldest entry when full
+ * @param ring Ring
+ * @param time_ms Time of the transition
+ * @param from Previous state (ptx_heating_state_t)
+ * @param to New state (ptx_heating_state_t)
+ * @param cause ptx_transition_cause_t
+ * @param temperature_dc Temperature in deci-degrees C
+ */
+void ptx_transition_ring_push(ptx_transition_ring_t* ring, uint32_t time_ms, uint8_t from, uint8_t to,
+                              uint8_t cause, int16_t temperature_dc);
+
+/**
+ * @brief Number of entries held
+ */
+uint8_t ptx_transition_ring_count(const ptx_transition_ring_t* ring);
+
+/**
+ * @brief Read an entry, oldest first
+ * @param ring Ring
+ * @param index 0 = oldest held entry
+ * @param out Receives the entry
+ * @return false if index >= ptx_transition_ring_count()
+ */
+bool ptx_transition_ring_get(const ptx_transition_ring_t* ring, uint8_t index, ptx_transition_t* out);
+
+/**
+ * @brief Print every held entry through PTX_LOGF, oldest first
+ */
+void ptx_transition_ring_log(const ptx_transition_ring_t* ring);
+
+/** From state of a packed entry */
+static inline uint8_t ptx_transition_from(const ptx_transition_t* t) { return (uint8_t)(t->states >> 4); }
+
+/** To state of a packed entry */
+static inline uint8_t ptx_transition_to(const ptx_transition_t* t) { return (uint8_t)(t->states & 0x0FU); }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PTX_TRANSITION_RING_H */
@@ -0,0 +1,139 @@
+/**
+ * @file bench_oven_control.cpp
+ * @brief Google Benchmark suite for the controller hot paths (host)
+ * @details The controller and filter sources are compiled into this file so
+ *          their internal (static) functions can be measured directly; the
+ *          rest of the firmware is linked as usual. The full tick runs with
+ *          the no-op logging mock, while BM_LogfFormat measures the real
+ *          ptx_logging.cpp formatting path against a discarding Serial stub.
+ *
+ *          JSON for tracking across commits:
+ *            ./build/oven_control_bench --benchmark_out=bench.json --benchmark_out_format=json
+ *          or: cmake --build build --target bench_json
+ */
+#include <benchmark/benchmark.h>
+#include <stdarg.h>
+#include "ptx_logging.h"
+#include "tests/mocks/mock_api.h"
+
+#include "ptx_sensor_filter.cpp"
+#include "ptx_oven_control.cpp"
+
+/* Real formatting path; namespaced so it does not clash with the logging mock */
+namespace pti_real_logging {
+#include "ptx_logging.cpp"
+}
+
+/* Deterministic ADC-like samples around 3 V with a few hundred mV of spread */
+static void ptx_bench_fill(uint16_t* buf, uint8_t count, uint32_t seed) {
+    for (uint8_t i = 0; i < count; i++) {
+        seed = seed * 1664525U + 1013904223U;
+        buf[i] = (uint16_t)(2800U + (seed >> 23));
+    }
+}
+
+static void BM_ComputeMedian(benchmark::State& state) {
+    const uint8_t count = (uint8_t)state.range(0);
+    uint16_t samples[16][PTX_FILTER_MAX_WINDOW];
+    for (uint32_t k = 0; k < 16; k++) ptx_bench_fill(samples[k], count, k + 1U);
+
+    uint32_t k = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(compute_median(samples[k++ & 15U], count));
+    }
+}
+BENCHMARK(BM_ComputeMedian)->DenseRange(3, PTX_FILTER_MAX_WINDOW);
+
+static void BM_SensorFilterUpdate(benchmark::State& state) {
+    ptx_sensor_filter_init((uint8_t)state.range(0));
+    uint16_t signal[64];
+    ptx_bench_fill(signal, 64, 7U);
+
+    uint32_t k = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ptx_sensor_filter_update(5000, signal[k++ & 63U]));
+    }
+}
+BENCHMARK(BM_SensorFilterUpdate)->Arg(3)->Arg(5)->Arg(PTX_FILTER_MAX_WINDOW);
+
+static void BM_ComputeTemperature(benchmark::State& state) {
+    uint16_t signal[64];
+    ptx_bench_fill(signal, 64, 11U);
+
+    uint32_t k = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ptx_compute_temperature(5000.0f, (float)signal[k++ & 63U]));
+    }
+}
+BENCHMARK(BM_ComputeTemperature);
+
+/* Arg 0: readings in range; arg 1: vref out of range (fault window running) */
+static void BM_EvalSensorFaults(benchmark::State& state) {
+    static ptx_oven_ctx_t ctx;
+    ptx_oven_ctx_init(&ctx);
+    ptx_oven_config_t cfg;
+    ptx_oven_get_default_config(&cfg);
+    ptx_oven_ctx_set_config(&ctx, &cfg);
+    pti_runtime_cfg_view view = { ctx.config, &ctx.compiled };
+
+    const uint16_t vref_mv = state.range(0) ? 4000U : 5000U;
+    const uint16_t signal_mv = 3000U;
+    uint32_t now = 1;
+    for (auto _ : state) {
+        ptx_eval_sensor_faults_with_timing(&ctx, view, now, vref_mv, signal_mv);
+        now += 1U;  /* stays inside the 1 s window: no latch, no log */
+        if (now > 900U) {
+            now = 1;
+            ctx.out_of_range_since_ms = 0;
+        }
+        benchmark::DoNotOptimize(ctx.status.vref_fault);
+    }
+}
+BENCHMARK(BM_EvalSensorFaults)->Arg(0)->Arg(1);
+
+/* ptx_oven_control_update() with the signal sweeping 150..210 C across the hysteresis band */
+static void BM_ControlTick(benchmark::State& state) {
+    mock_reset_time(0);
+    mock_set_vref_mv(5000);
+    mock_set_signal_mv(2565);
+    ptx_oven_control_init();
+    ptx_oven_set_door_state(false);
+
+    uint32_t i = 0;
+    for (auto _ : state) {
+        uint32_t phase = i++ % 1200U;
+        uint32_t tri = (phase < 600U) ? phase : (1200U - phase);
+        mock_set_signal_mv((uint16_t)(2565U + (tri * 774U) / 600U));
+        mock_advance_ms(10);
+        ptx_oven_control_update();
+    }
+    benchmark::DoNotOptimize(ptx_oven_get_status()->state);
+}
+BENCHMARK(BM_ControlTick);
+
+/* Per-tick output refresh with unchanged commands: the shadow compare only */
+static void BM_ApplyOutputsUnchanged(benchmark::State& state) {
+    ptx_actuator_init();
+    pti_default_ctx.status.gas_on = true;
+    pti_default_ctx.status.igniter_on = false;
+    ptx_apply_outputs(&pti_default_ctx);
+    mock_reset_output_write_count();
+    for (auto _ : state) {
+        ptx_apply_outputs(&pti_default_ctx);
+    }
+    state.counters["writes"] = (double)mock_get_output_write_count();
+}
+BENCHMARK(BM_ApplyOutputsUnchanged);
+
+/* Typical periodic status line through vsnprintf and the log prefix */
+static void BM_LogfFormat(benchmark::State& state) {
+    int temp = 180;
+    for (auto _ : state) {
+        pti_real_logging::ptx_logf(__FILE__, __LINE__, "state=%d temp=%dC vref=%dmV sig=%dmV gas=%d ign=%d",
+                                   2, temp, 5000, 3019, 1, 0);
+        temp ^= 1;
+    }
+}
+BENCHMARK(BM_LogfFormat);
+
+BENCHMARK_MAIN();
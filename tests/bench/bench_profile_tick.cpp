@@ -0,0 +1,63 @@
+/**
+ * @file bench_profile_tick.cpp
+ * @brief Time per ptx_oven_control_update() tick, runtime config vs compile-time profile
+ * @details Built twice by CMake (bench_tick_runtime, bench_tick_profile); the only
+ *          difference is -DPTX_OVEN_PROFILE on the controller sources. The sensor
+ *          input sweeps across the hysteresis band so every state is exercised.
+ *          Code size of the two controller objects: cmake --build . --target bench_profile_size
+ */
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include "ptx_oven_control.h"
+#include "ptx_oven_config.h"
+#include "tests/mocks/mock_api.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PTX_BENCH_HAVE_TSC 1
+#endif
+
+#ifdef PTX_OVEN_PROFILE
+#define PTX_BENCH_MODE "profile"
+#else
+#define PTX_BENCH_MODE "runtime"
+#endif
+
+static void ptx_bench_ticks(uint32_t ticks) {
+    for (uint32_t i = 0; i < ticks; i++) {
+        /* Triangle sweep 150..210 C over 1200 ticks (about 2.57 V .. 3.34 V at 5 V vref) */
+        uint32_t phase = i % 1200U;
+        uint32_t tri = (phase < 600U) ? phase : (1200U - phase);
+        mock_set_signal_mv((uint16_t)(2565U + (tri * 774U) / 600U));
+        mock_advance_ms(10);
+        ptx_oven_control_update();
+    }
+}
+
+int main(int argc, char** argv) {
+    uint32_t ticks = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 2000000U;
+
+    mock_reset_time(0);
+    ptx_oven_control_init();
+    ptx_oven_set_door_state(false);
+    mock_set_vref_mv(5000);
+    ptx_bench_ticks(1000);  /* warm up past the startup interlock */
+
+    auto t0 = std::chrono::steady_clock::now();
+#ifdef PTX_BENCH_HAVE_TSC
+    unsigned long long c0 = __rdtsc();
+#endif
+    ptx_bench_ticks(ticks);
+#ifdef PTX_BENCH_HAVE_TSC
+    unsigned long long c1 = __rdtsc();
+#endif
+    auto t1 = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / ticks;
+    printf("mode=%s ticks=%lu ns_per_tick=%.2f", PTX_BENCH_MODE, (unsigned long)ticks, ns);
+#ifdef PTX_BENCH_HAVE_TSC
+    printf(" tsc_per_tick=%.1f", (double)(c1 - c0) / ticks);
+#endif
+    printf(" state=%d\n", (int)ptx_oven_get_status()->state);
+    return 0;
+}
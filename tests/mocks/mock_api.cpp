@@ -1,13 +1,14 @@
 #include <stdint.h>
 #include <stdio.h>
+#include <chrono>
 #include "api.h"
 #include "mock_api.h"
 
 static unsigned long pti_now_ms = 0;
-static uint16_t pti_vref_mv = 5000;
-static uint16_t pti_signal_mv = 2000;
-static bool pti_gas = false;
-static bool pti_igniter = false;
+static uint16_t pti_input_mv[] = { 2000, 5000, 2000, 5000 };  /* indexed by input_t */
+static bool pti_output[4] = { false, false, false, false };     /* indexed by output_t */
+static uint32_t pti_output_writes = 0;
+static int8_t pti_output_stuck[4] = { -1, -1, -1, -1 };           /* -1: pin follows set_output() */
 
 extern "C" unsigned long millis(void) {
     return pti_now_ms;
@@ -16,31 +17,90 @@ extern "C" unsigned long millis(void) {
 extern "C" void mock_reset_time(unsigned long now_ms) { pti_now_ms = now_ms; }
 extern "C" void mock_advance_ms(unsigned long delta_ms) { pti_now_ms += delta_ms; }
 
-extern "C" void mock_set_vref_mv(uint16_t mv) { pti_vref_mv = mv; }
-extern "C" void mock_set_signal_mv(uint16_t mv) { pti_signal_mv = mv; }
+extern "C" void mock_set_vref_mv(uint16_t mv) { pti_input_mv[TEMPERATURE_SENSOR_REFERENCE] = mv; }
+extern "C" void mock_set_signal_mv(uint16_t mv) { pti_input_mv[TEMPERATURE_SENSOR] = mv; }
+
+extern "C" void mock_set_input_mv(input_t input, uint16_t mv) {
+    if ((unsigned)input < sizeof(pti_input_mv) / sizeof(pti_input_mv[0])) pti_input_mv[input] = mv;
+}
 
 extern "C" uint16_t read_voltage(input_t input) {
-    if (input == TEMPERATURE_SENSOR_REFERENCE) return pti_vref_mv;
-    if (input == TEMPERATURE_SENSOR) return pti_signal_mv;
+    if ((unsigned)input < sizeof(pti_input_mv) / sizeof(pti_input_mv[0])) return pti_input_mv[input];
     return 0;
 }
 
 extern "C" void set_output(output_t output, bool output_state) {
-    if (output == GAS_VALVE) pti_gas = output_state;
-    else if (output == IGNITER) pti_igniter = output_state;
+    pti_output_writes++;
+    if ((unsigned)output < sizeof(pti_output) / sizeof(pti_output[0])) pti_output[output] = output_state;
 }
 
 extern "C" bool read_output(output_t output) {
-    if (output == GAS_VALVE) return pti_gas;
-    if (output == IGNITER) return pti_igniter;
-    return false;
+    if ((unsigned)output >= sizeof(pti_output) / sizeof(pti_output[0])) return false;
+    if (pti_output_stuck[output] >= 0) return pti_output_stuck[output] != 0;
+    return pti_output[output];
+}
+
+extern "C" void mock_set_output_stuck(output_t output, int state) {
+    if ((unsigned)output < sizeof(pti_output_stuck) / sizeof(pti_output_stuck[0])) {
+        pti_output_stuck[output] = (int8_t)((state < 0) ? -1 : (state != 0));
+    }
 }
 
 extern "C" uint32_t get_millis() { return (uint32_t)pti_now_ms; }
 
+// Real host time, so timing stats measure the actual cost of the code under test
+extern "C" uint32_t get_micros() {
+    return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 extern "C" void serial_printf(const char * format, ...) {
     // no-op for tests
 }
 
-extern "C" bool mock_get_gas_output(void) { return pti_gas; }
-extern "C" bool mock_get_igniter_output(void) { return pti_igniter; }
+// Serial RX queue / TX capture for protocol loopback tests
+#define MOCK_SERIAL_BUF 512
+static uint8_t pti_rx_buf[MOCK_SERIAL_BUF];
+static uint16_t pti_rx_head = 0;
+static uint16_t pti_rx_tail = 0;
+static uint8_t pti_tx_buf[MOCK_SERIAL_BUF];
+static uint16_t pti_tx_len = 0;
+
+extern "C" int serial_read_byte() {
+    if (pti_rx_head == pti_rx_tail) return -1;
+    return pti_rx_buf[pti_rx_head++];
+}
+
+extern "C" void serial_write(const uint8_t * data, uint16_t length) {
+    for (uint16_t i = 0; i < length && pti_tx_len < MOCK_SERIAL_BUF; i++) {
+        pti_tx_buf[pti_tx_len++] = data[i];
+    }
+}
+
+extern "C" void mock_serial_reset(void) {
+    pti_rx_head = 0;
+    pti_rx_tail = 0;
+    pti_tx_len = 0;
+}
+
+extern "C" void mock_serial_push_rx(const uint8_t* data, uint16_t length) {
+    if (pti_rx_head == pti_rx_tail) {
+        pti_rx_head = 0;
+        pti_rx_tail = 0;
+    }
+    for (uint16_t i = 0; i < length && pti_rx_tail < MOCK_SERIAL_BUF; i++) {
+        pti_rx_buf[pti_rx_tail++] = data[i];
+    }
+}
+
+extern "C" uint16_t mock_serial_take_tx(uint8_t* out, uint16_t max_length) {
+    uint16_t n = (pti_tx_len < max_length) ? pti_tx_len : max_length;
+    for (uint16_t i = 0; i < n; i++) out[i] = pti_tx_buf[i];
+    pti_tx_len = 0;
+    return n;
+}
+
+extern "C" bool mock_get_gas_output(void) { return pti_output[GAS_VALVE]; }
+extern "C" bool mock_get_igniter_output(void) { return pti_output[IGNITER]; }
+extern "C" uint32_t mock_get_output_write_count(void) { return pti_output_writes; }
+extern "C" void mock_reset_output_write_count(void) { pti_output_writes = 0; }
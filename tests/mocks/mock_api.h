@@ -14,10 +14,30 @@ void mock_advance_ms(unsigned long delta_ms);
 // Control analog inputs (millivolts)
 void mock_set_vref_mv(uint16_t mv);
 void mock_set_signal_mv(uint16_t mv);
+// Any analog input, e.g. the second zone's TEMPERATURE_SENSOR_2 pair
+void mock_set_input_mv(input_t input, uint16_t mv);
 
 // Inspect outputs
 bool mock_get_gas_output(void);
 bool mock_get_igniter_output(void);
+// set_output() calls since the last reset
+uint32_t mock_get_output_write_count(void);
+void mock_reset_output_write_count(void);
+// Pin reads back as state (0/1) whatever was written; -1 releases it
+void mock_set_output_stuck(output_t output, int state);
+
+// Serial loopback: queue RX bytes for serial_read_byte(), collect serial_write() output
+void mock_serial_reset(void);
+void mock_serial_push_rx(const uint8_t* data, uint16_t length);
+uint16_t mock_serial_take_tx(uint8_t* out, uint16_t max_length);
+
+// EEPROM stand-in (1024 bytes, erased = 0xFF)
+void mock_eeprom_erase(void);
+// Load contents from a file (created if missing) and write every update through to it
+bool mock_eeprom_attach_file(const char* path);
+void mock_eeprom_detach_file(void);
+uint32_t mock_eeprom_get_write_count(uint16_t address);
+uint32_t mock_eeprom_get_total_writes(void);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,82 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "api.h"
+#include "mock_api.h"
+
+// ATmega328P EEPROM size; erased cells read 0xFF
+#define MOCK_EEPROM_SIZE 1024
+
+static uint8_t pti_eeprom[MOCK_EEPROM_SIZE];
+static uint32_t pti_write_count[MOCK_EEPROM_SIZE];
+static FILE* pti_backing_file = NULL;
+static bool pti_initialized = false;
+
+static void mock_eeprom_ensure_init(void) {
+    if (!pti_initialized) {
+        memset(pti_eeprom, 0xFF, sizeof(pti_eeprom));
+        pti_initialized = true;
+    }
+}
+
+extern "C" uint16_t eeprom_size() { return MOCK_EEPROM_SIZE; }
+
+extern "C" uint8_t eeprom_read(uint16_t address) {
+    mock_eeprom_ensure_init();
+    if (address >= MOCK_EEPROM_SIZE) return 0xFF;
+    return pti_eeprom[address];
+}
+
+extern "C" void eeprom_update(uint16_t address, uint8_t value) {
+    mock_eeprom_ensure_init();
+    if (address >= MOCK_EEPROM_SIZE || pti_eeprom[address] == value) return;
+    pti_eeprom[address] = value;
+    pti_write_count[address]++;
+    if (pti_backing_file != NULL) {
+        // Write-through so the file always reflects what survived a "power cut"
+        fseek(pti_backing_file, address, SEEK_SET);
+        fputc(value, pti_backing_file);
+        fflush(pti_backing_file);
+    }
+}
+
+extern "C" void mock_eeprom_erase(void) {
+    memset(pti_eeprom, 0xFF, sizeof(pti_eeprom));
+    memset(pti_write_count, 0, sizeof(pti_write_count));
+    pti_initialized = true;
+}
+
+extern "C" bool mock_eeprom_attach_file(const char* path) {
+    mock_eeprom_detach_file();
+    mock_eeprom_erase();
+
+    pti_backing_file = fopen(path, "r+b");
+    if (pti_backing_file != NULL) {
+        size_t n = fread(pti_eeprom, 1, MOCK_EEPROM_SIZE, pti_backing_file);
+        (void)n;  // a short file leaves the remaining cells erased
+    } else {
+        pti_backing_file = fopen(path, "w+b");
+        if (pti_backing_file == NULL) return false;
+    }
+    fseek(pti_backing_file, 0, SEEK_SET);
+    fwrite(pti_eeprom, 1, MOCK_EEPROM_SIZE, pti_backing_file);
+    fflush(pti_backing_file);
+    return true;
+}
+
+extern "C" void mock_eeprom_detach_file(void) {
+    if (pti_backing_file != NULL) {
+        fclose(pti_backing_file);
+        pti_backing_file = NULL;
+    }
+}
+
+extern "C" uint32_t mock_eeprom_get_write_count(uint16_t address) {
+    return (address < MOCK_EEPROM_SIZE) ? pti_write_count[address] : 0;
+}
+
+extern "C" uint32_t mock_eeprom_get_total_writes(void) {
+    uint32_t total = 0;
+    for (uint16_t i = 0; i < MOCK_EEPROM_SIZE; i++) total += pti_write_count[i];
+    return total;
+}
@@ -0,0 +1,23 @@
+# Runs ptx_replay on a trace and compares its output with the golden file.
+# Usage: cmake -DREPLAY=<ptx_replay> -DTRACE=<trace> -DEXPECTED=<golden.out> -DACTUAL=<out> -P compare_golden.cmake
+execute_process(
+    COMMAND ${REPLAY} ${TRACE}
+    OUTPUT_FILE ${ACTUAL}
+    RESULT_VARIABLE result
+)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "ptx_replay failed (${result}) on ${TRACE}")
+endif()
+
+# Line endings may differ depending on checkout settings
+file(READ ${EXPECTED} expected)
+file(READ ${ACTUAL} actual)
+string(REPLACE "\r\n" "\n" expected "${expected}")
+string(REPLACE "\r\n" "\n" actual "${actual}")
+if(NOT expected STREQUAL actual)
+    file(WRITE ${ACTUAL}.expected "${expected}")
+    execute_process(COMMAND diff -u ${ACTUAL}.expected ${ACTUAL})
+    message(FATAL_ERROR "replay of ${TRACE} differs from ${EXPECTED}\n"
+                        "If the change is intended, update the golden file with:\n"
+                        "  ${REPLAY} ${TRACE} > ${EXPECTED}")
+endif()
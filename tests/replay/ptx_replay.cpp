@@ -0,0 +1,138 @@
+/**
+ * @file ptx_replay.cpp
+ * @brief Replays a recorded input trace through the controller (host only)
+ * @details Usage: ptx_replay <trace.ptxt> [--every | --quiet] [--from <ms>] [--to <ms>]
+ *
+ *          The trace is memory-mapped and decoded in place (ptx_trace_map.h).
+ *          --from starts at the last keyframe at or before that trace time,
+ *          --to stops after it; --quiet prints only the summary. Throughput in
+ *          samples (tick records) per second goes to stderr.
+ *
+ *          Each tick record sets millis() and the sensor voltages and runs
+ *          ptx_oven_control_update(); each door record goes through the same
+ *          path as the sketch's door interrupt. One line is printed whenever
+ *          the outputs, heating state, ignition attempt or status flags change
+ *          (every tick with --every), plus one line per door edge, so the
+ *          output can be diffed against a golden file.
+ *
+ *          The controller runs with the default configuration; tuned values
+ *          from a unit's EEPROM are not part of the trace.
+ */
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ptx_actuator.h"
+#include "ptx_oven_control.h"
+#include "ptx_oven_status_packed.h"
+#include "ptx_trace.h"
+#include "ptx_trace_map.h"
+#include "replay_api.h"
+
+static const char* const pti_state_names[] = { "IDLE", "IGNITING", "HEATING", "PURGING", "LOCKOUT" };
+
+static int ptx_usage(void) {
+    fprintf(stderr, "usage: ptx_replay <trace.ptxt> [--every | --quiet] [--from <ms>] [--to <ms>]\n");
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) return ptx_usage();
+    bool every = false;
+    bool quiet = false;
+    bool seek = false;
+    uint64_t from_ms = 0;
+    uint64_t to_ms = UINT64_MAX;
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--every") == 0) {
+            every = true;
+        } else if (strcmp(argv[i], "--quiet") == 0) {
+            quiet = true;
+        } else if (strcmp(argv[i], "--from") == 0 && i + 1 < argc) {
+            from_ms = strtoull(argv[++i], NULL, 0);
+            seek = true;
+        } else if (strcmp(argv[i], "--to") == 0 && i + 1 < argc) {
+            to_ms = strtoull(argv[++i], NULL, 0);
+        } else {
+            return ptx_usage();
+        }
+    }
+
+    ptx_trace_map_t map;
+    if (!ptx_trace_map_open(&map, argv[1])) {
+        fprintf(stderr, "%s: cannot map or not a version %u trace\n", argv[1], PTX_TRACE_VERSION);
+        return 1;
+    }
+    ptx_trace_cursor_t cursor;
+    if (seek) {
+        if (!ptx_trace_map_seek(&map, from_ms, &cursor)) {
+            fprintf(stderr, "%s: no keyframe at or before %llu ms\n", argv[1], (unsigned long long)from_ms);
+            ptx_trace_map_close(&map);
+            return 1;
+        }
+    } else {
+        ptx_trace_map_rewind(&map, &cursor);
+    }
+
+    replay_api_reset();
+    replay_api_set_time((uint32_t)cursor.time_ms);  /* start of the replayed span */
+    ptx_oven_control_init();
+
+    ptx_trace_event_t ev;
+    ptx_trace_read_result_t rr;
+    uint64_t ticks = 0;
+    bool have_last = false;
+    uint8_t last_flags = 0, last_state_attempt = 0;
+    bool last_gas = false, last_igniter = false;
+
+    auto t0 = std::chrono::steady_clock::now();
+    while ((rr = ptx_trace_cursor_next(&cursor, &ev)) == PTX_TRACE_READ_OK) {
+        if (cursor.time_ms > to_ms) break;
+        replay_api_set_time(ev.time_ms);
+
+        if (ev.tag == PTX_TRACE_TAG_DOOR) {
+            /* Same path as door_sensor_interrupt_handler() in the sketch */
+            if (ev.door_open) ptx_actuator_emergency_stop();
+            ptx_oven_set_door_state(ev.door_open);
+            if (!quiet) printf("%10lu door %s\n", (unsigned long)ev.time_ms, ev.door_open ? "open" : "closed");
+            continue;
+        }
+
+        replay_api_set_inputs(ev.vref_mv, ev.signal_mv);
+        ptx_oven_control_update();
+        ticks++;
+
+        ptx_oven_status_packed_t p;
+        ptx_oven_status_pack(ptx_oven_get_status(), &p);
+        bool gas = replay_api_get_output(GAS_VALVE);
+        bool igniter = replay_api_get_output(IGNITER);
+        bool changed = !have_last || p.flags != last_flags || p.state_attempt != last_state_attempt ||
+                       gas != last_gas || igniter != last_igniter;
+        if (!quiet && (every || changed)) {
+            printf("%10lu %-8s attempt=%u gas=%d igniter=%d flags=0x%02X temp=%.1f vref=%u signal=%u\n",
+                   (unsigned long)ev.time_ms,
+                   pti_state_names[p.state_attempt & PTX_STATUS_STATE_MASK],
+                   p.state_attempt >> PTX_STATUS_ATTEMPT_SHIFT, gas ? 1 : 0, igniter ? 1 : 0, p.flags,
+                   (double)p.temperature_dc / 10.0,
+                   ev.vref_mv, ev.signal_mv);
+        }
+        have_last = true;
+        last_flags = p.flags;
+        last_state_attempt = p.state_attempt;
+        last_gas = gas;
+        last_igniter = igniter;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    printf("ticks=%llu\n", (unsigned long long)ticks);
+    fprintf(stderr, "replayed %llu samples in %.3f s (%.0f samples/s)\n", (unsigned long long)ticks, seconds,
+            seconds > 0.0 ? (double)ticks / seconds : 0.0);
+    size_t corrupt_at = cursor.reader.pos;
+    ptx_trace_map_close(&map);
+    if (rr == PTX_TRACE_READ_CORRUPT) {
+        fprintf(stderr, "%s: corrupt record at offset %zu\n", argv[1], corrupt_at);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file ptx_trace_capture_sim.cpp
+ * @brief Records input traces from the closed-loop plant simulation (host only)
+ * @details Usage: ptx_trace_capture_sim <scenario> <out.ptxt>
+ *
+ *          Scenarios:
+ *          - heat-cycle        heat up from ambient, door open for 15 s at 240 s, 6 min total
+ *          - vref-dropout      scripted inputs with ADC noise: heating, reference
+ *                              sags to 4.3 V for 3 s (sensor fault), recovery and
+ *                              auto-resume, 60 s total
+ *          - soak              24 h with the door open for 20 s every hour (~7 MB;
+ *                              replay throughput runs, not committed)
+ *
+ *          Used to regenerate the traces in tests/replay/golden; the recorder is
+ *          the same ptx_trace module that runs on the device.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "ptx_trace.h"
+#include "ptx_plant_sim.h"
+#include "ptx_oven_control.h"
+#include "mock_api.h"
+
+static std::vector<uint8_t> pti_trace;
+
+static void ptx_capture_sink(const uint8_t* data, uint8_t length) {
+    pti_trace.insert(pti_trace.end(), data, data + length);
+}
+
+/* Open-loop script: temperature rises 1 °C/s while gas is on, falls 0.2 °C/s otherwise */
+static void ptx_capture_vref_dropout(void) {
+    uint32_t seed = 12345U;
+    float temp_c = 22.0f;
+
+    mock_reset_time(0);
+    ptx_oven_control_init();
+    ptx_trace_start(ptx_capture_sink);
+    for (uint32_t now = 0; now < 60000U; now += 50U) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        int noise_mv = (int)(seed % 7U) - 3;
+
+        uint16_t vref_mv = (now >= 20000U && now < 23000U) ? 4300U : 5000U;
+        float ratio = 0.10f + 0.80f * (temp_c + 10.0f) / 310.0f;
+        mock_reset_time(now);
+        mock_set_vref_mv((uint16_t)(vref_mv + noise_mv));
+        mock_set_signal_mv((uint16_t)((float)vref_mv * ratio + (float)noise_mv));
+        ptx_oven_control_update();
+        temp_c += mock_get_gas_output() ? 0.05f : -0.01f;
+    }
+    ptx_trace_stop();
+}
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: ptx_trace_capture_sim heat-cycle|vref-dropout|soak <out.ptxt>\n");
+        return 2;
+    }
+
+    ptx_plant_params_t params;
+    ptx_plant_sim_default_params(&params);
+    uint32_t end_ms;
+
+    if (strcmp(argv[1], "heat-cycle") == 0) {
+        ptx_plant_sim_init(&params, 50, false);
+        ptx_plant_sim_schedule_door(240000, true);
+        ptx_plant_sim_schedule_door(255000, false);
+        end_ms = 360000;
+    } else if (strcmp(argv[1], "soak") == 0) {
+        ptx_plant_sim_init(&params, 50, false);
+        for (uint32_t h = 1; h < 24; h++) {
+            ptx_plant_sim_schedule_door(h * 3600000U, true);
+            ptx_plant_sim_schedule_door(h * 3600000U + 20000U, false);
+        }
+        end_ms = 24U * 3600000U;
+    } else if (strcmp(argv[1], "vref-dropout") == 0) {
+        end_ms = 0;
+    } else {
+        fprintf(stderr, "unknown scenario '%s'\n", argv[1]);
+        return 2;
+    }
+
+    if (end_ms == 0) {
+        ptx_capture_vref_dropout();
+    } else {
+        ptx_trace_start(ptx_capture_sink);
+        ptx_plant_sim_run_until(end_ms);
+        ptx_trace_stop();
+    }
+
+    FILE* f = fopen(argv[2], "wb");
+    if (f == NULL || fwrite(pti_trace.data(), 1, pti_trace.size(), f) != pti_trace.size()) {
+        fprintf(stderr, "cannot write %s\n", argv[2]);
+        if (f != NULL) fclose(f);
+        return 1;
+    }
+    fclose(f);
+    printf("%s: %lu bytes\n", argv[2], (unsigned long)pti_trace.size());
+    return 0;
+}
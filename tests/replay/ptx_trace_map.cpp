@@ -0,0 +1,136 @@
+/**
+ * @file ptx_trace_map.cpp
+ * @brief Implementation of the memory-mapped trace reader
+ */
+#include "ptx_trace_map.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bool ptx_trace_map_open(ptx_trace_map_t* map, const char* path) {
+    map->data = NULL;
+    map->length = 0;
+    map->index.clear();
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)PTX_TRACE_HEADER_SIZE) {
+        close(fd);
+        return false;
+    }
+    void* p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  /* the mapping keeps the file open */
+    if (p == MAP_FAILED) return false;
+    (void)madvise(p, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+    map->data = (const uint8_t*)p;
+    map->length = (size_t)st.st_size;
+    if (!ptx_trace_reader_init(&map->scan, map->data, map->length)) {
+        ptx_trace_map_close(map);
+        return false;
+    }
+    map->scan_time_ms = 0;
+    map->scan_keyframes = 0;
+    map->scan_done = false;
+    return true;
+}
+
+void ptx_trace_map_close(ptx_trace_map_t* map) {
+    if (map->data != NULL) {
+        munmap((void*)map->data, map->length);
+    }
+    map->data = NULL;
+    map->length = 0;
+    map->index.clear();
+    map->index.shrink_to_fit();
+}
+
+void ptx_trace_map_rewind(const ptx_trace_map_t* map, ptx_trace_cursor_t* cursor) {
+    (void)ptx_trace_reader_init(&cursor->reader, map->data, map->length);
+    cursor->time_ms = 0;
+    cursor->last_ms = 0;
+    cursor->started = false;
+}
+
+ptx_trace_read_result_t ptx_trace_cursor_next(ptx_trace_cursor_t* cursor, ptx_trace_event_t* event) {
+    ptx_trace_read_result_t rr = ptx_trace_read_next(&cursor->reader, event);
+    if (rr != PTX_TRACE_READ_OK) return rr;
+    if (cursor->started) {
+        cursor->time_ms += (uint32_t)(event->time_ms - cursor->last_ms);
+    } else {
+        cursor->time_ms = event->time_ms;
+        cursor->started = true;
+    }
+    cursor->last_ms = event->time_ms;
+    return rr;
+}
+
+/* Extend the index until it covers time_ms (or the end of the file) */
+static void ptx_trace_map_scan_to(ptx_trace_map_t* map, uint64_t time_ms) {
+    ptx_trace_event_t ev;
+    uint32_t last_ms = map->scan.last_ms;
+
+    while (!map->scan_done && (map->index.empty() || map->scan_time_ms <= time_ms)) {
+        size_t offset = map->scan.pos;
+        if (ptx_trace_read_next(&map->scan, &ev) != PTX_TRACE_READ_OK) {
+            map->scan_done = true;
+            break;
+        }
+        if (map->scan_keyframes > 0 || ev.tag != PTX_TRACE_TAG_KEYFRAME) {
+            map->scan_time_ms += (uint32_t)(ev.time_ms - last_ms);
+        } else {
+            map->scan_time_ms = ev.time_ms;
+        }
+        last_ms = ev.time_ms;
+        if (ev.tag == PTX_TRACE_TAG_KEYFRAME) {
+            if (map->scan_keyframes % PTX_TRACE_MAP_INDEX_STRIDE == 0) {
+                map->index.push_back({ map->scan_time_ms, offset });
+            }
+            map->scan_keyframes++;
+        }
+    }
+}
+
+bool ptx_trace_map_seek(ptx_trace_map_t* map, uint64_t time_ms, ptx_trace_cursor_t* cursor) {
+    ptx_trace_map_rewind(map, cursor);
+    ptx_trace_map_scan_to(map, time_ms);
+    if (map->index.empty() || map->index[0].time_ms > time_ms) return false;
+
+    /* Last index entry at or before time_ms */
+    size_t lo = 0, hi = map->index.size();
+    while (hi - lo > 1) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (map->index[mid].time_ms <= time_ms) lo = mid; else hi = mid;
+    }
+
+    /* Walk forward to the last keyframe at or before time_ms */
+    ptx_trace_cursor_t probe = *cursor;
+    probe.reader.pos = map->index[lo].offset;
+    probe.time_ms = map->index[lo].time_ms;
+    ptx_trace_cursor_t best = probe;
+
+    ptx_trace_event_t ev;
+    size_t offset = probe.reader.pos;
+    while (ptx_trace_read_next(&probe.reader, &ev) == PTX_TRACE_READ_OK) {
+        if (probe.started) {
+            probe.time_ms += (uint32_t)(ev.time_ms - probe.last_ms);
+        }
+        probe.started = true;
+        probe.last_ms = ev.time_ms;
+        if (probe.time_ms > time_ms) break;
+        if (ev.tag == PTX_TRACE_TAG_KEYFRAME) {
+            best.reader.pos = offset;
+            best.time_ms = probe.time_ms;
+        }
+        offset = probe.reader.pos;
+    }
+
+    /* The cursor re-reads the keyframe; its millis() value is the low 32 bits of the trace time */
+    *cursor = best;
+    cursor->reader.synced = false;
+    cursor->started = true;
+    cursor->last_ms = (uint32_t)best.time_ms;
+    return true;
+}
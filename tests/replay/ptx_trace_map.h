@@ -0,0 +1,82 @@
+/**
+ * @file ptx_trace_map.h
+ * @brief Memory-mapped access to recorded input traces (host only, POSIX)
+ * @details The trace file is mapped read-only and decoded in place with the
+ *          ptx_trace.h reader: no per-sample copies or allocation, and the
+ *          kernel pages the file in as the replay advances, so traces larger
+ *          than memory replay at decode speed.
+ *
+ *          Device timestamps are 32-bit millis() values that wrap every 49.7
+ *          days; the map works on an unwrapped 64-bit trace time instead
+ *          (first keyframe = its millis() value, then accumulated deltas).
+ *
+ *          Seeking uses a sparse index holding one keyframe in every
+ *          PTX_TRACE_MAP_INDEX_STRIDE. The index is built lazily: it only
+ *          covers the part of the file a seek has needed so far, so opening
+ *          and replaying from the start cost nothing up front.
+ */
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <vector>
+#include "ptx_trace.h"
+
+#define PTX_TRACE_MAP_INDEX_STRIDE 64U  /**< Keyframes per index entry (~4096 ticks) */
+
+typedef struct {
+    uint64_t time_ms;  /**< Unwrapped trace time of the keyframe */
+    size_t   offset;   /**< File offset of the keyframe record */
+} ptx_trace_index_entry_t;
+
+typedef struct {
+    const uint8_t* data;
+    size_t length;
+    std::vector<ptx_trace_index_entry_t> index;
+
+    /* Resume point of the lazy index scan */
+    ptx_trace_reader_t scan;
+    uint64_t scan_time_ms;
+    uint32_t scan_keyframes;
+    bool     scan_done;
+} ptx_trace_map_t;
+
+/**
+ * @brief Cursor over a mapped trace: decoder plus unwrapped time
+ */
+typedef struct {
+    ptx_trace_reader_t reader;
+    uint64_t time_ms;     /**< Unwrapped time of the last record returned */
+    uint32_t last_ms;     /**< Its millis() value */
+    bool     started;
+} ptx_trace_cursor_t;
+
+/**
+ * @brief Map a trace file
+ * @return false if the file cannot be mapped or has no valid header
+ */
+bool ptx_trace_map_open(ptx_trace_map_t* map, const char* path);
+
+/**
+ * @brief Unmap the file and drop the index
+ */
+void ptx_trace_map_close(ptx_trace_map_t* map);
+
+/**
+ * @brief Cursor at the first record
+ */
+void ptx_trace_map_rewind(const ptx_trace_map_t* map, ptx_trace_cursor_t* cursor);
+
+/**
+ * @brief Cursor at the last keyframe at or before a trace time
+ * @param time_ms Unwrapped trace time
+ * @return false if the trace has no keyframe at or before time_ms (cursor rewound)
+ * @note Controller state from before the keyframe is not reconstructed; seek
+ *       earlier than the point of interest to let the controller settle.
+ */
+bool ptx_trace_map_seek(ptx_trace_map_t* map, uint64_t time_ms, ptx_trace_cursor_t* cursor);
+
+/**
+ * @brief Decode the next record at the cursor and advance its unwrapped time
+ */
+ptx_trace_read_result_t ptx_trace_cursor_next(ptx_trace_cursor_t* cursor, ptx_trace_event_t* event);
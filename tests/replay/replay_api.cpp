@@ -0,0 +1,51 @@
+#include <stdint.h>
+#include "api.h"
+#include "replay_api.h"
+
+static uint32_t pti_now_ms = 0;
+static uint16_t pti_input_mv[] = { 0, 0, 0, 0 };            /* indexed by input_t */
+static bool pti_output[4] = { false, false, false, false };  /* indexed by output_t */
+
+extern "C" void replay_api_reset(void) {
+    pti_now_ms = 0;
+    for (unsigned i = 0; i < sizeof(pti_input_mv) / sizeof(pti_input_mv[0]); i++) pti_input_mv[i] = 0;
+    for (unsigned i = 0; i < sizeof(pti_output) / sizeof(pti_output[0]); i++) pti_output[i] = false;
+}
+
+extern "C" void replay_api_set_time(uint32_t now_ms) { pti_now_ms = now_ms; }
+
+extern "C" void replay_api_set_inputs(uint16_t vref_mv, uint16_t signal_mv) {
+    pti_input_mv[TEMPERATURE_SENSOR_REFERENCE] = vref_mv;
+    pti_input_mv[TEMPERATURE_SENSOR] = signal_mv;
+}
+
+extern "C" bool replay_api_get_output(output_t output) {
+    if ((unsigned)output < sizeof(pti_output) / sizeof(pti_output[0])) return pti_output[output];
+    return false;
+}
+
+extern "C" unsigned long millis(void) { return pti_now_ms; }
+
+extern "C" void setup_api() {}
+
+extern "C" uint16_t read_voltage(input_t input) {
+    if ((unsigned)input < sizeof(pti_input_mv) / sizeof(pti_input_mv[0])) return pti_input_mv[input];
+    return 0;
+}
+
+extern "C" void set_output(output_t output, bool output_state) {
+    if ((unsigned)output < sizeof(pti_output) / sizeof(pti_output[0])) pti_output[output] = output_state;
+}
+
+extern "C" bool read_output(output_t output) { return replay_api_get_output(output); }
+
+extern "C" uint32_t get_millis() { return pti_now_ms; }
+
+// Trace time, so timing stats are reproducible too
+extern "C" uint32_t get_micros() { return pti_now_ms * 1000U; }
+
+extern "C" void serial_printf(const char * format, ...) { (void)format; }
+
+extern "C" int serial_read_byte() { return -1; }
+
+extern "C" void serial_write(const uint8_t * data, uint16_t length) { (void)data; (void)length; }
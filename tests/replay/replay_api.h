@@ -0,0 +1,31 @@
+/**
+ * @file replay_api.h
+ * @brief api.h backend driven by a recorded trace (host only)
+ * @details Replaces tests/mocks/mock_api.cpp in the ptx_replay tool: millis()
+ *          and read_voltage() return the values of the trace record being
+ *          replayed, outputs are latched for inspection and serial output is
+ *          discarded. There is no real time involved, so a replay runs at full
+ *          host speed.
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include "api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Clear time, inputs and outputs
+void replay_api_reset(void);
+
+// Values returned by millis()/get_millis() and read_voltage() until the next call
+void replay_api_set_time(uint32_t now_ms);
+void replay_api_set_inputs(uint16_t vref_mv, uint16_t signal_mv);
+
+// Last value written by set_output()
+bool replay_api_get_output(output_t output);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,345 @@
+/**
+ * @file ptx_fleet_sim.cpp
+ * @brief Host-only fleet simulator: many controller instances against thermal plants
+ * @details Ovens are stored structure-of-arrays (ptx_oven_ctx_t array, plant
+ *          arrays, actuator command arrays) and split into contiguous shards, one
+ *          per worker thread. All shards advance simulated time in lockstep:
+ *          each epoch (one simulated minute) ends at a barrier. Each controller
+ *          has a private copy of the configuration, so workers never touch the
+ *          shared config slots.
+ *
+ *          Every oven starts cold, so the run also measures the closed-loop
+ *          response of the selected control mode: rise time to the target,
+ *          overshoot during the first PTX_SIM_SETTLE_MS, and RMS error after it.
+ *
+ *          Usage: ptx_fleet_sim [--ovens N] [--hours H] [--threads T] [--dt-ms D]
+ *                               [--door-per-hour R] [--seed S] [--mode M] [--autotune C]
+ *                               [--lead-ms L] [--preignite 0|1]
+ *          --mode: 0 hysteresis (default), 1 PI, 2 PID (ptx_control_mode_t)
+ *          --autotune: start a C-cycle relay autotune on every oven at t=0; the
+ *          tuned gains (PID rule with --mode 2, PI otherwise) then drive the
+ *          rest of the run, and the identified parameters are reported.
+ *          --lead-ms: predictive switching lookahead (predict_lead_ms), 0 = off.
+ *          --preignite: start ignitions ahead of the ON threshold (preignite_enabled).
+ */
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ptx_oven_control.h"
+#include "ptx_oven_config.h"
+#include "ptx_thermal_plant.h"
+
+#define PTX_SIM_EPOCH_MS 60000U
+#define PTX_SIM_SETTLE_MS 1200000U  /* Cold-start transient excluded from the RMS error */
+
+struct pti_sim_args_t {
+    uint32_t ovens;
+    uint32_t hours;
+    uint32_t threads;
+    uint32_t dt_ms;
+    uint32_t door_per_hour;
+    uint32_t seed;
+    uint32_t mode;
+    uint32_t autotune;
+    uint32_t lead_ms;
+    uint32_t preignite;
+};
+
+/* Per-shard counters, summed after the run */
+struct pti_fleet_metrics_t {
+    uint64_t oven_ticks;
+    uint64_t in_band_ticks;
+    uint64_t gas_on_ticks;
+    uint64_t ignitions;
+    uint64_t lockouts;
+    uint64_t sensor_faults;
+    uint64_t door_openings;
+    uint64_t settled_ticks;
+    double   settled_sq_err;
+    uint64_t risen;           /**< Ovens that reached the target */
+    uint64_t rise_ms_sum;
+    double   overshoot_sum;   /**< Peak above target during the transient, summed over ovens */
+    uint64_t tuned;           /**< Ovens whose autotune finished */
+    double   ku_sum;
+    double   tu_sum;
+    double   dead_time_sum;
+    double   kp_sum;
+    double   ki_sum;
+};
+
+struct pti_fleet_t {
+    uint32_t count;
+    std::vector<ptx_oven_ctx_t> ctx;
+    std::vector<ptx_oven_config_t> cfg;  /**< Private config of each oven (autotune writes it) */
+    std::vector<uint8_t>  tuned;    /**< Autotune result applied to cfg */
+    std::vector<uint8_t>  gas;
+    std::vector<uint8_t>  igniter;
+    std::vector<uint8_t>  door_open;
+    std::vector<uint32_t> door_close_ms;
+    std::vector<uint8_t>  prev_state;
+    std::vector<uint8_t>  prev_sensor_fault;
+    std::vector<uint32_t> rise_ms;  /**< First time at the target (0 = not yet) */
+    std::vector<float>    peak_c;   /**< Highest temperature during the transient */
+    ptx_thermal_plant_t   plant;
+};
+
+/* Reusable barrier (std::barrier is C++20) */
+class pti_barrier {
+public:
+    explicit pti_barrier(uint32_t parties) : parties_(parties), waiting_(0), generation_(0) {}
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        uint32_t gen = generation_;
+        if (++waiting_ == parties_) {
+            waiting_ = 0;
+            generation_++;
+            cv_.notify_all();
+        } else {
+            cv_.wait(lock, [&] { return gen != generation_; });
+        }
+    }
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    uint32_t parties_;
+    uint32_t waiting_;
+    uint32_t generation_;
+};
+
+static void ptx_fleet_init(pti_fleet_t* fleet, const pti_sim_args_t* args) {
+    fleet->count = args->ovens;
+    fleet->ctx.resize(args->ovens);
+    fleet->tuned.assign(args->ovens, 0);
+    fleet->gas.assign(args->ovens, 0);
+    fleet->igniter.assign(args->ovens, 0);
+    fleet->door_open.assign(args->ovens, 0);
+    fleet->door_close_ms.assign(args->ovens, 0);
+    fleet->prev_state.assign(args->ovens, PTX_HEATING_STATE_IDLE);
+    fleet->prev_sensor_fault.assign(args->ovens, 0);
+    fleet->rise_ms.assign(args->ovens, 0);
+    fleet->peak_c.assign(args->ovens, -1000.0f);
+    ptx_plant_init(&fleet->plant, args->ovens, args->seed);
+
+    ptx_oven_config_t cfg;
+    ptx_oven_get_default_config(&cfg);
+    cfg.control_mode = (uint8_t)args->mode;
+    cfg.predict_lead_ms = args->lead_ms;
+    cfg.preignite_enabled = (uint8_t)args->preignite;
+    fleet->cfg.assign(args->ovens, cfg);
+    for (uint32_t i = 0; i < args->ovens; i++) {
+        ptx_oven_ctx_init(&fleet->ctx[i]);
+        ptx_oven_ctx_set_config(&fleet->ctx[i], &fleet->cfg[i]);
+        if (args->autotune > 0) {
+            ptx_oven_ctx_start_autotune(&fleet->ctx[i],
+                                        (args->mode == PTX_CONTROL_MODE_PID) ? PTX_CONTROL_MODE_PID
+                                                                             : PTX_CONTROL_MODE_PI,
+                                        (uint8_t)args->autotune);
+        }
+    }
+}
+
+static void ptx_fleet_run_shard(pti_fleet_t* fleet, const pti_sim_args_t* args, uint32_t begin, uint32_t end,
+                                pti_barrier* barrier, pti_fleet_metrics_t* m) {
+    ptx_oven_config_t cfg;
+    ptx_oven_get_default_config(&cfg);
+    const float band_lo = cfg.temp_target_c - cfg.temp_delta_c;
+    const float band_hi = cfg.temp_target_c + cfg.temp_delta_c;
+    const uint64_t total_ms = (uint64_t)args->hours * 3600000ULL;
+    /* Door opening probability per tick, scaled to 32 bits */
+    const uint32_t door_threshold =
+        (uint32_t)((double)args->door_per_hour * args->dt_ms / 3600000.0 * 4294967296.0);
+
+    memset(m, 0, sizeof(*m));
+    for (uint64_t epoch_start = 0; epoch_start < total_ms; epoch_start += PTX_SIM_EPOCH_MS) {
+        uint64_t epoch_end = epoch_start + PTX_SIM_EPOCH_MS;
+        if (epoch_end > total_ms) epoch_end = total_ms;
+
+        for (uint64_t t = epoch_start; t < epoch_end; t += args->dt_ms) {
+            uint32_t now = (uint32_t)t;  /* firmware time wraps like millis() */
+
+            for (uint32_t i = begin; i < end; i++) {
+                ptx_oven_ctx_t* ctx = &fleet->ctx[i];
+
+                if (fleet->door_open[i]) {
+                    if ((int32_t)(now - fleet->door_close_ms[i]) >= 0) fleet->door_open[i] = 0;
+                } else if (ptx_plant_rand(&fleet->plant, i) < door_threshold) {
+                    fleet->door_open[i] = 1;
+                    fleet->door_close_ms[i] = now + 10000U + (ptx_plant_rand(&fleet->plant, i) % 30000U);
+                    m->door_openings++;
+                }
+                ptx_oven_ctx_set_door_state(ctx, fleet->door_open[i] != 0);
+
+                uint16_t vref_mv, signal_mv;
+                ptx_plant_sense(&fleet->plant, i, &vref_mv, &signal_mv);
+                ptx_oven_ctx_step(ctx, now, vref_mv, signal_mv);
+                if (!fleet->tuned[i] && ptx_autotune_apply(ptx_oven_ctx_get_autotune(ctx), &fleet->cfg[i])) {
+                    fleet->tuned[i] = 1;
+                    (void)ptx_oven_ctx_set_config(ctx, &fleet->cfg[i]);
+                }
+
+                const ptx_oven_status_t* st = ptx_oven_ctx_get_status(ctx);
+                fleet->gas[i] = st->gas_on;
+                fleet->igniter[i] = st->igniter_on;
+
+                uint8_t state = (uint8_t)st->state;
+                if (state != fleet->prev_state[i]) {
+                    if (state == PTX_HEATING_STATE_IGNITING) m->ignitions++;
+                    if (state == PTX_HEATING_STATE_LOCKOUT) m->lockouts++;
+                    fleet->prev_state[i] = state;
+                }
+                if (st->sensor_fault && !fleet->prev_sensor_fault[i]) m->sensor_faults++;
+                fleet->prev_sensor_fault[i] = st->sensor_fault;
+
+                float temp = fleet->plant.temp_c[i];
+                m->in_band_ticks += (temp >= band_lo && temp <= band_hi);
+                m->gas_on_ticks += st->gas_on;
+
+                if (t < PTX_SIM_SETTLE_MS) {
+                    if (temp > fleet->peak_c[i]) fleet->peak_c[i] = temp;
+                    if (fleet->rise_ms[i] == 0 && temp >= cfg.temp_target_c) fleet->rise_ms[i] = now;
+                } else if (fleet->rise_ms[i] != 0) {
+                    float err = temp - cfg.temp_target_c;
+                    m->settled_sq_err += (double)err * err;
+                    m->settled_ticks++;
+                }
+            }
+
+            ptx_plant_step(&fleet->plant, begin, end, args->dt_ms,
+                           fleet->gas.data(), fleet->igniter.data(), fleet->door_open.data());
+            m->oven_ticks += end - begin;
+        }
+        barrier->wait();
+    }
+
+    for (uint32_t i = begin; i < end; i++) {
+        const ptx_autotune_t* at = ptx_oven_ctx_get_autotune(&fleet->ctx[i]);
+        if (at->state == PTX_AUTOTUNE_DONE) {
+            m->tuned++;
+            m->ku_sum += at->ku;
+            m->tu_sum += at->tu_s;
+            m->dead_time_sum += at->dead_time_s;
+            m->kp_sum += at->kp;
+            m->ki_sum += at->ki;
+        }
+        if (fleet->rise_ms[i] == 0) continue;
+        m->risen++;
+        m->rise_ms_sum += fleet->rise_ms[i];
+        if (fleet->peak_c[i] > cfg.temp_target_c) m->overshoot_sum += fleet->peak_c[i] - cfg.temp_target_c;
+    }
+}
+
+static bool ptx_parse_args(int argc, char** argv, pti_sim_args_t* args) {
+    args->ovens = 10000;
+    args->hours = 24;
+    args->threads = std::thread::hardware_concurrency();
+    args->dt_ms = 250;
+    args->door_per_hour = 4;
+    args->seed = 1;
+    args->mode = PTX_CONTROL_MODE_HYSTERESIS;
+    args->autotune = 0;
+    args->lead_ms = 0;
+    args->preignite = 0;
+    if (args->threads == 0) args->threads = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) return false;
+        uint32_t v = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+        if (strcmp(argv[i], "--ovens") == 0) args->ovens = v;
+        else if (strcmp(argv[i], "--hours") == 0) args->hours = v;
+        else if (strcmp(argv[i], "--threads") == 0) args->threads = v;
+        else if (strcmp(argv[i], "--dt-ms") == 0) args->dt_ms = v;
+        else if (strcmp(argv[i], "--door-per-hour") == 0) args->door_per_hour = v;
+        else if (strcmp(argv[i], "--seed") == 0) args->seed = v;
+        else if (strcmp(argv[i], "--mode") == 0) args->mode = v;
+        else if (strcmp(argv[i], "--autotune") == 0) args->autotune = v;
+        else if (strcmp(argv[i], "--lead-ms") == 0) args->lead_ms = v;
+        else if (strcmp(argv[i], "--preignite") == 0) args->preignite = v;
+        else return false;
+        i++;
+    }
+    if (args->ovens == 0 || args->hours == 0 || args->dt_ms == 0 || args->threads == 0) return false;
+    if (args->mode > PTX_CONTROL_MODE_PID || args->autotune > PTX_AUTOTUNE_MAX_CYCLES) return false;
+    if (args->lead_ms > 30000 || args->preignite > 1) return false;
+    if (args->threads > args->ovens) args->threads = args->ovens;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    pti_sim_args_t args;
+    if (!ptx_parse_args(argc, argv, &args)) {
+        fprintf(stderr, "usage: ptx_fleet_sim [--ovens N] [--hours H] [--threads T] [--dt-ms D]\n"
+                        "                     [--door-per-hour R] [--seed S] [--mode M] [--autotune C]\n"
+                        "                     [--lead-ms L] [--preignite 0|1]\n");
+        return 2;
+    }
+
+    pti_fleet_t fleet;
+    ptx_fleet_init(&fleet, &args);
+
+    std::vector<pti_fleet_metrics_t> shard_metrics(args.threads);
+    std::vector<std::thread> workers;
+    pti_barrier barrier(args.threads);
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t s = 0; s < args.threads; s++) {
+        uint32_t begin = (uint32_t)((uint64_t)args.ovens * s / args.threads);
+        uint32_t end = (uint32_t)((uint64_t)args.ovens * (s + 1) / args.threads);
+        workers.emplace_back(ptx_fleet_run_shard, &fleet, &args, begin, end, &barrier, &shard_metrics[s]);
+    }
+    for (auto& w : workers) w.join();
+    double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    pti_fleet_metrics_t total;
+    memset(&total, 0, sizeof(total));
+    for (const auto& m : shard_metrics) {
+        total.oven_ticks    += m.oven_ticks;
+        total.in_band_ticks += m.in_band_ticks;
+        total.gas_on_ticks  += m.gas_on_ticks;
+        total.ignitions     += m.ignitions;
+        total.lockouts      += m.lockouts;
+        total.sensor_faults += m.sensor_faults;
+        total.door_openings += m.door_openings;
+        total.settled_ticks += m.settled_ticks;
+        total.settled_sq_err += m.settled_sq_err;
+        total.risen         += m.risen;
+        total.rise_ms_sum   += m.rise_ms_sum;
+        total.overshoot_sum += m.overshoot_sum;
+        total.tuned         += m.tuned;
+        total.ku_sum        += m.ku_sum;
+        total.tu_sum        += m.tu_sum;
+        total.dead_time_sum += m.dead_time_sum;
+        total.kp_sum        += m.kp_sum;
+        total.ki_sum        += m.ki_sum;
+    }
+
+    double oven_hours = (double)args.ovens * args.hours;
+    printf("ovens=%u hours=%u dt_ms=%u threads=%u seed=%u mode=%u\n",
+           args.ovens, args.hours, args.dt_ms, args.threads, args.seed, args.mode);
+    printf("ignitions_per_hour=%.2f time_in_band=%.1f%% gas_duty=%.1f%%\n",
+           total.ignitions / oven_hours,
+           100.0 * total.in_band_ticks / total.oven_ticks,
+           100.0 * total.gas_on_ticks / total.oven_ticks);
+    printf("rise_s=%.0f overshoot_c=%.2f rms_err_c=%.2f (settled after %us)\n",
+           total.risen ? total.rise_ms_sum / 1000.0 / total.risen : 0.0,
+           total.risen ? total.overshoot_sum / total.risen : 0.0,
+           total.settled_ticks ? sqrt(total.settled_sq_err / total.settled_ticks) : 0.0,
+           PTX_SIM_SETTLE_MS / 1000U);
+    if (args.autotune > 0) {
+        double n = total.tuned ? (double)total.tuned : 1.0;
+        printf("autotuned=%llu/%u ku=%.4f tu_s=%.1f dead_time_s=%.1f kp=%.4f ki=%.6f (means)\n",
+               (unsigned long long)total.tuned, args.ovens, total.ku_sum / n, total.tu_sum / n,
+               total.dead_time_sum / n, total.kp_sum / n, total.ki_sum / n);
+    }
+    printf("lockouts=%llu sensor_faults=%llu door_openings=%llu\n",
+           (unsigned long long)total.lockouts, (unsigned long long)total.sensor_faults,
+           (unsigned long long)total.door_openings);
+    printf("wall=%.2fs oven_hours_per_min=%.0f ns_per_oven_tick=%.1f\n",
+           wall_s, oven_hours / wall_s * 60.0, wall_s * 1e9 / total.oven_ticks);
+    return 0;
+}
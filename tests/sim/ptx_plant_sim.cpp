@@ -0,0 +1,243 @@
+/**
+ * @file ptx_plant_sim.cpp
+ * @brief Implementation of the closed-loop, discrete-event plant simulator
+ */
+#include "ptx_plant_sim.h"
+#include <math.h>
+#include <deque>
+#include "ptx_oven_control.h"
+#include "ptx_oven_config.h"
+#include "ptx_actuator.h"
+#include "tests/mocks/mock_api.h"
+
+/* Ticks kept before a threshold crossing so the median filter sees the approach */
+#define PTX_SIM_GUARD_MS 1000U
+
+struct pti_timed_event_t {
+    uint32_t at_ms;
+    bool     on;
+};
+
+static ptx_plant_params_t pti_params;
+static uint32_t pti_tick_ms = 50;
+static bool pti_discrete_event = true;
+
+static float pti_temp_c = 0.0f;
+static bool pti_flame = false;
+static bool pti_heat = false;            /* burner heat reaching the chamber (flame delayed by dead time) */
+static uint32_t pti_igniter_ms = 0;
+static bool pti_door_open = false;
+static std::deque<pti_timed_event_t> pti_heat_events;
+static std::deque<pti_timed_event_t> pti_door_events;
+static ptx_plant_sim_stats_t pti_stats;
+
+static uint32_t ptx_sim_now(void) {
+    return get_millis();
+}
+
+static void ptx_sim_track_extremes(void) {
+    if (pti_temp_c < pti_stats.min_temp_c) pti_stats.min_temp_c = pti_temp_c;
+    if (pti_temp_c > pti_stats.max_temp_c) pti_stats.max_temp_c = pti_temp_c;
+}
+
+/* Steady-state temperature and rate for the current inputs */
+static void ptx_sim_dynamics(float* t_inf, float* k) {
+    *k = pti_params.loss_per_s + (pti_door_open ? pti_params.door_loss_per_s : 0.0f);
+    *t_inf = pti_params.ambient_c + (pti_heat ? pti_params.burner_c_per_s / *k : 0.0f);
+}
+
+/* Exact solution over an interval with constant inputs */
+static void ptx_sim_evolve(uint32_t dt_ms) {
+    float t_inf, k;
+    ptx_sim_dynamics(&t_inf, &k);
+    pti_temp_c = t_inf + (pti_temp_c - t_inf) * expf(-k * (float)dt_ms * 0.001f);
+    ptx_sim_track_extremes();
+}
+
+/* Advance the plant from now to now + dt_ms, applying delayed heat changes on the way */
+static void ptx_sim_advance(uint32_t dt_ms) {
+    uint32_t now = ptx_sim_now();
+    uint32_t end = now + dt_ms;
+    while (!pti_heat_events.empty() && (int32_t)(pti_heat_events.front().at_ms - end) <= 0) {
+        uint32_t at = pti_heat_events.front().at_ms;
+        if ((int32_t)(at - now) > 0) {
+            ptx_sim_evolve(at - now);
+            now = at;
+        }
+        pti_heat = pti_heat_events.front().on;
+        pti_heat_events.pop_front();
+    }
+    ptx_sim_evolve(end - now);
+}
+
+static void ptx_sim_set_flame(bool on, uint32_t now) {
+    if (on == pti_flame) return;
+    pti_flame = on;
+    if (on) pti_stats.ignitions++;
+    pti_heat_events.push_back({ now + pti_params.dead_time_ms, on });
+}
+
+static void ptx_sim_apply_door_events(uint32_t now) {
+    while (!pti_door_events.empty() && (int32_t)(pti_door_events.front().at_ms - now) <= 0) {
+        pti_door_open = pti_door_events.front().on;
+        pti_door_events.pop_front();
+        /* Same path as the door ISR in the sketch */
+        if (pti_door_open) ptx_actuator_emergency_stop();
+        ptx_oven_set_door_state(pti_door_open);
+    }
+}
+
+static void ptx_sim_update_sensor(void) {
+    float t = pti_temp_c;
+    if (t < -10.0f) t = -10.0f;
+    if (t > 300.0f) t = 300.0f;
+    float signal = (float)pti_params.vref_mv * (0.10f + 0.80f * (t + 10.0f) / 310.0f);
+    mock_set_vref_mv(pti_params.vref_mv);
+    mock_set_signal_mv((uint16_t)(signal + 0.5f));
+}
+
+/* One controller tick followed by tick_ms of plant time */
+static void ptx_sim_tick(void) {
+    uint32_t now = ptx_sim_now();
+    ptx_sim_apply_door_events(now);
+    ptx_sim_update_sensor();
+    ptx_oven_control_update();
+    pti_stats.ticks++;
+
+    bool gas = mock_get_gas_output();
+    bool igniter = mock_get_igniter_output();
+    if (!gas) {
+        pti_igniter_ms = 0;
+        ptx_sim_set_flame(false, now);
+    } else if (!pti_flame && igniter) {
+        pti_igniter_ms += pti_tick_ms;
+        if (pti_igniter_ms >= pti_params.ignition_delay_ms) ptx_sim_set_flame(true, now);
+    }
+    if (gas) pti_stats.gas_on_ms += pti_tick_ms;
+
+    ptx_sim_advance(pti_tick_ms);
+    mock_advance_ms(pti_tick_ms);
+}
+
+/* Time until the temperature reaches threshold_c with constant inputs:
+   0 if already there or past it, UINT32_MAX if it is never reached */
+static uint32_t ptx_sim_time_to_cross(float threshold_c) {
+    float t_inf, k;
+    ptx_sim_dynamics(&t_inf, &k);
+    float dir = (t_inf >= pti_temp_c) ? 1.0f : -1.0f;
+    if ((threshold_c - pti_temp_c) * dir <= 0.0f) return 0;
+    if ((t_inf - threshold_c) * dir <= 0.0f) return UINT32_MAX;
+    float seconds = logf((pti_temp_c - t_inf) / (threshold_c - t_inf)) / k;
+    return (seconds * 1000.0f >= 4.0e9f) ? UINT32_MAX : (uint32_t)(seconds * 1000.0f);
+}
+
+/* Whether the controller switches only at the configured hysteresis thresholds.
+   PI/PID windows, predictive lead, pre-ignition, a recipe setpoint and an autotune
+   session all act between them, so those runs tick every period. */
+static bool ptx_sim_plain_hysteresis(void) {
+    const ptx_oven_config_t* cfg = ptx_oven_get_config();
+    return cfg->control_mode == PTX_CONTROL_MODE_HYSTERESIS && cfg->predict_lead_ms == 0 &&
+           !cfg->preignite_enabled && !ptx_recipe_running(ptx_oven_get_recipe()) &&
+           !ptx_autotune_running(ptx_oven_get_autotune());
+}
+
+/* Idle time that can be skipped without changing what the controller would do */
+static uint32_t ptx_sim_skippable_ms(uint32_t end_ms) {
+    uint32_t now = ptx_sim_now();
+    const ptx_oven_status_t* st = ptx_oven_get_status();
+    if (now < 2000U + PTX_SIM_GUARD_MS || st->sensor_fault || !ptx_sim_plain_hysteresis()) return 0;
+
+    float threshold;
+    if (st->state == PTX_HEATING_STATE_IDLE && !st->gas_on) {
+        threshold = ptx_oven_get_temp_target_c() - ptx_oven_get_temp_delta_c();
+    } else if (st->state == PTX_HEATING_STATE_HEATING && !st->igniter_on) {
+        threshold = ptx_oven_get_temp_target_c() + ptx_oven_get_temp_delta_c();
+    } else {
+        return 0;  /* igniting, purging, lockout: timers are running */
+    }
+    /* Door open holds the controller idle: only the door event ends the quiet period */
+    uint32_t horizon = (st->door_open) ? UINT32_MAX : ptx_sim_time_to_cross(threshold);
+    if (horizon != UINT32_MAX) horizon = (horizon > PTX_SIM_GUARD_MS) ? horizon - PTX_SIM_GUARD_MS : 0;
+
+    if (!pti_heat_events.empty()) {
+        uint32_t d = pti_heat_events.front().at_ms - now;
+        if (d < horizon) horizon = d;
+    }
+    if (!pti_door_events.empty()) {
+        uint32_t d = pti_door_events.front().at_ms - now;
+        if (d < horizon) horizon = d;
+    }
+    if (end_ms - now < horizon) horizon = end_ms - now;
+
+    horizon -= horizon % pti_tick_ms;  /* keep the tick phase */
+    return (horizon >= 2U * pti_tick_ms) ? horizon : 0;
+}
+
+void ptx_plant_sim_default_params(ptx_plant_params_t* params) {
+    params->ambient_c = 22.0f;
+    params->burner_c_per_s = 2.0f;
+    params->loss_per_s = 0.003f;
+    params->door_loss_per_s = 0.03f;
+    params->ignition_delay_ms = 1500;
+    params->dead_time_ms = 3000;
+    params->vref_mv = 5000;
+}
+
+void ptx_plant_sim_init(const ptx_plant_params_t* params, uint32_t tick_ms, bool discrete_event) {
+    pti_params = *params;
+    pti_tick_ms = (tick_ms == 0) ? 1 : tick_ms;
+    pti_discrete_event = discrete_event;
+
+    pti_temp_c = params->ambient_c;
+    pti_flame = false;
+    pti_heat = false;
+    pti_igniter_ms = 0;
+    pti_door_open = false;
+    pti_heat_events.clear();
+    pti_door_events.clear();
+
+    pti_stats.ticks = 0;
+    pti_stats.skips = 0;
+    pti_stats.skipped_ms = 0;
+    pti_stats.ignitions = 0;
+    pti_stats.gas_on_ms = 0;
+    ptx_plant_sim_reset_extremes();
+
+    mock_reset_time(0);
+    ptx_sim_update_sensor();
+    ptx_oven_control_init();
+    ptx_oven_set_door_state(false);
+}
+
+void ptx_plant_sim_schedule_door(uint32_t at_ms, bool open) {
+    pti_door_events.push_back({ at_ms, open });
+}
+
+void ptx_plant_sim_run_until(uint32_t end_ms) {
+    while ((int32_t)(end_ms - ptx_sim_now()) > 0) {
+        uint32_t skip = pti_discrete_event ? ptx_sim_skippable_ms(end_ms) : 0;
+        if (skip > 0) {
+            bool gas = mock_get_gas_output();
+            ptx_sim_advance(skip);
+            mock_advance_ms(skip);
+            if (gas) pti_stats.gas_on_ms += skip;
+            pti_stats.skips++;
+            pti_stats.skipped_ms += skip;
+        } else {
+            ptx_sim_tick();
+        }
+    }
+}
+
+float ptx_plant_sim_temp_c(void) {
+    return pti_temp_c;
+}
+
+void ptx_plant_sim_reset_extremes(void) {
+    pti_stats.min_temp_c = pti_temp_c;
+    pti_stats.max_temp_c = pti_temp_c;
+}
+
+const ptx_plant_sim_stats_t* ptx_plant_sim_get_stats(void) {
+    return &pti_stats;
+}
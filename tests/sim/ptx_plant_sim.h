@@ -0,0 +1,92 @@
+/**
+ * @file ptx_plant_sim.h
+ * @brief Host-only closed-loop plant: drives the controller through mock_api
+ * @details The plant reads the GAS_VALVE/IGNITER outputs the controller writes
+ *          to mock_api and feeds back the sensor voltages of a simulated oven:
+ *          - the flame lights once the igniter has run for ignition_delay_ms
+ *            with gas flowing, and goes out when gas is cut
+ *          - burner heat reaches the chamber dead_time_ms after the flame changes
+ *          - first-order heating and loss to ambient, extra loss with door open
+ *
+ *          Inputs are piecewise constant, so each segment is solved exactly
+ *          (exponential). In discrete-event mode the simulator skips controller
+ *          ticks while nothing can happen: in IDLE or HEATING it jumps ahead to
+ *          shortly before the temperature reaches the next hysteresis threshold
+ *          or a scheduled event, then resumes normal ticking. Skipping applies
+ *          to plain hysteresis control only; with PI/PID, predictive lead,
+ *          pre-ignition, a running recipe or an autotune session every tick runs.
+ *
+ *          The controller under test is the default instance
+ *          (ptx_oven_control_update()) using the shared configuration.
+ */
+#ifndef PTX_PLANT_SIM_H
+#define PTX_PLANT_SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Physical parameters of the simulated oven
+ */
+typedef struct {
+    float    ambient_c;
+    float    burner_c_per_s;     /**< Heating rate with full burner heat at ambient */
+    float    loss_per_s;         /**< Newtonian loss coefficient (1/s) */
+    float    door_loss_per_s;    /**< Extra loss coefficient while the door is open */
+    uint32_t ignition_delay_ms;  /**< Igniter time needed to light the flame */
+    uint32_t dead_time_ms;       /**< Delay from flame change to heat change at the sensor */
+    uint16_t vref_mv;
+} ptx_plant_params_t;
+
+/**
+ * @brief Counters since ptx_plant_sim_init()
+ */
+typedef struct {
+    uint32_t ticks;          /**< Controller ticks executed */
+    uint32_t skips;          /**< Idle intervals skipped */
+    uint64_t skipped_ms;     /**< Simulated time covered by skips */
+    uint32_t ignitions;      /**< Flame lit events */
+    uint64_t gas_on_ms;      /**< Simulated time with gas valve open */
+    float    min_temp_c;     /**< Extremes since ptx_plant_sim_reset_extremes() */
+    float    max_temp_c;
+} ptx_plant_sim_stats_t;
+
+/**
+ * @brief Typical cookie oven: 2 °C/s burner, 3 s dead time, 1.5 s ignition
+ */
+void ptx_plant_sim_default_params(ptx_plant_params_t* params);
+
+/**
+ * @brief Reset mock time to 0, initialize the controller and the plant at ambient
+ * @param params Plant parameters
+ * @param tick_ms Controller period (the sketch uses 50 ms)
+ * @param discrete_event true to skip idle controller ticks
+ */
+void ptx_plant_sim_init(const ptx_plant_params_t* params, uint32_t tick_ms, bool discrete_event);
+
+/**
+ * @brief Open or close the door at a simulated time (events must be added in time order)
+ */
+void ptx_plant_sim_schedule_door(uint32_t at_ms, bool open);
+
+/**
+ * @brief Run the closed loop until mock time reaches end_ms
+ */
+void ptx_plant_sim_run_until(uint32_t end_ms);
+
+/**
+ * @brief Current chamber temperature
+ */
+float ptx_plant_sim_temp_c(void);
+
+/**
+ * @brief Restart min/max temperature tracking from the current temperature
+ */
+void ptx_plant_sim_reset_extremes(void);
+
+/**
+ * @brief Counters of the current run
+ */
+const ptx_plant_sim_stats_t* ptx_plant_sim_get_stats(void);
+
+#endif /* PTX_PLANT_SIM_H */
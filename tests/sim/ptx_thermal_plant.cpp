@@ -0,0 +1,74 @@
+/**
+ * @file ptx_thermal_plant.cpp
+ * @brief Implementation of the structure-of-arrays thermal oven model
+ */
+#include "ptx_thermal_plant.h"
+
+static float ptx_uniform(ptx_thermal_plant_t* plant, uint32_t oven, float lo, float hi) {
+    return lo + (hi - lo) * (float)(ptx_plant_rand(plant, oven) >> 8) * (1.0f / 16777216.0f);
+}
+
+void ptx_plant_init(ptx_thermal_plant_t* plant, uint32_t count, uint32_t seed) {
+    plant->ambient_c.resize(count);
+    plant->burner_c_per_s.resize(count);
+    plant->loss_per_s.resize(count);
+    plant->door_loss_per_s.resize(count);
+    plant->ignition_delay_ms.resize(count);
+    plant->vref_mv.resize(count);
+    plant->temp_c.resize(count);
+    plant->flame.assign(count, 0);
+    plant->igniter_on_ms.assign(count, 0);
+    plant->rng.resize(count);
+
+    for (uint32_t i = 0; i < count; i++) {
+        /* Distinct non-zero stream per oven */
+        plant->rng[i] = (seed ^ 0x9E3779B9U) + i * 0x85EBCA6BU;
+        if (plant->rng[i] == 0) plant->rng[i] = 1;
+
+        plant->ambient_c[i]         = ptx_uniform(plant, i, 15.0f, 35.0f);
+        plant->burner_c_per_s[i]    = ptx_uniform(plant, i, 1.5f, 3.0f);
+        plant->loss_per_s[i]        = ptx_uniform(plant, i, 0.0015f, 0.004f);
+        plant->door_loss_per_s[i]   = ptx_uniform(plant, i, 0.02f, 0.05f);
+        plant->ignition_delay_ms[i] = (uint16_t)ptx_uniform(plant, i, 500.0f, 3000.0f);
+        if ((ptx_plant_rand(plant, i) % 100U) < 2U) {
+            plant->ignition_delay_ms[i] = 8000U;  /* worn igniter: never lights within 5 s */
+        }
+        plant->vref_mv[i]           = (uint16_t)ptx_uniform(plant, i, 4800.0f, 5200.0f);
+        plant->temp_c[i]            = plant->ambient_c[i];
+    }
+}
+
+void ptx_plant_step(ptx_thermal_plant_t* plant, uint32_t begin, uint32_t end, uint32_t dt_ms,
+                    const uint8_t* gas, const uint8_t* igniter, const uint8_t* door_open) {
+    const float dt_s = (float)dt_ms * 0.001f;
+    float* temp = plant->temp_c.data();
+    uint8_t* flame = plant->flame.data();
+    uint16_t* ign_ms = plant->igniter_on_ms.data();
+
+    for (uint32_t i = begin; i < end; i++) {
+        if (!gas[i]) {
+            flame[i] = 0;
+            ign_ms[i] = 0;
+        } else if (!flame[i] && igniter[i]) {
+            uint32_t t = (uint32_t)ign_ms[i] + dt_ms;
+            ign_ms[i] = (uint16_t)(t > 0xFFFFU ? 0xFFFFU : t);
+            if (ign_ms[i] >= plant->ignition_delay_ms[i]) flame[i] = 1;
+        }
+
+        float loss = plant->loss_per_s[i] + (door_open[i] ? plant->door_loss_per_s[i] : 0.0f);
+        float dtemp = (flame[i] ? plant->burner_c_per_s[i] : 0.0f) - loss * (temp[i] - plant->ambient_c[i]);
+        temp[i] += dtemp * dt_s;
+    }
+}
+
+void ptx_plant_sense(ptx_thermal_plant_t* plant, uint32_t oven, uint16_t* vref_mv, uint16_t* signal_mv) {
+    float vref = (float)plant->vref_mv[oven];
+    float t = plant->temp_c[oven];
+    if (t < -10.0f) t = -10.0f;
+    if (t > 300.0f) t = 300.0f;
+    /* Sensor map used by the firmware: 10% vref at -10 C, 90% vref at 300 C */
+    float signal = vref * (0.10f + 0.80f * (t + 10.0f) / 310.0f);
+    signal += (float)((int32_t)(ptx_plant_rand(plant, oven) & 15U) - 8);  /* +-8 mV noise */
+    *vref_mv = (uint16_t)vref;
+    *signal_mv = (uint16_t)(signal + 0.5f);
+}
@@ -0,0 +1,74 @@
+/**
+ * @file ptx_thermal_plant.h
+ * @brief Host-only thermal model of a gas oven, stored structure-of-arrays
+ * @details First-order lumped model per oven:
+ *            dT/dt = burner_c_per_s * flame - loss_per_s * (T - ambient_c)
+ *          The flame lights after the igniter has been on for ignition_delay_ms
+ *          while gas flows, and goes out when gas is cut. Door openings add an
+ *          extra loss term. Sensor output is the ratiometric signal/vref pair the
+ *          firmware expects, with a small uniform noise.
+ */
+#ifndef PTX_THERMAL_PLANT_H
+#define PTX_THERMAL_PLANT_H
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @brief Per-oven plant state and parameters, one element per oven in each array
+ */
+struct ptx_thermal_plant_t {
+    /* Parameters (randomized per oven by ptx_plant_init) */
+    std::vector<float>    ambient_c;
+    std::vector<float>    burner_c_per_s;     /**< Heating rate with flame at ambient */
+    std::vector<float>    loss_per_s;         /**< Newtonian loss coefficient */
+    std::vector<float>    door_loss_per_s;    /**< Extra loss while the door is open */
+    std::vector<uint16_t> ignition_delay_ms;  /**< Igniter time needed to light the flame */
+    std::vector<uint16_t> vref_mv;
+
+    /* State */
+    std::vector<float>    temp_c;
+    std::vector<uint8_t>  flame;
+    std::vector<uint16_t> igniter_on_ms;      /**< Igniter time accumulated this ignition */
+    std::vector<uint32_t> rng;                /**< xorshift32 state (noise, door events) */
+};
+
+/**
+ * @brief Size the arrays and randomize per-oven parameters
+ * @param plant Plant to initialize
+ * @param count Number of ovens
+ * @param seed Fleet seed; the same seed gives the same fleet
+ */
+void ptx_plant_init(ptx_thermal_plant_t* plant, uint32_t count, uint32_t seed);
+
+/**
+ * @brief Advance ovens [begin, end) by dt_ms with the given actuator commands
+ * @param plant Plant
+ * @param begin First oven index
+ * @param end One past the last oven index
+ * @param dt_ms Time step
+ * @param gas Gas valve command per oven (indexed from 0)
+ * @param igniter Igniter command per oven
+ * @param door_open Door state per oven
+ */
+void ptx_plant_step(ptx_thermal_plant_t* plant, uint32_t begin, uint32_t end, uint32_t dt_ms,
+                    const uint8_t* gas, const uint8_t* igniter, const uint8_t* door_open);
+
+/**
+ * @brief Sensor voltages for one oven (signal includes noise)
+ */
+void ptx_plant_sense(ptx_thermal_plant_t* plant, uint32_t oven, uint16_t* vref_mv, uint16_t* signal_mv);
+
+/**
+ * @brief Next pseudo-random number of one oven's stream
+ */
+static inline uint32_t ptx_plant_rand(ptx_thermal_plant_t* plant, uint32_t oven) {
+    uint32_t x = plant->rng[oven];
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    plant->rng[oven] = x;
+    return x;
+}
+
+#endif /* PTX_THERMAL_PLANT_H */
@@ -8,3 +8,34 @@ unsigned long millis(void);
 #ifdef __cplusplus
 }
 #endif
+
+#ifdef __cplusplus
+#include <stddef.h>
+#include <stdio.h>
+// Serial stand-in so ptx_logging.cpp builds on the host (benchmarks); output is
+// formatted like Arduino's Print and discarded
+class PtxSerialStub {
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    explicit operator bool() const { return true; }
+    size_t print(const char* s) {
+        size_t n = 0;
+        while (s[n] != '\0') sink_ ^= (unsigned char)s[n++];
+        return n;
+    }
+    size_t print(unsigned long v) {
+        char buf[12];
+        snprintf(buf, sizeof(buf), "%lu", v);
+        return print(buf);
+    }
+    size_t print(int v) {
+        char buf[12];
+        snprintf(buf, sizeof(buf), "%d", v);
+        return print(buf);
+    }
+    size_t println(const char* s) { return print(s) + print("\r\n"); }
+private:
+    volatile unsigned char sink_ = 0;
+};
+static PtxSerialStub Serial;
+#endif
@@ -0,0 +1,34 @@
+#pragma once
+#include <stdint.h>
+// Simulated AVR port for host tests of the PTX_ACTUATOR_PORT_DIRECT backend.
+// PORTD counts register writes; PIND reads back the driven level like an
+// output pin on the real part, unless a pin is held high from outside.
+
+#define _BV(bit) (1U << (bit))
+#define PD0 0
+#define PD1 1
+#define PD2 2
+#define PD3 3
+#define PD4 4
+#define PD5 5
+#define PD6 6
+#define PD7 7
+
+class PtxSimPort {
+public:
+    operator uint8_t() const { return value_; }
+    PtxSimPort& operator=(uint8_t v) { value_ = v; writes_++; return *this; }
+    PtxSimPort& operator|=(uint8_t v) { return *this = (uint8_t)(value_ | v); }
+    PtxSimPort& operator&=(uint8_t v) { return *this = (uint8_t)(value_ & v); }
+    void reset(uint8_t v) { value_ = v; writes_ = 0; held_high_ = 0; }
+    uint32_t writes() const { return writes_; }
+    void hold_high(uint8_t mask) { held_high_ = mask; }  // shorted to supply: reads high whatever is driven
+    uint8_t pins() const { return (uint8_t)(value_ | held_high_); }
+private:
+    uint8_t value_ = 0;
+    uint32_t writes_ = 0;
+    uint8_t held_high_ = 0;
+};
+
+extern PtxSimPort PORTD;
+#define PIND (PORTD.pins())
@@ -0,0 +1,199 @@
+/**
+ * @file test_actuator_port_gtest.cpp
+ * @brief Port-register actuator backend against a simulated PORTD
+ * @details Built as its own executable with PTX_ACTUATOR_PORT_DIRECT=1 and the
+ *          avr/io.h stub from tests/stubs, linked with the controller so the
+ *          readback path can be driven through ptx_oven_control_update().
+ */
+#include <gtest/gtest.h>
+#include <avr/io.h>
+#include "ptx_actuator.h"
+#include "ptx_oven_control.h"
+#include "ptx_oven_config.h"
+#include "tests/mocks/mock_api.h"
+
+PtxSimPort PORTD;
+
+static uint16_t mv_for_temp(float vref_mv, float temp_c) {
+    float val = ((temp_c + 10.0f) / 310.0f) * (0.80f * vref_mv) + 0.10f * vref_mv;
+    return (uint16_t)(val + 0.5f);
+}
+
+class ActuatorPortTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        PORTD.reset(_BV(PD0) | _BV(PD1) | _BV(PD3));  // UART and door pins, not ours
+        mock_reset_output_write_count();
+        ptx_actuator_init();
+    }
+};
+
+TEST_F(ActuatorPortTest, InitClearsBurnerPinsOnly) {
+    EXPECT_EQ((uint8_t)PORTD, _BV(PD0) | _BV(PD1) | _BV(PD3));
+    EXPECT_EQ(mock_get_output_write_count(), 0u) << "port backend bypasses set_output()";
+}
+
+TEST_F(ActuatorPortTest, WritesPortOnlyOnChange) {
+    PORTD.reset(PORTD);
+
+    ptx_actuator_set_gas(true);
+    ptx_actuator_set_igniter(true);
+    EXPECT_EQ(PORTD.writes(), 2u);
+    EXPECT_EQ((uint8_t)PORTD, _BV(PD0) | _BV(PD1) | _BV(PD3) | _BV(PD2) | _BV(PD7));
+
+    // A tick that commands the same outputs again costs no register write
+    for (int i = 0; i < 100; i++) {
+        ptx_actuator_set_gas(true);
+        ptx_actuator_set_igniter(true);
+    }
+    EXPECT_EQ(PORTD.writes(), 2u);
+
+    ptx_actuator_set_igniter(false);
+    EXPECT_EQ(PORTD.writes(), 3u);
+    EXPECT_EQ((uint8_t)PORTD, _BV(PD0) | _BV(PD1) | _BV(PD3) | _BV(PD2));
+}
+
+TEST_F(ActuatorPortTest, ReadBackFollowsPins) {
+    ptx_actuator_set_gas(true);
+    EXPECT_TRUE(ptx_actuator_get_gas_state());
+    EXPECT_FALSE(ptx_actuator_get_igniter_state());
+
+    // Read-back reports the pin, not the shadow
+    PORTD &= (uint8_t)~_BV(PD2);
+    EXPECT_FALSE(ptx_actuator_get_gas_state());
+}
+
+TEST_F(ActuatorPortTest, ZoneChannelsAndEmergencyStop) {
+    ptx_actuator_set_channel(GAS_VALVE_2, true);
+    ptx_actuator_set_channel(IGNITER_2, true);
+    ptx_actuator_set_gas(true);
+    EXPECT_EQ((uint8_t)PORTD & (_BV(PD2) | _BV(PD4) | _BV(PD5)), _BV(PD2) | _BV(PD4) | _BV(PD5));
+
+    ptx_actuator_emergency_stop();
+    EXPECT_EQ((uint8_t)PORTD, _BV(PD0) | _BV(PD1) | _BV(PD3));
+
+    // Shadow resynchronized: switching on again is written
+    uint32_t before = PORTD.writes();
+    ptx_actuator_set_gas(true);
+    EXPECT_EQ(PORTD.writes(), before + 1);
+}
+
+TEST_F(ActuatorPortTest, EmergencyStopIsOneMaskedWrite) {
+    ptx_actuator_set_gas(true);
+    ptx_actuator_set_igniter(true);
+    ptx_actuator_set_channel(GAS_VALVE_2, true);
+    ptx_actuator_set_channel(IGNITER_2, true);
+
+    // Gas and igniter of both zones go off together: no window with one valve open
+    uint32_t before = PORTD.writes();
+    ptx_actuator_emergency_stop();
+    EXPECT_EQ(PORTD.writes(), before + 1);
+    EXPECT_EQ((uint8_t)PORTD, _BV(PD0) | _BV(PD1) | _BV(PD3));
+}
+
+TEST_F(ActuatorPortTest, TimedStopRecordsWorstLatency) {
+    ptx_actuator_reset_stop_stats();
+    const int stops = 1000;
+    for (int i = 0; i < stops; i++) {
+        ptx_actuator_set_gas(true);
+        ptx_actuator_set_igniter(true);
+        ptx_actuator_emergency_stop_from(get_micros());
+        ASSERT_FALSE(ptx_actuator_get_gas_state());
+    }
+
+    ptx_actuator_stop_stats_t stats;
+    ptx_actuator_get_stop_stats(&stats);
+    EXPECT_EQ(stats.count, (uint32_t)stops);
+    EXPECT_LE(stats.last_us, stats.max_us);
+    // Generous host bound (preemption included); the cycle budget is in tools/avr
+    EXPECT_LT(stats.max_us, 1000u);
+
+    // Latency counts from ISR entry, not from the stop call
+    ptx_actuator_emergency_stop_from(get_micros() - 500U);
+    ptx_actuator_get_stop_stats(&stats);
+    EXPECT_GE(stats.last_us, 500u);
+    EXPECT_GE(stats.max_us, 500u);
+
+    ptx_actuator_reset_stop_stats();
+    ptx_actuator_get_stop_stats(&stats);
+    EXPECT_EQ(stats.count, 0u);
+    EXPECT_EQ(stats.max_us, 0u);
+}
+
+TEST_F(ActuatorPortTest, ReadbackMismatchReportsChannels) {
+    ptx_actuator_set_channel(GAS_VALVE_2, true);
+    EXPECT_EQ(ptx_actuator_readback_mismatch(), 0u);
+
+    // Gas 2 drops out behind our back, igniter comes on by itself
+    PORTD.reset((uint8_t)((PORTD & ~_BV(PD4)) | _BV(PD7)));
+    EXPECT_EQ(ptx_actuator_readback_mismatch(),
+              PTX_ACTUATOR_CHANNEL_BIT(GAS_VALVE_2) | PTX_ACTUATOR_CHANNEL_BIT(IGNITER));
+    EXPECT_EQ(PORTD.writes(), 0u) << "verification only reads the pins";
+}
+
+TEST_F(ActuatorPortTest, ResyncDrivesDriftedPinsBack) {
+    ptx_actuator_set_gas(true);
+
+    // Gas drops out and igniter 2 comes on without a command: the shadow is unchanged,
+    // so repeating the command writes nothing
+    PORTD.reset((uint8_t)((PORTD & ~_BV(PD2)) | _BV(PD5)));
+    ptx_actuator_set_gas(true);
+    ptx_actuator_set_channel(IGNITER_2, false);
+    EXPECT_EQ(PORTD.writes(), 0u);
+
+    ptx_actuator_resync();
+    EXPECT_EQ(PORTD.writes(), 1u) << "one masked write restores every burner pin";
+    EXPECT_EQ((uint8_t)PORTD, _BV(PD0) | _BV(PD1) | _BV(PD3) | _BV(PD2));
+    EXPECT_EQ(ptx_actuator_readback_mismatch(), 0u);
+}
+
+class ActuatorPortLoopTest : public ActuatorPortTest {
+protected:
+    void SetUp() override {
+        ActuatorPortTest::SetUp();
+        mock_reset_time(0);
+        ptx_oven_reset_config_to_defaults();
+        mock_set_vref_mv(5000);
+        mock_set_signal_mv(mv_for_temp(5000, 190.0f));  // above target: burner off
+        ptx_oven_control_init();
+        ptx_oven_set_door_state(false);
+        mock_advance_ms(2500);
+    }
+
+    static void run_ticks(unsigned n) {
+        for (unsigned i = 0; i < n; i++) {
+            ptx_oven_control_update();
+            mock_advance_ms(50);
+        }
+    }
+};
+
+TEST_F(ActuatorPortLoopTest, FirstMismatchRewritesDriftedPin) {
+    run_ticks(PTX_ACTUATOR_VERIFY_TICKS);
+
+    // Gas pin comes on behind the shadow's back; the OFF command never changes
+    PORTD.reset((uint8_t)(PORTD | _BV(PD2)));
+    run_ticks(PTX_ACTUATOR_VERIFY_TICKS);
+
+    EXPECT_FALSE(PIND & _BV(PD2)) << "first mismatching sample drives the pin back off";
+    EXPECT_EQ(PORTD.writes(), 1u);
+    EXPECT_EQ(ptx_oven_get_status()->actuator_mismatches, 1u);
+
+    run_ticks(PTX_ACTUATOR_VERIFY_TICKS * PTX_ACTUATOR_VERIFY_LATCH);
+    EXPECT_FALSE(ptx_oven_get_status()->actuator_fault) << "recovered before it could latch";
+}
+
+TEST_F(ActuatorPortLoopTest, LatchWritesOffWhenShadowIsAlreadyOff) {
+    run_ticks(PTX_ACTUATOR_VERIFY_TICKS);
+
+    // Gas pin driven and held high from outside: rewrites cannot clear the readback
+    PORTD.reset((uint8_t)(PORTD | _BV(PD2)));
+    PORTD.hold_high(_BV(PD2));
+    run_ticks(PTX_ACTUATOR_VERIFY_TICKS * PTX_ACTUATOR_VERIFY_LATCH + 1);
+
+    const ptx_oven_status_t* st = ptx_oven_get_status();
+    ASSERT_TRUE(st->actuator_fault);
+    EXPECT_FALSE(st->gas_on);
+    EXPECT_FALSE((uint8_t)PORTD & _BV(PD2)) << "the port latch is driven off";
+    EXPECT_GE(PORTD.writes(), (uint32_t)PTX_ACTUATOR_VERIFY_LATCH + 1) << "each mismatch and the latch write";
+}
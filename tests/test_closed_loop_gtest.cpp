@@ -0,0 +1,221 @@
+/**
+ * @file test_closed_loop_gtest.cpp
+ * @brief Closed-loop tests: controller against the simulated thermal plant
+ */
+#include <gtest/gtest.h>
+#include "ptx_oven_control.h"
+#include "ptx_oven_config.h"
+#include "tests/sim/ptx_plant_sim.h"
+#include "tests/mocks/mock_api.h"
+
+#define PTX_MIN_MS (60UL * 1000UL)
+#define PTX_HOUR_MS (60UL * PTX_MIN_MS)
+
+class ClosedLoopTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ptx_oven_reset_config_to_defaults();
+        ptx_plant_sim_default_params(&params);
+    }
+
+    void TearDown() override { ptx_oven_reset_config_to_defaults(); }
+
+    ptx_plant_params_t params;
+};
+
+TEST_F(ClosedLoopTest, HeatsUpAndHoldsBandForHours) {
+    ptx_plant_sim_init(&params, 50, true);
+
+    ptx_plant_sim_run_until(10 * PTX_MIN_MS);
+    EXPECT_GT(ptx_plant_sim_temp_c(), 160.0f) << "Should be near target after warm-up";
+
+    ptx_plant_sim_reset_extremes();
+    ptx_plant_sim_run_until(4 * PTX_HOUR_MS);
+    const ptx_plant_sim_stats_t* st = ptx_plant_sim_get_stats();
+    // Hysteresis 175..185 C plus overshoot/undershoot from the 3 s dead time
+    EXPECT_GT(st->min_temp_c, 165.0f);
+    EXPECT_LT(st->max_temp_c, 195.0f);
+    EXPECT_GT(st->ignitions, 50u);
+    EXPECT_FALSE(ptx_oven_get_status()->sensor_fault);
+
+    // Idle stretches were skipped: far fewer ticks than a 50 ms loop would run
+    EXPECT_GT(st->skipped_ms, 2 * PTX_HOUR_MS);
+    EXPECT_LT(st->ticks, (uint32_t)(4 * PTX_HOUR_MS / 50 / 2));
+}
+
+TEST_F(ClosedLoopTest, DiscreteEventMatchesFixedStep) {
+    ptx_plant_sim_init(&params, 50, false);
+    ptx_plant_sim_run_until(30 * PTX_MIN_MS);
+    ptx_plant_sim_stats_t fixed = *ptx_plant_sim_get_stats();
+    float fixed_temp = ptx_plant_sim_temp_c();
+
+    ptx_plant_sim_init(&params, 50, true);
+    ptx_plant_sim_run_until(30 * PTX_MIN_MS);
+    const ptx_plant_sim_stats_t* skipped = ptx_plant_sim_get_stats();
+
+    EXPECT_EQ(fixed.skips, 0u);
+    EXPECT_GT(skipped->skips, 0u);
+    EXPECT_LT(skipped->ticks, fixed.ticks / 2);
+    EXPECT_NEAR((double)skipped->ignitions, (double)fixed.ignitions, 2.0);
+    EXPECT_NEAR((double)skipped->gas_on_ms, (double)fixed.gas_on_ms, 0.05 * fixed.gas_on_ms);
+    EXPECT_NEAR(ptx_plant_sim_temp_c(), fixed_temp, 15.0f);
+}
+
+// PI windows switch the burner between the hysteresis thresholds, so the
+// simulator must not skip ticks there
+TEST_F(ClosedLoopTest, DiscreteEventMatchesFixedStepInPiMode) {
+    ptx_oven_set_control_mode(PTX_CONTROL_MODE_PI);
+    ptx_plant_sim_init(&params, 50, false);
+    ptx_plant_sim_run_until(30 * PTX_MIN_MS);
+    ptx_plant_sim_stats_t fixed = *ptx_plant_sim_get_stats();
+    float fixed_temp = ptx_plant_sim_temp_c();
+
+    ptx_plant_sim_init(&params, 50, true);
+    ptx_plant_sim_run_until(30 * PTX_MIN_MS);
+    const ptx_plant_sim_stats_t* discrete = ptx_plant_sim_get_stats();
+
+    EXPECT_EQ(discrete->skips, 0u);
+    EXPECT_EQ(discrete->ignitions, fixed.ignitions);
+    EXPECT_EQ(discrete->gas_on_ms, fixed.gas_on_ms);
+    EXPECT_FLOAT_EQ(ptx_plant_sim_temp_c(), fixed_temp);
+}
+
+TEST_F(ClosedLoopTest, DoorOpenCutsGasAndLosesHeat) {
+    ptx_plant_sim_init(&params, 50, true);
+    ptx_plant_sim_run_until(20 * PTX_MIN_MS);
+    float before = ptx_plant_sim_temp_c();
+
+    ptx_plant_sim_schedule_door(20 * PTX_MIN_MS + 1000, true);
+    ptx_plant_sim_schedule_door(22 * PTX_MIN_MS, false);
+    ptx_plant_sim_run_until(20 * PTX_MIN_MS + 2000);
+    EXPECT_TRUE(ptx_oven_get_status()->door_open);
+    EXPECT_FALSE(mock_get_gas_output());
+
+    ptx_plant_sim_run_until(22 * PTX_MIN_MS - 50);
+    EXPECT_FALSE(mock_get_gas_output());
+    EXPECT_LT(ptx_plant_sim_temp_c(), before - 30.0f) << "Open door should cool the chamber";
+
+    ptx_plant_sim_run_until(30 * PTX_MIN_MS);
+    EXPECT_GT(ptx_plant_sim_temp_c(), 165.0f) << "Should recover after the door closes";
+}
+
+TEST_F(ClosedLoopTest, AutotuneWritesGainsFromRelayCycles) {
+    // Fixed step: the estimator must see every tick of the cycle
+    ptx_plant_sim_init(&params, 50, false);
+    ASSERT_TRUE(ptx_oven_start_autotune(PTX_CONTROL_MODE_PI, 4));
+    ptx_plant_sim_run_until(90 * PTX_MIN_MS);
+
+    const ptx_autotune_t* at = ptx_oven_get_autotune();
+    ASSERT_EQ(at->state, PTX_AUTOTUNE_DONE);
+    // The relay cycle sees the 3 s dead time plus the 1.5 s ignition delay
+    EXPECT_NEAR(at->dead_time_s, 4.5f, 1.0f);
+    EXPECT_GT(at->amplitude_c, ptx_oven_get_temp_delta_c()) << "At least the hysteresis half-band";
+    EXPECT_GT(at->ku, 0.0f);
+    EXPECT_GT(at->tu_s, 2.0f * at->dead_time_s);
+
+    // Gains and mode were written into the shared configuration
+    EXPECT_EQ(ptx_oven_get_control_mode(), PTX_CONTROL_MODE_PI);
+    EXPECT_FLOAT_EQ(ptx_oven_get_pid_kp(), at->kp);
+    EXPECT_FLOAT_EQ(ptx_oven_get_pid_ki(), at->ki);
+    EXPECT_FLOAT_EQ(ptx_oven_get_pid_kd(), 0.0f);
+
+    ptx_plant_sim_reset_extremes();
+    ptx_plant_sim_run_until(150 * PTX_MIN_MS);
+    const ptx_plant_sim_stats_t* st = ptx_plant_sim_get_stats();
+    // The tuned PI loop holds the target
+    EXPECT_GT(st->min_temp_c, 170.0f);
+    EXPECT_LT(st->max_temp_c, 190.0f);
+}
+
+TEST_F(ClosedLoopTest, PredictiveCutoffTrimsOvershootAndUndershoot) {
+    float max_c[2], min_c[2];
+    const uint32_t leads[2] = { 0, 4000 };  // 3 s heat dead time plus filter delay
+    for (int i = 0; i < 2; i++) {
+        ptx_oven_set_predict_lead_ms(leads[i]);
+        ptx_plant_sim_init(&params, 50, false);
+        ptx_plant_sim_run_until(30 * PTX_MIN_MS);
+        ptx_plant_sim_reset_extremes();
+        ptx_plant_sim_run_until(150 * PTX_MIN_MS);
+        max_c[i] = ptx_plant_sim_get_stats()->max_temp_c;
+        min_c[i] = ptx_plant_sim_get_stats()->min_temp_c;
+    }
+    // Without prediction the dead time carries the oven past both thresholds
+    EXPECT_GT(max_c[0], 188.0f);
+    EXPECT_LT(min_c[0], 174.0f);
+    // Cutting and relighting early keeps it within about 1 C of 175..185
+    EXPECT_LT(max_c[1], 187.0f);
+    EXPECT_GT(min_c[1], 174.0f);
+    EXPECT_LT(max_c[1] - 185.0f, 0.5f * (max_c[0] - 185.0f));
+    EXPECT_LT(175.0f - min_c[1], 0.5f * (175.0f - min_c[0]));
+}
+
+TEST_F(ClosedLoopTest, PreignitionStartsHeatingAtOnThreshold) {
+    float min_c[2];
+    int16_t lit_dc[2] = { 0, 0 };
+    bool preignited[2] = { false, false };
+    for (int i = 0; i < 2; i++) {
+        ptx_oven_set_preignite_enabled((uint8_t)i);
+        ptx_plant_sim_init(&params, 50, false);
+        ptx_plant_sim_run_until(30 * PTX_MIN_MS);
+        ptx_plant_sim_reset_extremes();
+        ptx_plant_sim_run_until(150 * PTX_MIN_MS);
+        min_c[i] = ptx_plant_sim_get_stats()->min_temp_c;
+
+        const ptx_transition_ring_t* ring = ptx_oven_get_transitions();
+        for (uint8_t k = 0; k < ptx_transition_ring_count(ring); k++) {
+            ptx_transition_t t;
+            ASSERT_TRUE(ptx_transition_ring_get(ring, k, &t));
+            if (ptx_transition_to(&t) == PTX_HEATING_STATE_HEATING) lit_dc[i] = t.temperature_dc;
+            if (t.cause == PTX_TRANSITION_CAUSE_PREIGNITE) preignited[i] = true;
+        }
+    }
+    // Igniting at 175 C, the oven keeps falling for the 5 s ignition
+    EXPECT_FALSE(preignited[0]);
+    EXPECT_LT(lit_dc[0], 1745);
+    EXPECT_LT(min_c[0], 174.0f);
+    // Pre-scheduled, HEATING starts at the ON threshold and the undershoot is gone
+    EXPECT_TRUE(preignited[1]);
+    EXPECT_GE(lit_dc[1], 1750);
+    EXPECT_LE(lit_dc[1], 1770);
+    EXPECT_GT(min_c[1], 174.5f);
+}
+
+TEST_F(ClosedLoopTest, RecipeStepsOvenThroughPreheatAndHold) {
+    // Recipe 1: preheat to 200 C, hold 10 min; down to 170 C at 10 C/min, hold 12 min
+    ptx_plant_sim_init(&params, 50, false);
+    ptx_plant_sim_run_until(5 * PTX_MIN_MS);
+    ASSERT_TRUE(ptx_oven_start_recipe(1));
+    const ptx_recipe_t* r = ptx_oven_get_recipe();
+
+    uint32_t t = 5 * PTX_MIN_MS;
+    while (r->phase != PTX_RECIPE_PHASE_HOLD && t < 10 * PTX_MIN_MS) ptx_plant_sim_run_until(t += 1000);
+    ASSERT_EQ(r->segment, 0);
+    ASSERT_EQ(r->phase, PTX_RECIPE_PHASE_HOLD);
+    uint32_t hold_start = t;
+    ptx_plant_sim_reset_extremes();
+    while (r->segment == 0) ptx_plant_sim_run_until(t += 1000);
+    EXPECT_NEAR((float)(t - hold_start) / 1000.0f, 600.0f, 2.0f);
+    EXPECT_GT(ptx_plant_sim_get_stats()->min_temp_c, 192.0f);
+    EXPECT_LT(ptx_plant_sim_get_stats()->max_temp_c, 212.0f);
+
+    // The setpoint ramps down at 10 C/min and the thresholds follow it
+    float sp = ptx_recipe_setpoint_c(r);
+    ptx_plant_sim_run_until(t += PTX_MIN_MS);
+    EXPECT_NEAR(sp - ptx_recipe_setpoint_c(r), 10.0f, 0.1f);
+
+    while (r->phase != PTX_RECIPE_PHASE_HOLD) ptx_plant_sim_run_until(t += 1000);
+    hold_start = t;
+    ptx_plant_sim_reset_extremes();
+    while (ptx_recipe_running(r)) ptx_plant_sim_run_until(t += 1000);
+    EXPECT_EQ(r->state, PTX_RECIPE_DONE);
+    EXPECT_NEAR((float)(t - hold_start) / 1000.0f, 720.0f, 2.0f);
+    EXPECT_GT(ptx_plant_sim_get_stats()->min_temp_c, 162.0f);
+    EXPECT_LT(ptx_plant_sim_get_stats()->max_temp_c, 180.0f);
+
+    // Afterwards the configured target (180 C) applies again
+    ptx_plant_sim_run_until(t += 10 * PTX_MIN_MS);
+    ptx_plant_sim_reset_extremes();
+    ptx_plant_sim_run_until(t += 10 * PTX_MIN_MS);
+    EXPECT_GT(ptx_plant_sim_get_stats()->min_temp_c, 170.0f);
+    EXPECT_LT(ptx_plant_sim_get_stats()->max_temp_c, 192.0f);
+}
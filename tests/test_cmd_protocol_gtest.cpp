@@ -0,0 +1,282 @@
+/**
+ * @file test_cmd_protocol_gtest.cpp
+ * @brief Loopback tests for the binary command protocol
+ * @details Requests are encoded with the same framing the host client uses,
+ *          queued on the mock serial RX stream, processed by ptx_cmd_poll(),
+ *          and the transmitted response is decoded again.
+ */
+#include <gtest/gtest.h>
+#include <string.h>
+#include "ptx_cmd_frame.h"
+#include "ptx_cmd_protocol.h"
+#include "ptx_oven_config.h"
+#include "ptx_oven_control.h"
+#include "ptx_oven_status_packed.h"
+#include "ptx_trace.h"
+#include "tests/mocks/mock_api.h"
+
+class CmdProtocolTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        mock_serial_reset();
+        mock_eeprom_erase();
+        mock_reset_time(0);
+        ptx_oven_reset_config_to_defaults();
+        ptx_oven_control_init();
+        ptx_cmd_init();
+    }
+
+    void TearDown() override { ptx_oven_reset_config_to_defaults(); }
+
+    // Feed raw bytes through the device RX path and decode whatever was transmitted
+    bool loopback(const uint8_t* bytes, uint16_t n) {
+        mock_serial_push_rx(bytes, n);
+        for (int i = 0; i < 16; ++i) ptx_cmd_poll();
+
+        uint8_t tx[256];
+        uint16_t tx_len = mock_serial_take_tx(tx, sizeof(tx));
+        ptx_cmd_parser_init(&resp);
+        for (uint16_t i = 0; i < tx_len; ++i) {
+            if (ptx_cmd_parser_feed(&resp, tx[i])) return true;
+        }
+        return false;
+    }
+
+    bool request(uint8_t cmd, const uint8_t* payload, uint8_t len) {
+        uint8_t frame[PTX_CMD_MAX_FRAME];
+        uint8_t n = ptx_cmd_encode_frame(cmd, payload, len, frame);
+        return loopback(frame, n);
+    }
+
+    static uint32_t u32(const uint8_t* p) {
+        return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+    }
+
+    static uint32_t float_bits(float f) {
+        uint32_t u;
+        memcpy(&u, &f, 4);
+        return u;
+    }
+
+    ptx_cmd_parser_t resp;
+};
+
+TEST_F(CmdProtocolTest, SetAndGetFloatField) {
+    uint32_t v = float_bits(195.0f);
+    uint8_t set[5] = { PTX_CMD_FIELD_TEMP_TARGET_C, (uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24) };
+    ASSERT_TRUE(request(PTX_CMD_SET_FIELD, set, sizeof(set)));
+    EXPECT_EQ(resp.cmd, PTX_CMD_SET_FIELD | PTX_CMD_RESPONSE_FLAG);
+    EXPECT_EQ(resp.payload[0], PTX_CMD_RESULT_OK);
+    EXPECT_FLOAT_EQ(ptx_oven_get_temp_target_c(), 195.0f);
+
+    uint8_t get[1] = { PTX_CMD_FIELD_TEMP_TARGET_C };
+    ASSERT_TRUE(request(PTX_CMD_GET_FIELD, get, sizeof(get)));
+    EXPECT_EQ(resp.payload[0], PTX_CMD_RESULT_OK);
+    EXPECT_EQ(resp.payload[1], PTX_CMD_FIELD_TEMP_TARGET_C);
+    EXPECT_EQ(u32(&resp.payload[2]), v);
+}
+
+TEST_F(CmdProtocolTest, OutOfRangeValueIsRejectedBySetter) {
+    uint8_t set[5] = { PTX_CMD_FIELD_IGNITION_DURATION_MS, 0x10, 0x27, 0x00, 0x00 };  // 10000 ms: ok
+    ASSERT_TRUE(request(PTX_CMD_SET_FIELD, set, sizeof(set)));
+    EXPECT_EQ(resp.payload[0], PTX_CMD_RESULT_OK);
+    EXPECT_EQ(ptx_oven_get_ignition_duration_ms(), 10000u);
+
+    uint8_t bad[5] = { PTX_CMD_FIELD_IGNITION_DURATION_MS, 0x64, 0x00, 0x00, 0x00 };  // 100 ms: < 1000
+    ASSERT_TRUE(request(PTX_CMD_SET_FIELD, bad, sizeof(bad)));
+    EXPECT_EQ(resp.payload[0], PTX_CMD_RESULT_REJECTED);
+    EXPECT_EQ(u32(&resp.payload[2]), 10000u) << "response carries the unchanged value";
+}
+
+TEST_F(CmdProtocolTest, UnknownFieldAndCommand) {
+    uint8_t get[1] = { 0xEE };
+    ASSERT_TRUE(request(PTX_CMD_GET_FIELD, get, sizeof(get)));
+    EXPECT_EQ(resp.payload[0], PTX_CMD_RESULT_UNKNOWN_FIELD);
+
+    ASSERT_TRUE(request(0x7F, NULL, 0));
+    EXPECT_EQ(resp.payload[0], PTX_CMD_RESULT_UNKNOWN_CMD);
+
+    ASSERT_TRUE(request(PTX_CMD_GET_FIELD, NULL, 0));
+    EXPECT_EQ(resp.payload[0], PTX_CMD_RESULT_BAD_LENGTH);
+}
+
+TEST_F(CmdProtocolTest, StatusMatchesPackedSnapshot) {
+    ptx_oven_set_door_state(true);
+    ASSERT_TRUE(request(PTX_CMD_GET_STATUS, NULL, 0));
+    ASSERT_EQ(resp.length, 9);
+    ptx_oven_status_packed_t snap;
+    ptx_oven_status_pack(ptx_oven_get_status(), &snap);
+    EXPECT_EQ((int16_t)(resp.payload[1] | (resp.payload[2] << 8)), snap.temperature_dc);
+    EXPECT_EQ(resp.payload[7], snap.flags);
+    EXPECT_TRUE(resp.payload[7] & PTX_STATUS_FLAG_DOOR_OPEN);
+}
+
+TEST_F(CmdProtocolTest, ResyncsAfterNoiseAndCountsCrcErrors) {
+    uint8_t frame[PTX_CMD_MAX_FRAME];
+    uint8_t n = ptx_cmd_encode_frame(PTX_CMD_GET_STATS, NULL, 0, frame);
+
+    // Log text, a corrupted frame, then a good frame
+    uint8_t stream[64];
+    uint16_t len = 0;
+    const char* text = "[100][x.cpp:1] log\n";
+    memcpy(stream, text, strlen(text));
+    len += (uint16_t)strlen(text);
+    memcpy(&stream[len], frame, n);
+    stream[len + n - 1] ^= 0xFF;  // bad CRC
+    len += n;
+    memcpy(&stream[len], frame, n);
+    len += n;
+
+    ASSERT_TRUE(loopback(stream, len));
+    EXPECT_EQ(resp.cmd, PTX_CMD_GET_STATS | PTX_CMD_RESPONSE_FLAG);
+    EXPECT_EQ(resp.payload[1] | (resp.payload[2] << 8), 1) << "frames_ok";
+    EXPECT_EQ(resp.payload[3] | (resp.payload[4] << 8), 1) << "crc_errors";
+    EXPECT_EQ(u32(&resp.payload[9]), ptx_oven_get_compiled_config()->version);
+    EXPECT_EQ(resp.length, 21);
+}
+
+TEST_F(CmdProtocolTest, RepeatedSofDoesNotLoseFrame) {
+    uint8_t stream[PTX_CMD_MAX_FRAME + 1];
+    stream[0] = PTX_CMD_SOF;  // stray SOF right before a real frame
+    uint8_t n = ptx_cmd_encode_frame(PTX_CMD_GET_STATS, NULL, 0, &stream[1]);
+
+    ASSERT_TRUE(loopback(stream, (uint16_t)(n + 1)));
+    EXPECT_EQ(resp.cmd, PTX_CMD_GET_STATS | PTX_CMD_RESPONSE_FLAG);
+    EXPECT_EQ(resp.payload[1] | (resp.payload[2] << 8), 1) << "frames_ok";
+    EXPECT_EQ(resp.payload[5] | (resp.payload[6] << 8), 0) << "length_errors";
+}
+
+TEST_F(CmdProtocolTest, SaveConfigPersists) {
+    ASSERT_TRUE(request(PTX_CMD_SAVE_CONFIG, NULL, 0));
+    EXPECT_EQ(resp.payload[0], PTX_CMD_RESULT_OK);
+    ASSERT_TRUE(request(PTX_CMD_SAVE_CONFIG, NULL, 0));
+    EXPECT_EQ(resp.payload[0], PTX_CMD_RESULT_OK);  // unchanged is still success
+}
+
+TEST_F(CmdProtocolTest, TraceControlStreamsDecodableChunks) {
+    uint8_t on[1] = { 1 };
+    ASSERT_TRUE(request(PTX_CMD_TRACE_CONTROL, on, sizeof(on)));
+    EXPECT_EQ(resp.payload[0], PTX_CMD_RESULT_OK);
+    EXPECT_TRUE(ptx_trace_is_recording());
+
+    for (int i = 0; i < 40; i++) {
+        ptx_oven_control_update();
+        mock_advance_ms(50);
+    }
+    ptx_trace_stop();
+
+    // Reassemble the unsolicited TRACE_DATA frames into one trace
+    uint8_t tx[512];
+    uint16_t tx_len = mock_serial_take_tx(tx, sizeof(tx));
+    uint8_t trace[512];
+    uint32_t trace_len = 0;
+    ptx_cmd_parser_init(&resp);
+    for (uint16_t i = 0; i < tx_len; ++i) {
+        if (ptx_cmd_parser_feed(&resp, tx[i])) {
+            ASSERT_EQ(resp.cmd, PTX_CMD_TRACE_DATA | PTX_CMD_RESPONSE_FLAG);
+            memcpy(&trace[trace_len], resp.payload, resp.length);
+            trace_len += resp.length;
+        }
+    }
+
+    ptx_trace_reader_t reader;
+    ASSERT_TRUE(ptx_trace_reader_init(&reader, trace, trace_len));
+    ptx_trace_event_t ev;
+    int ticks = 0;
+    while (ptx_trace_read_next(&reader, &ev) == PTX_TRACE_READ_OK) ticks++;
+    EXPECT_EQ(ticks, 40);
+    EXPECT_EQ(ev.time_ms, 1950u);
+}
+
+TEST_F(CmdProtocolTest, TransitionsArePagedOldestFirst) {
+    mock_set_vref_mv(5000);
+    mock_set_signal_mv(2000);  // ~140 C: heat demand
+    mock_advance_ms(2500);
+    for (int cycle = 0; cycle < 2; cycle++) {
+        ptx_oven_set_door_state(false);
+        ptx_oven_control_update();
+        ptx_oven_set_door_state(true);
+        mock_advance_ms(50);
+        ptx_oven_control_update();
+        mock_advance_ms(50);
+    }
+    ASSERT_EQ(ptx_transition_ring_count(ptx_oven_get_transitions()), 4u);
+
+    uint8_t start = 0;
+    ASSERT_TRUE(request(PTX_CMD_GET_TRANSITIONS, &start, 1));
+    ASSERT_EQ(resp.payload[0], PTX_CMD_RESULT_OK);
+    EXPECT_EQ(resp.payload[1], 4);  // held
+    EXPECT_EQ(resp.payload[2] | (resp.payload[3] << 8), 4);
+    EXPECT_EQ(resp.payload[4], 0);
+    ASSERT_EQ(resp.length, 5u + PTX_CMD_TRANSITIONS_PER_FRAME * 8u);
+    EXPECT_EQ(u32(&resp.payload[5]), 2500u);
+    EXPECT_EQ(resp.payload[5 + 6], (PTX_HEATING_STATE_IDLE << 4) | PTX_HEATING_STATE_IGNITING);
+    EXPECT_EQ(resp.payload[5 + 7], PTX_TRANSITION_CAUSE_HEAT_DEMAND);
+
+    start = PTX_CMD_TRANSITIONS_PER_FRAME;
+    ASSERT_TRUE(request(PTX_CMD_GET_TRANSITIONS, &start, 1));
+    ASSERT_EQ(resp.length, 5u + 8u);
+    EXPECT_EQ(resp.payload[5 + 6], (PTX_HEATING_STATE_IGNITING << 4) | PTX_HEATING_STATE_IDLE);
+    EXPECT_EQ(resp.payload[5 + 7], PTX_TRANSITION_CAUSE_DOOR_OPEN);
+
+    start = 254;  // past the end: header only
+    ASSERT_TRUE(request(PTX_CMD_GET_TRANSITIONS, &start, 1));
+    EXPECT_EQ(resp.length, 5u);
+
+    ASSERT_TRUE(request(PTX_CMD_GET_TRANSITIONS, NULL, 0));
+    EXPECT_EQ(resp.payload[0], PTX_CMD_RESULT_BAD_LENGTH);
+}
+
+TEST_F(CmdProtocolTest, AutotuneStartsAndReportsSession) {
+    ASSERT_TRUE(request(PTX_CMD_AUTOTUNE, NULL, 0));
+    ASSERT_EQ(resp.payload[0], PTX_CMD_RESULT_OK);
+    ASSERT_EQ(resp.length, 24u);
+    EXPECT_EQ(resp.payload[1], PTX_AUTOTUNE_IDLE);
+
+    uint8_t bad[2] = { PTX_CONTROL_MODE_HYSTERESIS, 4 };
+    ASSERT_TRUE(request(PTX_CMD_AUTOTUNE, bad, 2));
+    EXPECT_EQ(resp.payload[0], PTX_CMD_RESULT_REJECTED);
+    EXPECT_EQ(resp.payload[1], PTX_AUTOTUNE_IDLE);
+
+    uint8_t start[2] = { PTX_CONTROL_MODE_PID, 4 };
+    ASSERT_TRUE(request(PTX_CMD_AUTOTUNE, start, 2));
+    ASSERT_EQ(resp.payload[0], PTX_CMD_RESULT_OK);
+    EXPECT_EQ(resp.payload[1], PTX_AUTOTUNE_RUNNING);
+    EXPECT_EQ(resp.payload[2], 0);
+    EXPECT_EQ(resp.payload[3], 4);
+
+    ASSERT_TRUE(request(PTX_CMD_AUTOTUNE, start, 1));
+    EXPECT_EQ(resp.payload[0], PTX_CMD_RESULT_BAD_LENGTH);
+}
+
+TEST_F(CmdProtocolTest, RecipeStartsStopsAndReports) {
+    ASSERT_TRUE(request(PTX_CMD_RECIPE, NULL, 0));
+    ASSERT_EQ(resp.payload[0], PTX_CMD_RESULT_OK);
+    ASSERT_EQ(resp.length, 10u);
+    EXPECT_EQ(resp.payload[1], PTX_RECIPE_IDLE);
+    EXPECT_EQ(resp.payload[6] | (resp.payload[7] << 8), 1800) << "Configured target while no recipe runs";
+
+    uint8_t unknown = (uint8_t)(ptx_recipe_count() + 1);
+    ASSERT_TRUE(request(PTX_CMD_RECIPE, &unknown, 1));
+    EXPECT_EQ(resp.payload[0], PTX_CMD_RESULT_REJECTED);
+    EXPECT_EQ(resp.payload[1], PTX_RECIPE_IDLE);
+
+    uint8_t id = 1;
+    ASSERT_TRUE(request(PTX_CMD_RECIPE, &id, 1));
+    ASSERT_EQ(resp.payload[0], PTX_CMD_RESULT_OK);
+    EXPECT_EQ(resp.payload[1], PTX_RECIPE_RUNNING);
+    EXPECT_EQ(resp.payload[2], 1);
+    EXPECT_EQ(resp.payload[3], 0);
+    EXPECT_EQ(resp.payload[4], 2);
+    EXPECT_EQ(resp.payload[5], PTX_RECIPE_PHASE_RAMP);
+    EXPECT_NEAR((int16_t)(resp.payload[6] | (resp.payload[7] << 8)), 2000, 1) << "First target before any tick";
+
+    uint8_t stop = 0;
+    ASSERT_TRUE(request(PTX_CMD_RECIPE, &stop, 1));
+    ASSERT_EQ(resp.payload[0], PTX_CMD_RESULT_OK);
+    EXPECT_EQ(resp.payload[1], PTX_RECIPE_ABORTED);
+
+    uint8_t two[2] = { 1, 1 };
+    ASSERT_TRUE(request(PTX_CMD_RECIPE, two, 2));
+    EXPECT_EQ(resp.payload[0], PTX_CMD_RESULT_BAD_LENGTH);
+}
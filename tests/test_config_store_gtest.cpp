@@ -0,0 +1,155 @@
+/**
+ * @file test_config_store_gtest.cpp
+ * @brief Google Test suite for EEPROM configuration persistence
+ */
+#include <gtest/gtest.h>
+#include <string>
+#include <stdio.h>
+#include <string.h>
+#include "ptx_config_store.h"
+#include "ptx_oven_config.h"
+#include "ptx_crc.h"
+#include "tests/mocks/mock_api.h"
+
+class ConfigStoreTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        mock_eeprom_detach_file();
+        mock_eeprom_erase();
+        ptx_oven_reset_config_to_defaults();
+    }
+
+    void TearDown() override {
+        mock_eeprom_detach_file();
+        mock_eeprom_erase();
+        ptx_oven_reset_config_to_defaults();
+    }
+
+    static uint16_t slot_addr(uint8_t slot) {
+        return (uint16_t)(PTX_CONFIG_STORE_BASE_ADDR + slot * PTX_CONFIG_STORE_SLOT_SIZE);
+    }
+};
+
+TEST_F(ConfigStoreTest, EmptyStoreKeepsDefaults) {
+    EXPECT_EQ(ptx_config_store_load(), PTX_CONFIG_STORE_EMPTY);
+    EXPECT_FLOAT_EQ(ptx_oven_get_temp_target_c(), 180.0f);
+    EXPECT_EQ(ptx_config_store_get_sequence(), 0);
+}
+
+TEST_F(ConfigStoreTest, SurvivesPowerCycleWithFileBackedEeprom) {
+    std::string path = ::testing::TempDir() + "ptx_eeprom_power_cycle.bin";
+    remove(path.c_str());
+    ASSERT_TRUE(mock_eeprom_attach_file(path.c_str()));
+
+    ptx_oven_set_temp_target_c(210.0f);
+    ptx_oven_set_purge_time_ms(4000);
+    EXPECT_EQ(ptx_config_store_save(), PTX_CONFIG_STORE_OK);
+
+    // Power cycle: RAM config back to defaults, EEPROM reloaded from the file
+    ptx_oven_reset_config_to_defaults();
+    mock_eeprom_detach_file();
+    mock_eeprom_erase();
+    ASSERT_TRUE(mock_eeprom_attach_file(path.c_str()));
+
+    EXPECT_EQ(ptx_config_store_load(), PTX_CONFIG_STORE_OK);
+    EXPECT_FLOAT_EQ(ptx_oven_get_temp_target_c(), 210.0f);
+    EXPECT_EQ(ptx_oven_get_purge_time_ms(), 4000u);
+    remove(path.c_str());
+}
+
+TEST_F(ConfigStoreTest, ControlModeFieldsRoundTrip) {
+    ptx_oven_set_control_mode(PTX_CONTROL_MODE_PID);
+    ptx_oven_set_pid_gains(0.08f, 0.002f, 1.5f);
+    ptx_oven_set_pid_window_ms(45000);
+    ptx_oven_set_predict_lead_ms(4000);
+    ptx_oven_set_preignite_enabled(1);
+    EXPECT_EQ(ptx_config_store_save(), PTX_CONFIG_STORE_OK);
+
+    ptx_oven_reset_config_to_defaults();
+    EXPECT_EQ(ptx_config_store_load(), PTX_CONFIG_STORE_OK);
+    EXPECT_EQ(ptx_oven_get_control_mode(), PTX_CONTROL_MODE_PID);
+    EXPECT_FLOAT_EQ(ptx_oven_get_pid_kp(), 0.08f);
+    EXPECT_FLOAT_EQ(ptx_oven_get_pid_ki(), 0.002f);
+    EXPECT_FLOAT_EQ(ptx_oven_get_pid_kd(), 1.5f);
+    EXPECT_EQ(ptx_oven_get_pid_window_ms(), 45000u);
+    EXPECT_EQ(ptx_oven_get_predict_lead_ms(), 4000u);
+    EXPECT_EQ(ptx_oven_get_preignite_enabled(), 1u);
+}
+
+TEST_F(ConfigStoreTest, UnchangedConfigIsNotRewritten) {
+    EXPECT_EQ(ptx_config_store_save(), PTX_CONFIG_STORE_OK);
+    uint32_t writes = mock_eeprom_get_total_writes();
+    EXPECT_EQ(ptx_config_store_save(), PTX_CONFIG_STORE_UNCHANGED);
+    EXPECT_EQ(mock_eeprom_get_total_writes(), writes);
+}
+
+TEST_F(ConfigStoreTest, SavesRotateAcrossSlots) {
+    for (int i = 0; i < 2 * (int)PTX_CONFIG_STORE_SLOTS; ++i) {
+        ptx_oven_set_temp_target_c(100.0f + (float)i);
+        EXPECT_EQ(ptx_config_store_save(), PTX_CONFIG_STORE_OK);
+    }
+    EXPECT_EQ(ptx_config_store_get_sequence(), 2 * PTX_CONFIG_STORE_SLOTS);
+
+    // Every slot's sequence byte was written exactly twice
+    for (uint8_t slot = 0; slot < PTX_CONFIG_STORE_SLOTS; ++slot) {
+        EXPECT_EQ(mock_eeprom_get_write_count(slot_addr(slot) + 4), 2u) << "slot " << (int)slot;
+    }
+
+    ptx_oven_reset_config_to_defaults();
+    EXPECT_EQ(ptx_config_store_load(), PTX_CONFIG_STORE_OK);
+    EXPECT_FLOAT_EQ(ptx_oven_get_temp_target_c(), 107.0f);
+}
+
+TEST_F(ConfigStoreTest, CorruptNewestRecordFallsBackToPrevious) {
+    ptx_oven_set_temp_target_c(150.0f);
+    EXPECT_EQ(ptx_config_store_save(), PTX_CONFIG_STORE_OK);  // slot 0
+    ptx_oven_set_temp_target_c(160.0f);
+    EXPECT_EQ(ptx_config_store_save(), PTX_CONFIG_STORE_OK);  // slot 1
+
+    // Flip one payload byte of slot 1 (simulates a torn write)
+    uint16_t addr = slot_addr(1) + PTX_CONFIG_STORE_HEADER_SIZE + 3;
+    eeprom_update(addr, (uint8_t)(eeprom_read(addr) ^ 0x5A));
+
+    ptx_oven_reset_config_to_defaults();
+    EXPECT_EQ(ptx_config_store_load(), PTX_CONFIG_STORE_OK);
+    EXPECT_FLOAT_EQ(ptx_oven_get_temp_target_c(), 150.0f);
+}
+
+TEST_F(ConfigStoreTest, MigratesSchemaV1Record) {
+    // v1 payload: 4 x u32 timings, then vref min/max, target, delta as f32
+    uint8_t payload[32];
+    const uint32_t timings[4] = { 6000, 2000, 1500, 4000 };
+    const float floats[4] = { 4.6f, 5.4f, 190.0f, 3.0f };
+    for (int i = 0; i < 4; ++i) {
+        for (int b = 0; b < 4; ++b) payload[i * 4 + b] = (uint8_t)(timings[i] >> (8 * b));
+        uint32_t u;
+        memcpy(&u, &floats[i], 4);
+        for (int b = 0; b < 4; ++b) payload[16 + i * 4 + b] = (uint8_t)(u >> (8 * b));
+    }
+    uint8_t header[8] = { 'P', 'X', 1, sizeof(payload), 7, 0, 0, 0 };
+    uint16_t crc = ptx_crc16_update(PTX_CRC16_INIT, &header[2], 4);
+    crc = ptx_crc16_update(crc, payload, sizeof(payload));
+    header[6] = (uint8_t)crc;
+    header[7] = (uint8_t)(crc >> 8);
+    for (int i = 0; i < 8; ++i) eeprom_update(slot_addr(2) + i, header[i]);
+    for (int i = 0; i < 32; ++i) eeprom_update(slot_addr(2) + 8 + i, payload[i]);
+
+    EXPECT_EQ(ptx_config_store_load(), PTX_CONFIG_STORE_MIGRATED);
+    EXPECT_EQ(ptx_oven_get_ignition_duration_ms(), 6000u);
+    EXPECT_EQ(ptx_oven_get_auto_resume_delay_ms(), 4000u);
+    EXPECT_FLOAT_EQ(ptx_oven_get_vref_min_v(), 4.6f);
+    EXPECT_FLOAT_EQ(ptx_oven_get_temp_target_c(), 190.0f);
+    // Fields added in v2 take their defaults
+    EXPECT_EQ(ptx_oven_get_max_ignition_attempts(), 3);
+    EXPECT_EQ(ptx_oven_get_purge_time_ms(), 2500u);
+    // ...and so do the v3 control mode fields
+    EXPECT_EQ(ptx_oven_get_control_mode(), PTX_CONTROL_MODE_HYSTERESIS);
+    EXPECT_EQ(ptx_oven_get_pid_window_ms(), 30000u);
+    EXPECT_EQ(ptx_oven_get_predict_lead_ms(), 0u);
+    EXPECT_EQ(ptx_oven_get_preignite_enabled(), 0u);
+
+    // Next save writes the current schema into the following slot
+    EXPECT_EQ(ptx_config_store_save(), PTX_CONFIG_STORE_OK);
+    EXPECT_EQ(ptx_config_store_get_sequence(), 8);
+    EXPECT_EQ(eeprom_read(slot_addr(3) + 2), PTX_CONFIG_STORE_SCHEMA);
+}
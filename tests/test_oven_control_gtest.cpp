@@ -4,6 +4,10 @@
  */
 #include <gtest/gtest.h>
 #include "ptx_oven_control.h"
+#include "ptx_oven_config.h"
+#include "ptx_oven_status_packed.h"
+#include "ptx_oven_profile.h"
+#include "ptx_actuator.h"
 #include "tests/mocks/mock_api.h"
 
 // Helper function to convert temperature to sensor millivolt reading
@@ -23,7 +27,8 @@ protected:
     }
 
     void TearDown() override {
-        // Cleanup if needed
+        mock_set_output_stuck(GAS_VALVE, -1);
+        mock_set_output_stuck(IGNITER, -1);
     }
 };
 
@@ -136,6 +141,33 @@ TEST_F(OvenControlTest, SensorFaultTimedDetection) {
     EXPECT_FALSE(st->igniter_on) << "Igniter should turn OFF on sensor fault";
 }
 
+// The 10-90% window is inclusive: readings exactly on a limit are valid
+TEST_F(OvenControlTest, SignalWindowLimitsAreInclusive) {
+    const uint16_t valid[] = { 500, 4500 };     // 10% and 90% of 5000 mV
+    const uint16_t invalid[] = { 499, 4501 };
+    mock_set_vref_mv(5000);
+    for (uint16_t signal_mv : valid) {
+        ptx_oven_control_init();
+        mock_set_signal_mv(signal_mv);
+        for (int i = 0; i < 50; ++i) {  // 5 s, well past the 1 s fault window
+            ptx_oven_control_update();
+            mock_advance_ms(100);
+        }
+        EXPECT_FALSE(ptx_oven_get_status()->signal_fault) << signal_mv << " mV";
+        EXPECT_FALSE(ptx_oven_get_status()->sensor_fault) << signal_mv << " mV";
+    }
+    for (uint16_t signal_mv : invalid) {
+        ptx_oven_control_init();
+        mock_set_signal_mv(signal_mv);
+        for (int i = 0; i < 50; ++i) {
+            ptx_oven_control_update();
+            mock_advance_ms(100);
+        }
+        EXPECT_TRUE(ptx_oven_get_status()->signal_fault) << signal_mv << " mV";
+        EXPECT_TRUE(ptx_oven_get_status()->sensor_fault) << signal_mv << " mV";
+    }
+}
+
 TEST_F(OvenControlTest, AutoResumeAfterValidWindow) {
     mock_set_vref_mv(5000);
     mock_set_signal_mv(mv_for_temp(5000, 160.0f));
@@ -254,8 +286,680 @@ TEST_F(OvenControlTest, ManualResetFromLockout) {
     EXPECT_FALSE(st->ignition_lockout) << "Lockout flag should remain clear";
 }
 
+TEST_F(OvenControlTest, OutputsWrittenOnlyOnChange) {
+    mock_set_vref_mv(5000);
+    mock_set_signal_mv(mv_for_temp(5000, 160.0f));
+    mock_advance_ms(2500);
+
+    // Idle -> igniting: gas and igniter switch on
+    mock_reset_output_write_count();
+    ptx_oven_control_update();
+    EXPECT_EQ(mock_get_output_write_count(), 2u);
+    EXPECT_TRUE(mock_get_gas_output());
+    EXPECT_TRUE(mock_get_igniter_output());
+
+    // Steady igniting: nothing changes, nothing written
+    mock_reset_output_write_count();
+    for (int i = 0; i < 50; i++) {
+        mock_advance_ms(50);
+        ptx_oven_control_update();
+    }
+    EXPECT_EQ(mock_get_output_write_count(), 0u);
+
+    // Igniting -> heating: only the igniter switches off
+    mock_advance_ms(5000);
+    ptx_oven_control_update();
+    EXPECT_EQ(mock_get_output_write_count(), 1u);
+    EXPECT_TRUE(mock_get_gas_output());
+    EXPECT_FALSE(mock_get_igniter_output());
+    EXPECT_TRUE(ptx_actuator_get_gas_state());
+    EXPECT_FALSE(ptx_actuator_get_igniter_state());
+
+    // Emergency stop writes every channel even when the shadow says off
+    mock_reset_output_write_count();
+    ptx_actuator_emergency_stop();
+    EXPECT_EQ(mock_get_output_write_count(), 4u);
+    EXPECT_FALSE(mock_get_gas_output());
+}
+
+TEST_F(OvenControlTest, OutputsRewrittenEveryResyncPeriod) {
+    mock_set_vref_mv(5000);
+    mock_set_signal_mv(mv_for_temp(5000, 160.0f));
+    mock_advance_ms(2500);
+    ptx_oven_control_update();  // ignite: gas and igniter on
+
+    // Steady commands for one resync period (shorter than the ignition time):
+    // a single rewrite of every output, levels unchanged
+    mock_reset_output_write_count();
+    for (unsigned i = 0; i < PTX_ACTUATOR_RESYNC_TICKS; i++) {
+        mock_advance_ms(10);
+        ptx_oven_control_update();
+    }
+    EXPECT_EQ(mock_get_output_write_count(), 4u);
+    EXPECT_TRUE(mock_get_gas_output());
+    EXPECT_TRUE(mock_get_igniter_output());
+}
+
+TEST_F(OvenControlTest, ActuatorReadbackMismatchLatchesFault) {
+    mock_set_vref_mv(5000);
+    mock_set_signal_mv(mv_for_temp(5000, 160.0f));
+    mock_advance_ms(2500);
+
+    // Gas valve pin stuck low: commanded on, reads back off
+    mock_set_output_stuck(GAS_VALVE, 0);
+    EXPECT_EQ(ptx_actuator_readback_mismatch(), 0u) << "Nothing commanded yet";
+
+    const ptx_oven_status_t* st = ptx_oven_get_status();
+    int ticks = 0;
+    while (!st->actuator_fault && ticks < 100) {
+        ptx_oven_control_update();
+        mock_advance_ms(50);
+        ticks++;
+    }
+    ASSERT_TRUE(st->actuator_fault) << "Stuck valve should latch an actuator fault";
+    EXPECT_LE(ticks, (int)(PTX_ACTUATOR_VERIFY_TICKS * PTX_ACTUATOR_VERIFY_LATCH + 1));
+    EXPECT_EQ(st->actuator_mismatches, PTX_ACTUATOR_VERIFY_LATCH);
+    EXPECT_FALSE(st->gas_on) << "Actuator fault forces shutdown";
+    EXPECT_FALSE(st->igniter_on);
+    EXPECT_FALSE(mock_get_gas_output());
+
+    ptx_oven_status_packed_t packed;
+    ptx_oven_status_pack(st, &packed);
+    EXPECT_TRUE(packed.flags & PTX_STATUS_FLAG_ACTUATOR_FAULT);
+
+    // Pins now agree (valve commanded off); fault holds for auto_resume_delay_ms
+    mock_set_output_stuck(GAS_VALVE, -1);
+    for (int i = 0; i < 40; i++) {
+        mock_advance_ms(50);
+        ptx_oven_control_update();
+    }
+    EXPECT_TRUE(st->actuator_fault) << "Fault should hold before the resume delay";
+
+    for (int i = 0; i < 40; i++) {
+        mock_advance_ms(50);
+        ptx_oven_control_update();
+    }
+    EXPECT_FALSE(st->actuator_fault) << "Fault should clear after matching readback";
+    EXPECT_EQ(st->actuator_mismatches, PTX_ACTUATOR_VERIFY_LATCH) << "Counter is not reset by recovery";
+
+    mock_advance_ms(50);
+    ptx_oven_control_update();
+    EXPECT_TRUE(st->gas_on) << "Heating resumes";
+}
+
+TEST(OvenStatusPackedTest, RoundTripPreservesFields) {
+    ptx_oven_status_t in = {};
+    in.vref_volts = 4.987f;
+    in.signal_volts = 2.345f;
+    in.temperature_c = 176.34f;
+    in.door_open = false;
+    in.gas_on = true;
+    in.igniter_on = true;
+    in.state = PTX_HEATING_STATE_IGNITING;
+    in.signal_fault = true;
+    in.ignition_attempt = 3;
+
+    ptx_oven_status_packed_t packed;
+    ptx_oven_status_pack(&in, &packed);
+    EXPECT_EQ(sizeof(packed), 8u);
+    EXPECT_EQ(packed.temperature_dc, 1763);
+    EXPECT_EQ(packed.vref_mv, 4987);
+    EXPECT_EQ(packed.signal_mv, 2345);
+    EXPECT_EQ(packed.flags, PTX_STATUS_FLAG_GAS_ON | PTX_STATUS_FLAG_IGNITER_ON | PTX_STATUS_FLAG_SIGNAL_FAULT);
+
+    ptx_oven_status_t out = {};
+    ptx_oven_status_unpack(&packed, &out);
+    EXPECT_NEAR(out.temperature_c, 176.3f, 0.001f);
+    EXPECT_NEAR(out.vref_volts, 4.987f, 0.0005f);
+    EXPECT_NEAR(out.signal_volts, 2.345f, 0.0005f);
+    EXPECT_TRUE(out.gas_on);
+    EXPECT_TRUE(out.igniter_on);
+    EXPECT_TRUE(out.signal_fault);
+    EXPECT_FALSE(out.door_open);
+    EXPECT_FALSE(out.sensor_fault);
+    EXPECT_EQ(out.state, PTX_HEATING_STATE_IGNITING);
+    EXPECT_EQ(out.ignition_attempt, 3);
+}
+
+TEST(OvenStatusPackedTest, SaturatesOutOfRangeValues) {
+    ptx_oven_status_t in = {};
+    in.temperature_c = -10.04f;
+    in.vref_volts = -1.0f;
+    in.signal_volts = 100.0f;
+    in.state = PTX_HEATING_STATE_LOCKOUT;
+    in.ignition_lockout = true;
+    in.ignition_attempt = 200;
+
+    ptx_oven_status_packed_t packed;
+    ptx_oven_status_pack(&in, &packed);
+    EXPECT_EQ(packed.temperature_dc, -100);
+    EXPECT_EQ(packed.vref_mv, 0);
+    EXPECT_EQ(packed.signal_mv, 65535);
+    EXPECT_EQ(ptx_oven_status_packed_state(&packed), PTX_HEATING_STATE_LOCKOUT);
+    EXPECT_EQ(ptx_oven_status_packed_attempt(&packed), PTX_STATUS_ATTEMPT_MAX);
+    EXPECT_TRUE(packed.flags & PTX_STATUS_FLAG_IGNITION_LOCKOUT);
+}
+
+class OvenConfigTest : public ::testing::Test {
+protected:
+    void SetUp() override { ptx_oven_reset_config_to_defaults(); }
+    void TearDown() override {
+        ptx_oven_config_unpin();
+        ptx_oven_reset_config_to_defaults();
+    }
+};
+
+TEST_F(OvenConfigTest, PinnedSlotIsNotModifiedByWriter) {
+    const ptx_oven_config_t* pinned = ptx_oven_config_pin();
+    EXPECT_FLOAT_EQ(pinned->temp_target_c, 180.0f);
+
+    // First write lands in the inactive slot and is published
+    EXPECT_TRUE(ptx_oven_set_temp_target_c(200.0f));
+    EXPECT_FLOAT_EQ(ptx_oven_get_temp_target_c(), 200.0f);
+    EXPECT_FLOAT_EQ(pinned->temp_target_c, 180.0f) << "Pinned slot must stay untouched";
+
+    // Second write in the same pin window would target the pinned slot: rejected
+    ptx_oven_config_t cfg = *ptx_oven_get_config();
+    cfg.temp_delta_c = 3.0f;
+    EXPECT_FALSE(ptx_oven_set_config(&cfg));
+    EXPECT_FALSE(ptx_oven_set_temp_delta_c(3.0f)) << "Busy setters must report failure";
+    EXPECT_FALSE(ptx_oven_reset_config_to_defaults());
+    EXPECT_FLOAT_EQ(pinned->temp_target_c, 180.0f);
+    EXPECT_FLOAT_EQ(pinned->temp_delta_c, 5.0f);
+
+    ptx_oven_config_unpin();
+    EXPECT_TRUE(ptx_oven_set_config(&cfg));
+    EXPECT_FLOAT_EQ(ptx_oven_get_temp_delta_c(), 3.0f);
+    EXPECT_FLOAT_EQ(ptx_oven_get_temp_target_c(), 200.0f);
+}
+
+TEST_F(OvenConfigTest, InvalidConfigIsNotPublished) {
+    ptx_oven_config_t cfg = *ptx_oven_get_config();
+    cfg.vref_min_v = 6.0f;  // min above max
+    EXPECT_FALSE(ptx_oven_config_validate(&cfg));
+    EXPECT_FALSE(ptx_oven_set_config(&cfg));
+    EXPECT_FLOAT_EQ(ptx_oven_get_vref_min_v(), 4.5f);
+
+    EXPECT_FALSE(ptx_oven_set_temp_target_c(400.0f));  // out of range
+    EXPECT_FLOAT_EQ(ptx_oven_get_temp_target_c(), 180.0f);
+}
+
+TEST_F(OvenConfigTest, CompiledThresholdsFollowPublishedConfig) {
+    const ptx_oven_config_compiled_t* cc = ptx_oven_get_compiled_config();
+    uint32_t version = cc->version;
+    EXPECT_EQ(cc->vref_min_mv, 4500);
+    EXPECT_EQ(cc->vref_max_mv, 5500);
+    EXPECT_EQ(cc->signal_lo_q16, 6553u);   // 10% of vref, rounded down
+    EXPECT_EQ(cc->signal_hi_q16, 58982u);  // 90% of vref, rounded down
+    EXPECT_EQ(cc->temp_on_q16, ptx_oven_temp_to_ratio_q16(175.0f));
+    EXPECT_EQ(cc->temp_off_q16, ptx_oven_temp_to_ratio_q16(185.0f));
+
+    ptx_oven_set_temp_target_c(150.0f);
+    cc = ptx_oven_get_compiled_config();
+    EXPECT_GT(cc->version, version);
+    EXPECT_EQ(cc->temp_on_q16, ptx_oven_temp_to_ratio_q16(145.0f));
+    EXPECT_EQ(cc->temp_off_q16, ptx_oven_temp_to_ratio_q16(155.0f));
+}
+
+TEST_F(OvenConfigTest, ControlUsesCompiledTargetThresholds) {
+    ptx_oven_set_temp_target_c(150.0f);
+    mock_reset_time(0);
+    ptx_oven_control_init();
+    ptx_oven_set_door_state(false);
+    mock_set_vref_mv(5000);
+    mock_set_signal_mv(mv_for_temp(5000, 160.0f));  // above new ON threshold (145 C)
+    mock_advance_ms(2500);
+    for (int i = 0; i < 5; ++i) {
+        ptx_oven_control_update();
+        mock_advance_ms(50);
+    }
+    EXPECT_FALSE(ptx_oven_get_status()->gas_on);
+
+    mock_set_signal_mv(mv_for_temp(5000, 140.0f));
+    for (int i = 0; i < 5; ++i) {
+        ptx_oven_control_update();
+        mock_advance_ms(50);
+    }
+    EXPECT_TRUE(ptx_oven_get_status()->gas_on);
+}
+
+TEST(OvenProfileTest, ProfileFoldsToSameThresholdsAsRuntimeCompile) {
+    typedef ptx_oven_profile_view<PTX_OVEN_PROFILE_BAKERY_180C> view;
+    static_assert(view::temp_on_q16() < view::temp_off_q16(), "hysteresis band must be non-empty");
+
+    ptx_oven_config_t cfg;
+    view::to_config(&cfg);
+    ASSERT_TRUE(ptx_oven_config_validate(&cfg));
+
+    ptx_oven_config_compiled_t cc;
+    ptx_oven_config_compile(&cfg, &cc);
+    EXPECT_EQ(view::vref_min_mv(), cc.vref_min_mv);
+    EXPECT_EQ(view::vref_max_mv(), cc.vref_max_mv);
+    EXPECT_EQ(view::signal_lo_q16(), cc.signal_lo_q16);
+    EXPECT_EQ(view::signal_hi_q16(), cc.signal_hi_q16);
+    EXPECT_EQ(view::temp_on_q16(), cc.temp_on_q16);
+    EXPECT_EQ(view::temp_off_q16(), cc.temp_off_q16);
+    EXPECT_EQ(view::flame_rise_q16(), cc.flame_rise_q16);
+}
+
+TEST(OvenCtxTest, InstancesAreIndependent) {
+    ptx_oven_ctx_t a, b;
+    ptx_oven_ctx_init(&a);
+    ptx_oven_ctx_init(&b);
+    ptx_oven_ctx_set_door_state(&b, true);
+    ptx_actuator_set_gas(false);
+
+    uint16_t cold_mv = mv_for_temp(5000, 150.0f);
+    for (uint32_t t = 2000; t <= 2500; t += 50) {
+        ptx_oven_ctx_step(&a, t, 5000, cold_mv);
+        ptx_oven_ctx_step(&b, t, 5000, cold_mv);
+    }
+    EXPECT_EQ(ptx_oven_ctx_get_status(&a)->state, PTX_HEATING_STATE_IGNITING);
+    EXPECT_TRUE(ptx_oven_ctx_get_status(&a)->gas_on);
+    EXPECT_EQ(ptx_oven_ctx_get_status(&b)->state, PTX_HEATING_STATE_IDLE);
+    EXPECT_FALSE(ptx_oven_ctx_get_status(&b)->gas_on);
+
+    // Stepping an instance does not drive the hardware outputs
+    EXPECT_FALSE(mock_get_gas_output());
+}
+
+TEST(OvenCtxTest, PrivateConfigOverridesSharedConfig) {
+    ptx_oven_reset_config_to_defaults();
+    ptx_oven_ctx_t ctx;
+    ptx_oven_ctx_init(&ctx);
+
+    ptx_oven_config_t cfg;
+    ptx_oven_get_default_config(&cfg);
+    cfg.temp_target_c = 130.0f;
+    ASSERT_TRUE(ptx_oven_ctx_set_config(&ctx, &cfg));
+
+    // 150 C is below the shared ON threshold (175 C) but above this instance's (125 C)
+    uint16_t mv = mv_for_temp(5000, 150.0f);
+    for (uint32_t t = 2000; t <= 2500; t += 50) {
+        ptx_oven_ctx_step(&ctx, t, 5000, mv);
+    }
+    EXPECT_FALSE(ptx_oven_ctx_get_status(&ctx)->gas_on);
+
+    cfg.temp_target_c = 400.0f;
+    EXPECT_FALSE(ptx_oven_ctx_set_config(&ctx, &cfg));
+    EXPECT_TRUE(ptx_oven_ctx_set_config(&ctx, NULL));
+    ptx_oven_ctx_step(&ctx, 2550, 5000, mv);
+    EXPECT_TRUE(ptx_oven_ctx_get_status(&ctx)->gas_on);
+}
+
 // Main function for running all tests
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
 }
+
+TEST_F(OvenControlTest, TransitionRingRecordsCauses) {
+    mock_set_vref_mv(5000);
+    mock_set_signal_mv(mv_for_temp(5000, 160.0f));
+    mock_advance_ms(2500);
+
+    ptx_oven_control_update();          // IDLE -> IGNITING
+    mock_advance_ms(5000);
+    ptx_oven_control_update();          // IGNITING -> HEATING
+    for (int i = 0; i < 10; i++) {      // steady: nothing recorded
+        mock_advance_ms(50);
+        ptx_oven_control_update();
+    }
+    ptx_oven_set_door_state(true);
+    ptx_oven_control_update();          // HEATING -> IDLE
+
+    const ptx_transition_ring_t* ring = ptx_oven_get_transitions();
+    ASSERT_EQ(ptx_transition_ring_count(ring), 3u);
+
+    ptx_transition_t t;
+    ASSERT_TRUE(ptx_transition_ring_get(ring, 0, &t));
+    EXPECT_EQ(t.time_ms, 2500u);
+    EXPECT_EQ(ptx_transition_from(&t), PTX_HEATING_STATE_IDLE);
+    EXPECT_EQ(ptx_transition_to(&t), PTX_HEATING_STATE_IGNITING);
+    EXPECT_EQ(t.cause, PTX_TRANSITION_CAUSE_HEAT_DEMAND);
+    EXPECT_NEAR(t.temperature_dc, 1600, 5);
+
+    ASSERT_TRUE(ptx_transition_ring_get(ring, 1, &t));
+    EXPECT_EQ(t.time_ms, 7500u);
+    EXPECT_EQ(ptx_transition_to(&t), PTX_HEATING_STATE_HEATING);
+    EXPECT_EQ(t.cause, PTX_TRANSITION_CAUSE_IGNITION_LIT);
+
+    ASSERT_TRUE(ptx_transition_ring_get(ring, 2, &t));
+    EXPECT_EQ(ptx_transition_from(&t), PTX_HEATING_STATE_HEATING);
+    EXPECT_EQ(ptx_transition_to(&t), PTX_HEATING_STATE_IDLE);
+    EXPECT_EQ(t.cause, PTX_TRANSITION_CAUSE_DOOR_OPEN);
+    EXPECT_FALSE(ptx_transition_ring_get(ring, 3, &t));
+}
+
+TEST(TransitionRingTest, KeepsNewestEntriesOldestFirst) {
+    ptx_transition_ring_t ring;
+    ptx_transition_ring_init(&ring);
+    const unsigned pushed = PTX_TRANSITION_RING_DEPTH + 3;
+    for (unsigned i = 0; i < pushed; i++) {
+        ptx_transition_ring_push(&ring, 100 * i, PTX_HEATING_STATE_IDLE, PTX_HEATING_STATE_IGNITING,
+                                 PTX_TRANSITION_CAUSE_HEAT_DEMAND, (int16_t)i);
+    }
+    EXPECT_EQ(ptx_transition_ring_count(&ring), PTX_TRANSITION_RING_DEPTH);
+    EXPECT_EQ(ring.total, pushed);
+
+    ptx_transition_t t;
+    ASSERT_TRUE(ptx_transition_ring_get(&ring, 0, &t));
+    EXPECT_EQ(t.temperature_dc, 3);
+    ASSERT_TRUE(ptx_transition_ring_get(&ring, PTX_TRANSITION_RING_DEPTH - 1, &t));
+    EXPECT_EQ(t.temperature_dc, (int16_t)(pushed - 1));
+    EXPECT_EQ(t.time_ms, 100u * (pushed - 1));
+}
+
+TEST(PidTest, WindowRespectsMinimumOnAndOffTimes) {
+    // 30 s window, 5 s ignition, 2.5 s purge
+    EXPECT_EQ(ptx_pid_window_on_ms(0.0f, 30000, 5000, 2500), 0u);
+    EXPECT_EQ(ptx_pid_window_on_ms(0.05f, 30000, 5000, 2500), 0u);      // 1.5 s: skipped
+    EXPECT_EQ(ptx_pid_window_on_ms(0.10f, 30000, 5000, 2500), 5000u);   // 3 s: minimum run
+    EXPECT_EQ(ptx_pid_window_on_ms(0.50f, 30000, 5000, 2500), 15000u);
+    EXPECT_EQ(ptx_pid_window_on_ms(0.95f, 30000, 5000, 2500), 27500u);  // 1.5 s gap: widened
+    EXPECT_EQ(ptx_pid_window_on_ms(0.98f, 30000, 5000, 2500), 30000u);  // 0.6 s gap: stays lit
+    EXPECT_EQ(ptx_pid_window_on_ms(1.5f, 30000, 5000, 2500), 30000u);
+}
+
+TEST(PidTest, IntegralDoesNotWindUpWhileSaturated) {
+    ptx_pid_t pid;
+    ptx_pid_init(&pid);
+    // Cold start: 150 C below target saturates the output for 10 minutes
+    uint32_t now = 0;
+    for (int i = 0; i < 600; i++, now += PTX_PID_SAMPLE_MS) {
+        EXPECT_FLOAT_EQ(ptx_pid_update(&pid, now, 180.0f, 30.0f, 0.05f, 0.0005f, 0.0f), 1.0f);
+    }
+    EXPECT_LE(pid.integral, 1.0f);
+
+    // At target the output is the integral alone; it must not still hold full duty
+    // from the saturated phase
+    float duty = ptx_pid_update(&pid, now, 180.0f, 180.0f, 0.05f, 0.0005f, 0.0f);
+    EXPECT_FLOAT_EQ(duty, pid.integral);
+    EXPECT_LT(duty, 0.1f);
+}
+
+TEST(PidTest, BurnerWindowIsLatchedPerWindow) {
+    ptx_pid_t pid;
+    ptx_pid_init(&pid);
+    ptx_pid_update(&pid, 0, 180.0f, 176.0f, 0.1f, 0.0f, 0.0f);  // 40 % duty
+    EXPECT_TRUE(ptx_pid_burner_demand(&pid, 0, 30000, 5000, 2500));
+    EXPECT_TRUE(ptx_pid_burner_demand(&pid, 11999, 30000, 5000, 2500));
+
+    // A duty change inside the window takes effect at the next window
+    ptx_pid_update(&pid, 12000, 180.0f, 170.0f, 0.1f, 0.0f, 0.0f);  // 100 %
+    EXPECT_FALSE(ptx_pid_burner_demand(&pid, 12000, 30000, 5000, 2500));
+    EXPECT_TRUE(ptx_pid_burner_demand(&pid, 30000, 30000, 5000, 2500));
+    EXPECT_TRUE(ptx_pid_burner_demand(&pid, 59999, 30000, 5000, 2500));
+}
+
+TEST_F(OvenControlTest, PiModeCyclesBurnerInWindows) {
+    ptx_oven_set_control_mode(PTX_CONTROL_MODE_PI);
+    ptx_oven_set_pid_gains(0.1f, 0.0f, 0.0f);
+    ptx_oven_set_pid_window_ms(30000);
+    ptx_oven_control_init();
+    ptx_oven_set_door_state(false);
+
+    // 176 C: inside the hysteresis band (no demand there), 40 % duty in PI mode
+    mock_set_vref_mv(5000);
+    mock_set_signal_mv(mv_for_temp(5000, 176.0f));
+    mock_advance_ms(2500);
+    for (int i = 0; i < 5; ++i) {
+        ptx_oven_control_update();
+        mock_advance_ms(50);
+    }
+    const ptx_oven_status_t* st = ptx_oven_get_status();
+    EXPECT_TRUE(st->gas_on) << "PI demand should light the burner inside the band";
+    EXPECT_NEAR(st->heat_duty_pct, 40, 1);
+
+    // Lit through ignition, then off after the 12 s on-part of the window
+    mock_advance_ms(5000);
+    ptx_oven_control_update();
+    EXPECT_EQ(ptx_oven_get_status()->state, PTX_HEATING_STATE_HEATING);
+    mock_advance_ms(7000);
+    ptx_oven_control_update();
+    EXPECT_FALSE(ptx_oven_get_status()->gas_on);
+    EXPECT_EQ(ptx_oven_get_status()->state, PTX_HEATING_STATE_IDLE);
+
+    // No relight for the rest of the window, even though still below target
+    mock_advance_ms(15000);
+    ptx_oven_control_update();
+    EXPECT_FALSE(ptx_oven_get_status()->gas_on);
+
+    // Next window relights
+    mock_advance_ms(3000);
+    ptx_oven_control_update();
+    EXPECT_TRUE(ptx_oven_get_status()->gas_on);
+
+    // Back in hysteresis mode the duty reads 0 again
+    ptx_oven_set_control_mode(PTX_CONTROL_MODE_HYSTERESIS);
+    mock_advance_ms(50);
+    ptx_oven_control_update();
+    EXPECT_EQ(ptx_oven_get_status()->heat_duty_pct, 0);
+
+    ptx_oven_reset_config_to_defaults();
+}
+
+TEST(AutotuneTest, EstimatesUltimateGainAndPeriodFromRelayCycle) {
+    ptx_autotune_t at;
+    ptx_autotune_init(&at);
+    ASSERT_FALSE(ptx_autotune_start(&at, PTX_CONTROL_MODE_HYSTERESIS, 3));
+    ASSERT_FALSE(ptx_autotune_start(&at, PTX_CONTROL_MODE_PI, 0));
+    ASSERT_TRUE(ptx_autotune_start(&at, PTX_CONTROL_MODE_PI, 3));
+
+    // 40 s relay cycle, burner on for the first half; temperature is a triangle 175..185 C
+    for (uint32_t t = 20; t < 400 && ptx_autotune_running(&at); t++) {
+        uint32_t phase = t % 40;
+        bool heat = phase < 20;
+        float temp = heat ? 175.0f + 0.5f * phase : 185.0f - 0.5f * (phase - 20);
+        ptx_autotune_sample(&at, t * 1000U, temp, 185.0f, heat);
+    }
+    ASSERT_EQ(at.state, PTX_AUTOTUNE_DONE);
+    EXPECT_EQ(at.cycles_done, 3);
+    EXPECT_NEAR(at.tu_s, 40.0f, 0.01f);
+    EXPECT_NEAR(at.amplitude_c, 5.0f, 0.01f);
+    EXPECT_NEAR(at.dead_time_s, 0.0f, 0.01f);
+    EXPECT_NEAR(at.ku, 2.0f / 3.14159265f / 5.0f, 1e-4f);   // D = 0.5
+    EXPECT_NEAR(at.kp, 0.45f * at.ku, 1e-6f);
+    EXPECT_NEAR(at.ki, at.kp * 1.2f / 40.0f, 1e-6f);
+    EXPECT_EQ(at.kd, 0.0f);
+
+    ptx_oven_config_t cfg;
+    ptx_oven_get_default_config(&cfg);
+    ASSERT_TRUE(ptx_autotune_apply(&at, &cfg));
+    EXPECT_EQ(cfg.control_mode, PTX_CONTROL_MODE_PI);
+    EXPECT_FLOAT_EQ(cfg.pid_kp, at.kp);
+    EXPECT_TRUE(ptx_oven_config_validate(&cfg));
+}
+
+TEST_F(OvenControlTest, AutotuneAbortsWhenDoorOpens) {
+    ASSERT_TRUE(ptx_oven_start_autotune(PTX_CONTROL_MODE_PID, 3));
+    mock_set_vref_mv(5000);
+    mock_set_signal_mv(mv_for_temp(5000, 160.0f));
+    mock_advance_ms(2500);
+    ptx_oven_control_update();
+    EXPECT_EQ(ptx_oven_get_autotune()->state, PTX_AUTOTUNE_RUNNING);
+
+    ptx_oven_set_door_state(true);
+    ptx_oven_control_update();
+    EXPECT_EQ(ptx_oven_get_autotune()->state, PTX_AUTOTUNE_ABORTED);
+    EXPECT_EQ(ptx_oven_get_control_mode(), PTX_CONTROL_MODE_HYSTERESIS) << "Config must stay untouched";
+}
+
+// Falls 0.5 C/s from `from_c` in 50 ms ticks until the burner lights; returns the temperature then
+static float fall_until_ignition(float from_c, float to_c) {
+    for (float temp = from_c; temp > to_c; temp -= 0.025f) {
+        mock_set_signal_mv(mv_for_temp(5000, temp));
+        ptx_oven_control_update();
+        if (ptx_oven_get_status()->gas_on) return temp;
+        mock_advance_ms(50);
+    }
+    return to_c;
+}
+
+TEST_F(OvenControlTest, PreignitionWaitsOutDoorSettleWindow) {
+    ptx_oven_set_preignite_enabled(1);
+    ptx_oven_control_init();
+    ptx_oven_set_door_state(false);
+    mock_set_vref_mv(5000);
+    mock_advance_ms(2500);
+
+    // Falling toward ON (175 C): the ignition starts about 5 s (2.5 C) early
+    float lit_c = fall_until_ignition(200.0f, 170.0f);
+    EXPECT_GT(lit_c, 176.5f);
+    EXPECT_LT(lit_c, 178.5f);
+    EXPECT_EQ(ptx_oven_get_status()->state, PTX_HEATING_STATE_IGNITING);
+    ptx_transition_t t;
+    const ptx_transition_ring_t* ring = ptx_oven_get_transitions();
+    ASSERT_TRUE(ptx_transition_ring_get(ring, ptx_transition_ring_count(ring) - 1, &t));
+    EXPECT_EQ(t.cause, PTX_TRANSITION_CAUSE_PREIGNITE);
+
+    // Same fall, but the door was open until 179 C: the slope right after a door
+    // opening is not trusted, so the ignition waits for the ON threshold itself
+    ptx_oven_control_init();
+    ptx_oven_set_door_state(true);
+    mock_advance_ms(20000);
+    EXPECT_EQ(fall_until_ignition(200.0f, 179.0f), 179.0f);
+    ptx_oven_set_door_state(false);
+    lit_c = fall_until_ignition(179.0f, 170.0f);
+    EXPECT_LE(lit_c, 175.0f);
+    EXPECT_GT(lit_c, 174.5f);
+
+    ring = ptx_oven_get_transitions();
+    ASSERT_TRUE(ptx_transition_ring_get(ring, ptx_transition_ring_count(ring) - 1, &t));
+    EXPECT_EQ(t.cause, PTX_TRANSITION_CAUSE_HEAT_DEMAND);
+
+    ptx_oven_reset_config_to_defaults();
+}
+
+// vref out of range skews the reading before the fault latches; the slope of
+// those readings must not start an early ignition
+TEST_F(OvenControlTest, PreignitionIgnoresOutOfRangeReadings) {
+    ptx_oven_set_preignite_enabled(1);
+    ptx_oven_control_init();
+    ptx_oven_set_door_state(false);
+    mock_set_vref_mv(5000);
+    mock_advance_ms(2500);
+
+    // 0.5 C/s fall; 5.51 V vref for 600 ms (under the 1 s fault window) makes
+    // 200 C read as about 177 C, a steep apparent drop toward ON
+    float temp = 215.0f;
+    for (int i = 0; temp > 185.0f; ++i, temp -= 0.025f) {
+        mock_set_vref_mv((i >= 600 && i < 612) ? 5510 : 5000);
+        mock_set_signal_mv(mv_for_temp(5000, temp));
+        ptx_oven_control_update();
+        ASSERT_FALSE(ptx_oven_get_status()->gas_on) << "lit at " << temp << " C";
+        mock_advance_ms(50);
+    }
+    EXPECT_FALSE(ptx_oven_get_status()->sensor_fault);
+
+    ptx_transition_t t;
+    const ptx_transition_ring_t* ring = ptx_oven_get_transitions();
+    for (uint8_t i = 0; i < ptx_transition_ring_count(ring); ++i) {
+        ASSERT_TRUE(ptx_transition_ring_get(ring, i, &t));
+        EXPECT_NE(t.cause, PTX_TRANSITION_CAUSE_PREIGNITE);
+    }
+
+    ptx_oven_reset_config_to_defaults();
+}
+
+TEST(RecipeTest, BuiltInRecipesStayInConfigRange) {
+    ASSERT_GE(ptx_recipe_count(), 1u);
+    for (uint8_t id = 1; id <= ptx_recipe_count(); id++) {
+        ptx_recipe_segment_t seg;
+        ASSERT_TRUE(ptx_recipe_get_segment(id, 0, &seg)) << "recipe " << (int)id << " is empty";
+        for (uint8_t i = 0; ptx_recipe_get_segment(id, i, &seg); i++) {
+            EXPECT_GE(seg.target_dc, 0) << "recipe " << (int)id << " segment " << (int)i;
+            EXPECT_LE(seg.target_dc, 3000) << "recipe " << (int)id << " segment " << (int)i;
+        }
+    }
+    ptx_recipe_segment_t seg;
+    EXPECT_FALSE(ptx_recipe_get_segment(0, 0, &seg));
+    EXPECT_FALSE(ptx_recipe_get_segment(ptx_recipe_count() + 1, 0, &seg));
+}
+
+TEST(RecipeTest, RampsSetpointAndHoldsOnceInBand) {
+    ptx_recipe_t r;
+    ptx_recipe_init(&r);
+    EXPECT_FALSE(ptx_recipe_start(&r, 0));
+    EXPECT_EQ(r.state, PTX_RECIPE_IDLE);
+    ASSERT_TRUE(ptx_recipe_start(&r, 1));  // 200 C step, hold 600 s; 170 C at 10 C/min, hold 720 s
+
+    const uint32_t band = ptx_oven_temp_to_ratio_q16(180.0f) - ptx_oven_temp_to_ratio_q16(175.0f);
+    uint32_t t = 1000;
+    // The step lands at once, but the hold waits for the oven to reach the band
+    ptx_recipe_update(&r, t, ptx_oven_temp_to_ratio_q16(150.0f), band);
+    EXPECT_NEAR(ptx_recipe_setpoint_c(&r), 200.0f, 0.01f);
+    EXPECT_EQ(r.phase, PTX_RECIPE_PHASE_SOAK);
+    ptx_recipe_update(&r, t += 60000, ptx_oven_temp_to_ratio_q16(194.0f), band);
+    EXPECT_EQ(r.phase, PTX_RECIPE_PHASE_SOAK);
+    ptx_recipe_update(&r, t += 50, ptx_oven_temp_to_ratio_q16(196.0f), band);
+    EXPECT_EQ(r.phase, PTX_RECIPE_PHASE_HOLD);
+    EXPECT_EQ(ptx_recipe_hold_left_ms(&r, t), 600000u);
+
+    // Hold, then ramp down 10 C/min in 50 ms ticks
+    uint32_t ratio = ptx_oven_temp_to_ratio_q16(200.0f);
+    for (uint32_t end = t + 600000; t < end; ) ptx_recipe_update(&r, t += 50, ratio, band);
+    EXPECT_EQ(r.segment, 1);
+    EXPECT_EQ(r.phase, PTX_RECIPE_PHASE_RAMP);
+    for (int i = 0; i < 1200; i++) ptx_recipe_update(&r, t += 50, ratio, band);
+    EXPECT_NEAR(ptx_recipe_setpoint_c(&r), 190.0f, 0.05f);
+    // A stalled loop moves the ramp by at most one second's worth
+    ptx_recipe_update(&r, t += 10000, ratio, band);
+    EXPECT_NEAR(ptx_recipe_setpoint_c(&r), 190.0f - 10.0f / 60.0f, 0.05f);
+    for (int i = 0; i < 3000; i++) ptx_recipe_update(&r, t += 50, ptx_oven_temp_to_ratio_q16(172.0f), band);
+    EXPECT_NEAR(ptx_recipe_setpoint_c(&r), 170.0f, 0.01f);
+    EXPECT_EQ(r.phase, PTX_RECIPE_PHASE_HOLD);
+
+    // The last hold ends the recipe
+    for (uint32_t end = t + 720000; t < end; ) ptx_recipe_update(&r, t += 50, ratio, band);
+    EXPECT_EQ(r.state, PTX_RECIPE_DONE);
+    EXPECT_FALSE(ptx_recipe_running(&r));
+}
+
+TEST_F(OvenControlTest, RecipeSetpointMovesThresholds) {
+    mock_set_vref_mv(5000);
+    mock_set_signal_mv(mv_for_temp(5000, 190.0f));  // above the configured band (175..185)
+    mock_advance_ms(2500);
+    ptx_oven_control_update();
+    EXPECT_FALSE(ptx_oven_get_status()->gas_on);
+
+    // Recipe 1 steps the setpoint to 200 C: 190 C is now below its ON threshold (195)
+    ASSERT_TRUE(ptx_oven_start_recipe(1));
+    EXPECT_FALSE(ptx_oven_start_autotune(PTX_CONTROL_MODE_PI, 3)) << "No autotune around a moving setpoint";
+    mock_advance_ms(50);
+    ptx_oven_control_update();
+    mock_advance_ms(50);
+    ptx_oven_control_update();
+    EXPECT_TRUE(ptx_oven_get_status()->gas_on);
+
+    // Stopping it restores the configured thresholds
+    ptx_oven_stop_recipe();
+    EXPECT_EQ(ptx_oven_get_recipe()->state, PTX_RECIPE_ABORTED);
+    mock_advance_ms(5000);
+    ptx_oven_control_update();
+    mock_advance_ms(50);
+    ptx_oven_control_update();
+    EXPECT_FALSE(ptx_oven_get_status()->gas_on);
+}
+
+TEST(RateEstimatorTest, FitsRampSlopeIncrementally) {
+    ptx_rate_estimator_t est;
+    ptx_rate_estimator_init(&est);
+    // 2 units/s ramp with irregular 50..60 ms ticks; decimated to PTX_RATE_SAMPLE_MS
+    uint32_t t = 1000;
+    for (int i = 0; i < 200; i++, t += 50 + (i % 3) * 5) {
+        ptx_rate_estimator_update(&est, t, 100.0f + 0.002f * (float)t);
+    }
+    EXPECT_NEAR(ptx_rate_estimator_slope(&est), 2.0f, 0.01f);
+
+    // Flat signal: the old ramp decays out of the fit (80 samples)
+    for (int i = 0; i < 400; i++, t += 50) {
+        ptx_rate_estimator_update(&est, t, 50.0f);
+    }
+    EXPECT_NEAR(ptx_rate_estimator_slope(&est), 0.0f, 0.01f);
+
+    // A long gap restarts the fit instead of bridging it
+    t += 10000;
+    EXPECT_EQ(ptx_rate_estimator_update(&est, t, -500.0f), 0.0f);
+    EXPECT_EQ(est.samples, 1);
+}
@@ -0,0 +1,148 @@
+/**
+ * @file test_oven_zones_gtest.cpp
+ * @brief Google Test suite for multi-zone control and the shared safety supervisor
+ */
+#include <gtest/gtest.h>
+#include "ptx_oven_zones.h"
+#include "ptx_actuator.h"
+#include "ptx_oven_config.h"
+#include "tests/mocks/mock_api.h"
+
+static uint16_t mv_for_temp(float vref_mv, float temp_c) {
+    float val = ((temp_c + 10.0f) / 310.0f) * (0.80f * vref_mv) + 0.10f * vref_mv;
+    return (uint16_t)(val + 0.5f);
+}
+
+class OvenZonesTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        mock_reset_time(0);
+        ptx_oven_reset_config_to_defaults();
+        set_zone_temp(0, 180.0f);
+        set_zone_temp(1, 180.0f);
+        ptx_oven_zones_set_door_state(false);
+        ptx_oven_zones_init(2);
+        mock_advance_ms(2000);  // past the startup interlock
+    }
+
+    void TearDown() override {
+        set_zone_temp(0, 180.0f);
+        set_zone_temp(1, 180.0f);
+        ptx_oven_reset_config_to_defaults();
+    }
+
+    static void set_zone_temp(uint8_t zone, float temp_c) {
+        mock_set_input_mv(zone == 0 ? TEMPERATURE_SENSOR_REFERENCE : TEMPERATURE_SENSOR_2_REFERENCE, 5000);
+        mock_set_input_mv(zone == 0 ? TEMPERATURE_SENSOR : TEMPERATURE_SENSOR_2, mv_for_temp(5000, temp_c));
+    }
+
+    static void run_ms(uint32_t ms) {
+        for (uint32_t t = 0; t < ms; t += 50) {
+            ptx_oven_zones_update();
+            mock_advance_ms(50);
+        }
+    }
+};
+
+TEST_F(OvenZonesTest, ZonesRunIndependentBurners) {
+    set_zone_temp(0, 150.0f);  // below ON threshold
+    set_zone_temp(1, 190.0f);  // above OFF threshold
+    run_ms(500);
+
+    EXPECT_TRUE(ptx_oven_zones_get_status(0)->gas_on);
+    EXPECT_FALSE(ptx_oven_zones_get_status(1)->gas_on);
+    EXPECT_TRUE(read_output(GAS_VALVE));
+    EXPECT_TRUE(read_output(IGNITER));
+    EXPECT_FALSE(read_output(GAS_VALVE_2));
+    EXPECT_FALSE(read_output(IGNITER_2));
+
+    set_zone_temp(1, 150.0f);
+    run_ms(500);
+    EXPECT_TRUE(read_output(GAS_VALVE_2));
+}
+
+TEST_F(OvenZonesTest, DoorOpenShutsDownEveryZone) {
+    set_zone_temp(0, 150.0f);
+    set_zone_temp(1, 150.0f);
+    run_ms(500);
+    ASSERT_TRUE(read_output(GAS_VALVE));
+    ASSERT_TRUE(read_output(GAS_VALVE_2));
+
+    ptx_oven_zones_set_door_state(true);
+    ptx_oven_zones_update();
+    EXPECT_TRUE(ptx_oven_zones_tripped());
+    EXPECT_FALSE(read_output(GAS_VALVE));
+    EXPECT_FALSE(read_output(GAS_VALVE_2));
+    EXPECT_FALSE(read_output(IGNITER));
+    EXPECT_FALSE(read_output(IGNITER_2));
+
+    ptx_oven_zones_set_door_state(false);
+    run_ms(500);
+    EXPECT_FALSE(ptx_oven_zones_tripped());
+    EXPECT_TRUE(read_output(GAS_VALVE));
+    EXPECT_TRUE(read_output(GAS_VALVE_2));
+}
+
+TEST_F(OvenZonesTest, FaultInOneZoneShutsDownAllZones) {
+    set_zone_temp(0, 150.0f);
+    set_zone_temp(1, 190.0f);
+    run_ms(500);
+    ASSERT_TRUE(read_output(GAS_VALVE));
+
+    // Zone 1 vref collapses; once its fault latches the supervisor trips
+    mock_set_input_mv(TEMPERATURE_SENSOR_2_REFERENCE, 3000);
+    run_ms(1500);
+    EXPECT_TRUE(ptx_oven_zones_get_status(1)->sensor_fault);
+    EXPECT_FALSE(ptx_oven_zones_get_status(0)->sensor_fault);
+    EXPECT_TRUE(ptx_oven_zones_tripped());
+    EXPECT_FALSE(read_output(GAS_VALVE));
+
+    // Zone 1 recovers after its auto-resume window; zone 0 heats again
+    set_zone_temp(1, 190.0f);
+    run_ms(4000);
+    EXPECT_FALSE(ptx_oven_zones_tripped());
+    EXPECT_TRUE(read_output(GAS_VALVE));
+    EXPECT_FALSE(read_output(GAS_VALVE_2));
+}
+
+TEST_F(OvenZonesTest, DriftedZonePinIsDrivenBack) {
+    set_zone_temp(0, 150.0f);
+    set_zone_temp(1, 190.0f);
+    run_ms(500);
+    ASSERT_FALSE(read_output(GAS_VALVE_2));
+
+    // Zone 1's valve comes on without a command; its OFF command never changes
+    set_output(GAS_VALVE_2, 1);
+    run_ms(PTX_ACTUATOR_VERIFY_TICKS * 50);
+    EXPECT_FALSE(read_output(GAS_VALVE_2)) << "first mismatching sample rewrites the pin";
+    EXPECT_TRUE(read_output(GAS_VALVE));
+    EXPECT_EQ(ptx_oven_zones_get_status(1)->actuator_mismatches, 1u);
+    EXPECT_FALSE(ptx_oven_zones_tripped());
+}
+
+TEST_F(OvenZonesTest, PerZoneOverrideAndStats) {
+    ptx_oven_config_t cfg;
+    ptx_oven_get_default_config(&cfg);
+    cfg.temp_target_c = 130.0f;
+    ASSERT_TRUE(ptx_oven_zones_set_override(1, &cfg));
+    EXPECT_FALSE(ptx_oven_zones_set_override(2, &cfg));
+
+    // 150 C: zone 0 (shared 180 C target) heats, zone 1 (130 C override) does not
+    set_zone_temp(0, 150.0f);
+    set_zone_temp(1, 150.0f);
+    run_ms(500);
+    EXPECT_TRUE(read_output(GAS_VALVE));
+    EXPECT_FALSE(read_output(GAS_VALVE_2));
+
+    // Back on the shared config (now 120 C target): still no demand at 150 C
+    ptx_oven_set_temp_target_c(120.0f);
+    ptx_oven_zones_set_override(1, NULL);
+    run_ms(100);
+    EXPECT_FALSE(ptx_oven_zones_get_status(1)->gas_on);
+
+    const ptx_oven_zone_stats_t* stats = ptx_oven_zones_get_stats(1);
+    ASSERT_NE(stats, nullptr);
+    EXPECT_EQ(stats->ticks, 12u);
+    EXPECT_GE(stats->max_us, stats->last_us);
+    EXPECT_EQ(ptx_oven_zones_get_stats(2), nullptr);
+}
@@ -0,0 +1,161 @@
+/**
+ * @file test_trace_gtest.cpp
+ * @brief Google Test suite for the raw-input trace recorder and decoder
+ */
+#include <gtest/gtest.h>
+#include <vector>
+#include "ptx_trace.h"
+#include "ptx_oven_control.h"
+#include "ptx_oven_zones.h"
+#include "ptx_oven_config.h"
+#include "tests/mocks/mock_api.h"
+
+static std::vector<uint8_t> g_trace;
+
+static void capture_sink(const uint8_t* data, uint8_t length) {
+    g_trace.insert(g_trace.end(), data, data + length);
+}
+
+static std::vector<ptx_trace_event_t> decode_all(ptx_trace_read_result_t* last) {
+    std::vector<ptx_trace_event_t> events;
+    ptx_trace_reader_t reader;
+    EXPECT_TRUE(ptx_trace_reader_init(&reader, g_trace.data(), (uint32_t)g_trace.size()));
+    ptx_trace_event_t ev;
+    while ((*last = ptx_trace_read_next(&reader, &ev)) == PTX_TRACE_READ_OK) {
+        events.push_back(ev);
+    }
+    return events;
+}
+
+class TraceTest : public ::testing::Test {
+protected:
+    void SetUp() override { g_trace.clear(); }
+    void TearDown() override { ptx_trace_stop(); }
+};
+
+TEST_F(TraceTest, RoundTripTicksAndDoorEdges) {
+    ptx_trace_start(capture_sink);
+    uint32_t now = 1000;
+    for (int i = 0; i < 200; i++) {
+        if (i == 70) {
+            ptx_trace_note_door(now - 20, true);
+            ptx_trace_note_door(now - 10, true);  // unchanged state: ignored
+        }
+        // Large swings and a vref step exercise negative and multi-byte deltas
+        ptx_trace_record_tick(now, (uint16_t)(i < 100 ? 5000 : 4200), (uint16_t)(1000 + (i % 7) * 300));
+        now += (i % 3 == 0) ? 50 : 51;
+    }
+    ptx_trace_stop();
+    EXPECT_FALSE(ptx_trace_is_recording());
+
+    ptx_trace_read_result_t last;
+    std::vector<ptx_trace_event_t> events = decode_all(&last);
+    EXPECT_EQ(last, PTX_TRACE_READ_END);
+    ASSERT_EQ(events.size(), 201u);
+
+    now = 1000;
+    size_t e = 0;
+    int keyframes = 0;
+    for (int i = 0; i < 200; i++, e++) {
+        if (i == 70) {
+            EXPECT_EQ(events[e].tag, PTX_TRACE_TAG_DOOR);
+            EXPECT_EQ(events[e].time_ms, now - 20);
+            EXPECT_TRUE(events[e].door_open);
+            e++;
+        }
+        ASSERT_NE(events[e].tag, PTX_TRACE_TAG_DOOR);
+        if (events[e].tag == PTX_TRACE_TAG_KEYFRAME) keyframes++;
+        EXPECT_EQ(events[e].time_ms, now);
+        EXPECT_EQ(events[e].vref_mv, (uint16_t)(i < 100 ? 5000 : 4200));
+        EXPECT_EQ(events[e].signal_mv, (uint16_t)(1000 + (i % 7) * 300));
+        now += (i % 3 == 0) ? 50 : 51;
+    }
+    EXPECT_EQ(keyframes, 4);  // first tick, then every PTX_TRACE_KEYFRAME_INTERVAL + 1 ticks
+}
+
+TEST_F(TraceTest, SteadyTickIsCompactAndTruncationIsClean) {
+    ptx_trace_start(capture_sink);
+    uint16_t signal = 2000;
+    for (uint32_t i = 0; i < 1000; i++) {
+        signal = (uint16_t)(signal + ((i & 1U) ? 3 : -2));  // small ADC noise
+        ptx_trace_record_tick(i * 50U, 5000, signal);
+    }
+    ptx_trace_stop();
+    EXPECT_LT(g_trace.size(), 1000u * 4u + 1000u / PTX_TRACE_KEYFRAME_INTERVAL * 8u + PTX_TRACE_HEADER_SIZE);
+
+    // A capture cut mid-record ends cleanly at the last complete record
+    g_trace.resize(g_trace.size() - 2);
+    ptx_trace_read_result_t last;
+    EXPECT_EQ(decode_all(&last).size(), 999u);
+    EXPECT_EQ(last, PTX_TRACE_READ_END);
+
+    // Unknown tags are reported, not decoded
+    g_trace.push_back(0x7F);
+    ptx_trace_reader_t reader;
+    ASSERT_TRUE(ptx_trace_reader_init(&reader, g_trace.data(), (uint32_t)g_trace.size()));
+    reader.pos = (uint32_t)g_trace.size() - 1;
+    ptx_trace_event_t ev;
+    EXPECT_EQ(ptx_trace_read_next(&reader, &ev), PTX_TRACE_READ_CORRUPT);
+
+    g_trace[3] = PTX_TRACE_VERSION + 1;
+    EXPECT_FALSE(ptx_trace_reader_init(&reader, g_trace.data(), (uint32_t)g_trace.size()));
+}
+
+TEST_F(TraceTest, ControlLoopRecordsItsRawInputs) {
+    mock_reset_time(0);
+    ptx_oven_reset_config_to_defaults();
+    mock_set_vref_mv(5000);
+    mock_set_signal_mv(2000);
+    ptx_oven_control_init();
+    ptx_oven_set_door_state(false);
+
+    ptx_trace_start(capture_sink);
+    for (int i = 0; i < 10; i++) {
+        if (i == 5) ptx_oven_set_door_state(true);
+        mock_set_signal_mv((uint16_t)(2000 + i));
+        ptx_oven_control_update();
+        mock_advance_ms(50);
+    }
+    ptx_oven_set_door_state(false);
+    ptx_trace_stop();
+
+    ptx_trace_read_result_t last;
+    std::vector<ptx_trace_event_t> events = decode_all(&last);
+    ASSERT_EQ(events.size(), 11u);  // the final close edge has no tick after it
+    EXPECT_EQ(events[0].tag, PTX_TRACE_TAG_KEYFRAME);
+    EXPECT_EQ(events[5].tag, PTX_TRACE_TAG_DOOR);
+    EXPECT_EQ(events[5].time_ms, 250u);
+    EXPECT_EQ(events[10].time_ms, 450u);
+    EXPECT_EQ(events[10].signal_mv, 2009u);
+}
+
+TEST_F(TraceTest, MultiZoneLoopRecordsZoneZeroInputs) {
+    mock_reset_time(0);
+    ptx_oven_reset_config_to_defaults();
+    mock_set_input_mv(TEMPERATURE_SENSOR_REFERENCE, 5000);
+    mock_set_input_mv(TEMPERATURE_SENSOR, 2000);
+    mock_set_input_mv(TEMPERATURE_SENSOR_2_REFERENCE, 4900);
+    mock_set_input_mv(TEMPERATURE_SENSOR_2, 3000);
+    ptx_oven_zones_set_door_state(false);
+    ptx_oven_zones_init(2);
+
+    ptx_trace_start(capture_sink);
+    for (int i = 0; i < 10; i++) {
+        if (i == 5) ptx_oven_zones_set_door_state(true);
+        mock_set_input_mv(TEMPERATURE_SENSOR, (uint16_t)(2000 + i));
+        ptx_oven_zones_update();
+        mock_advance_ms(50);
+    }
+    ptx_oven_zones_set_door_state(false);
+    ptx_trace_stop();
+
+    ptx_trace_read_result_t last;
+    std::vector<ptx_trace_event_t> events = decode_all(&last);
+    ASSERT_EQ(events.size(), 11u);  // one door edge despite the per-tick door refresh
+    EXPECT_EQ(events[0].tag, PTX_TRACE_TAG_KEYFRAME);
+    EXPECT_EQ(events[0].vref_mv, 5000u);
+    EXPECT_EQ(events[5].tag, PTX_TRACE_TAG_DOOR);
+    EXPECT_EQ(events[5].time_ms, 250u);
+    EXPECT_EQ(events[10].time_ms, 450u);
+    EXPECT_EQ(events[10].signal_mv, 2009u);
+}
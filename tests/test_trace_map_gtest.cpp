@@ -0,0 +1,96 @@
+/**
+ * @file test_trace_map_gtest.cpp
+ * @brief Google Test suite for the memory-mapped trace reader (seek, unwrapped time)
+ */
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <vector>
+#include "ptx_trace.h"
+#include "tests/replay/ptx_trace_map.h"
+
+static const uint32_t kStartMs = 0xFFFF0000U;  // millis() wraps ~65 s in
+static const uint32_t kTicks = 20000;
+static std::vector<uint8_t> g_map_trace;
+
+static void map_sink(const uint8_t* data, uint8_t length) {
+    g_map_trace.insert(g_map_trace.end(), data, data + length);
+}
+
+class TraceMapTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        g_map_trace.clear();
+        ptx_trace_start(map_sink);
+        for (uint32_t i = 0; i < kTicks; i++) {
+            if (i == 15000) ptx_trace_note_door(kStartMs + i * 50U - 5U, true);
+            ptx_trace_record_tick(kStartMs + i * 50U, 5000, (uint16_t)(2000 + (i % 13)));
+        }
+        ptx_trace_stop();
+
+        snprintf(path, sizeof(path), "ptx_trace_map_test_%d.ptxt", (int)getpid());
+        FILE* f = fopen(path, "wb");
+        ASSERT_NE(f, nullptr);
+        fwrite(g_map_trace.data(), 1, g_map_trace.size(), f);
+        fclose(f);
+        ASSERT_TRUE(ptx_trace_map_open(&map, path));
+    }
+
+    void TearDown() override {
+        ptx_trace_map_close(&map);
+        remove(path);
+    }
+
+    char path[64];
+    ptx_trace_map_t map;
+};
+
+TEST_F(TraceMapTest, RewindDecodesInPlaceWithUnwrappedTime) {
+    ptx_trace_cursor_t cursor;
+    ptx_trace_map_rewind(&map, &cursor);
+    ptx_trace_event_t ev;
+    uint32_t ticks = 0;
+    uint64_t last = 0;
+    while (ptx_trace_cursor_next(&cursor, &ev) == PTX_TRACE_READ_OK) {
+        EXPECT_GE(cursor.time_ms, last);
+        last = cursor.time_ms;
+        EXPECT_EQ((uint32_t)cursor.time_ms, ev.time_ms);
+        if (ev.tag != PTX_TRACE_TAG_DOOR) ticks++;
+    }
+    EXPECT_EQ(ticks, kTicks);
+    EXPECT_EQ(last, (uint64_t)kStartMs + (kTicks - 1) * 50ULL);
+}
+
+TEST_F(TraceMapTest, SeekLandsOnLastKeyframeAtOrBeforeTarget) {
+    ptx_trace_cursor_t cursor;
+    ptx_trace_event_t ev;
+    EXPECT_FALSE(ptx_trace_map_seek(&map, kStartMs - 1ULL, &cursor));
+
+    // Early seek only indexes the start of the file
+    ASSERT_TRUE(ptx_trace_map_seek(&map, kStartMs + 1000ULL, &cursor));
+    EXPECT_FALSE(map.scan_done);
+    EXPECT_LE(map.index.size(), 2u);
+
+    const uint64_t targets[] = { kStartMs + 70000ULL, kStartMs + 500000ULL, kStartMs + 750003ULL };
+    for (uint64_t target : targets) {
+        ASSERT_TRUE(ptx_trace_map_seek(&map, target, &cursor));
+        ASSERT_EQ(ptx_trace_cursor_next(&cursor, &ev), PTX_TRACE_READ_OK);
+        EXPECT_EQ(ev.tag, PTX_TRACE_TAG_KEYFRAME);
+        EXPECT_LE(cursor.time_ms, target);
+        EXPECT_GT(cursor.time_ms + PTX_TRACE_KEYFRAME_INTERVAL * 51ULL, target);
+        EXPECT_EQ((uint32_t)cursor.time_ms, ev.time_ms);
+        EXPECT_EQ(ev.signal_mv, 2000 + ((cursor.time_ms - kStartMs) / 50) % 13);
+
+        // Deltas after the seek point decode against the keyframe
+        ASSERT_EQ(ptx_trace_cursor_next(&cursor, &ev), PTX_TRACE_READ_OK);
+        EXPECT_EQ(ev.signal_mv, 2000 + ((cursor.time_ms - kStartMs) / 50) % 13);
+    }
+
+    // Past the end: last keyframe; the index stays sparse
+    ASSERT_TRUE(ptx_trace_map_seek(&map, UINT64_MAX, &cursor));
+    EXPECT_TRUE(map.scan_done);
+    EXPECT_LE(map.index.size(), kTicks / (PTX_TRACE_KEYFRAME_INTERVAL * PTX_TRACE_MAP_INDEX_STRIDE) + 1);
+    uint32_t remaining = 0;
+    while (ptx_trace_cursor_next(&cursor, &ev) == PTX_TRACE_READ_OK) remaining++;
+    EXPECT_LE(remaining, PTX_TRACE_KEYFRAME_INTERVAL + 1);
+}
@@ -0,0 +1,39 @@
+/**
+ * @file Arduino.h
+ * @brief Minimal Arduino stand-in for the bare-metal AVR cost harness (no Arduino core)
+ */
+#pragma once
+#include <stdint.h>
+#include <stdlib.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+unsigned long millis(void);
+#ifdef __cplusplus
+}
+
+// Serial that formats like Arduino's Print but sends nothing: log formatting
+// cost is measured, UART time is not
+class PtxSerialStub {
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    explicit operator bool() const { return true; }
+    size_t print(const char* s) {
+        size_t n = 0;
+        while (s[n] != '\0') sink_ ^= (unsigned char)s[n++];
+        return n;
+    }
+    size_t print(unsigned long v) {
+        char buf[11];
+        return print(ultoa(v, buf, 10));
+    }
+    size_t print(int v) {
+        char buf[7];
+        return print(itoa(v, buf, 10));
+    }
+    size_t println(const char* s) { return print(s) + print("\r\n"); }
+private:
+    volatile unsigned char sink_ = 0;
+};
+extern PtxSerialStub Serial;
+#endif
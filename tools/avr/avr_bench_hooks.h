@@ -0,0 +1,32 @@
+/**
+ * @file avr_bench_hooks.h
+ * @brief Stage markers for the AVR cycle harness
+ * @details Force-included (-include) into every module the harness builds, so
+ *          PTX_PROFILE_MARK() in ptx_oven_control.cpp reads Timer1 instead of
+ *          compiling to nothing.
+ */
+#pragma once
+#include <stdint.h>
+
+/* One id per PTX_PROFILE_MARK() site, in tick order */
+enum {
+    AVR_BENCH_STAGE_start = 0,
+    AVR_BENCH_STAGE_inputs,       /* millis(), read_voltage(), trace hook */
+    AVR_BENCH_STAGE_filter,       /* median filter and Q16 ratio */
+    AVR_BENCH_STAGE_faults,       /* timed fault evaluation and ratio clamp */
+    AVR_BENCH_STAGE_temperature,  /* float temperature for status/log */
+    AVR_BENCH_STAGE_heating,      /* state machine */
+    AVR_BENCH_STAGE_log,          /* periodic PTX_LOGF */
+    AVR_BENCH_STAGE_outputs,      /* config unpin and output writes */
+    AVR_BENCH_STAGE_COUNT
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+void avr_bench_mark(uint8_t stage);
+#ifdef __cplusplus
+}
+#endif
+
+#define PTX_PROFILE_MARK(stage) avr_bench_mark(AVR_BENCH_STAGE_##stage)
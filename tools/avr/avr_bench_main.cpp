@@ -0,0 +1,269 @@
+/**
+ * @file avr_bench_main.cpp
+ * @brief Cycle-accurate cost harness for the control tick (ATmega328P under simavr)
+ * @details Bare-metal replacement for the sketch: implements api.h against a
+ *          scripted scenario, runs ptx_oven_control_update() once per simulated
+ *          50 ms tick, and times the whole call and each stage between
+ *          PTX_PROFILE_MARK() sites with Timer1 at the CPU clock (1 count =
+ *          1 cycle, overflows counted in an interrupt). The stack is painted
+ *          before main() and scanned afterwards for the high-water mark.
+ *
+ *          Results go to the simavr console (GPIOR0) as key=value lines that
+ *          check_budgets.py compares with the budgets. The same image runs on
+ *          hardware; only the console output is lost.
+ *
+ *          Scenario (1200 ticks = 60 s): heat from 150 °C with ignition and
+ *          heating cycles, door open for 3 s, reference sag to 4.3 V for 3 s
+ *          (fault latch and auto-resume). Periodic logging runs throughout.
+ *
+ *          Door edges are timed on their own (door_isr): the handler's cost is
+ *          the latency from the edge to the burner outputs being off.
+ */
+#include <avr/eeprom.h>
+#include <avr/interrupt.h>
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include <avr/sleep.h>
+#include <stdio.h>
+#include "avr/avr_mcu_section.h"  /* from simavr (SIMAVR_INC) */
+#include "Arduino.h"
+#include "api.h"
+#include "ptx_actuator.h"
+#include "ptx_oven_control.h"
+
+AVR_MCU(F_CPU, "atmega328p");
+AVR_MCU_SIMAVR_CONSOLE(&GPIOR0);
+
+#define AVR_BENCH_TICKS     1200U
+#define AVR_BENCH_TICK_MS   50U
+#define AVR_BENCH_PAINT     0xC5U
+
+PtxSerialStub Serial;
+
+/* Scenario state read by the api.h functions */
+static uint32_t pti_now_ms = 0;
+static uint16_t pti_vref_mv = 5000;
+static uint16_t pti_signal_mv = 0;
+
+/* Cycle counter: Timer1 at F_CPU plus overflow count */
+static volatile uint16_t pti_overflows = 0;
+
+ISR(TIMER1_OVF_vect) {
+    pti_overflows++;
+}
+
+static uint32_t pti_cycles(void) {
+    uint8_t sreg = SREG;
+    cli();
+    uint16_t t = TCNT1;
+    uint16_t ovf = pti_overflows;
+    if ((TIFR1 & _BV(TOV1)) && t < 0x8000U) ovf++;  /* overflow not serviced yet */
+    SREG = sreg;
+    return ((uint32_t)ovf << 16) | t;
+}
+
+typedef struct {
+    uint32_t min;
+    uint32_t max;
+    uint32_t sum;
+    uint16_t count;
+} pti_cycle_stats_t;
+
+static pti_cycle_stats_t pti_stage[AVR_BENCH_STAGE_COUNT];
+static pti_cycle_stats_t pti_tick;
+static pti_cycle_stats_t pti_door;
+static uint32_t pti_last_mark = 0;
+static uint16_t pti_mark_overhead = 0;
+static uint8_t pti_marks_per_tick = 0;
+
+static void pti_stats_add(pti_cycle_stats_t* s, uint32_t cycles) {
+    if (s->count == 0 || cycles < s->min) s->min = cycles;
+    if (cycles > s->max) s->max = cycles;
+    s->sum += cycles;
+    s->count++;
+}
+
+extern "C" void avr_bench_mark(uint8_t stage) {
+    uint32_t now = pti_cycles();
+    if (stage != AVR_BENCH_STAGE_start && stage < AVR_BENCH_STAGE_COUNT) {
+        uint32_t d = now - pti_last_mark;
+        pti_stats_add(&pti_stage[stage], (d > pti_mark_overhead) ? d - pti_mark_overhead : 0);
+    }
+    pti_marks_per_tick++;
+    pti_last_mark = pti_cycles();
+}
+
+/* api.h backend */
+extern "C" unsigned long millis(void) { return pti_now_ms; }
+extern "C" void setup_api() {}
+
+extern "C" uint16_t read_voltage(input_t input) {
+    switch (input) {
+        case TEMPERATURE_SENSOR:           return pti_signal_mv;
+        case TEMPERATURE_SENSOR_REFERENCE: return pti_vref_mv;
+        case TEMPERATURE_SENSOR_2:         return 2000;
+        default:                           return 5000;
+    }
+}
+
+/* Shaped like the Arduino core's digitalWrite()/digitalRead(): PROGMEM pin
+   tables, PWM timer check, interrupt-safe read-modify-write. The actuator
+   goes through these only when built with PTX_ACTUATOR_PORT_DIRECT=0. */
+static const uint8_t pti_output_pin[] PROGMEM = { 2, 7, 4, 5 };
+static const uint8_t pti_pin_bit[] PROGMEM = { _BV(0), _BV(1), _BV(2), _BV(3), _BV(4), _BV(5), _BV(6), _BV(7) };
+static const uint8_t pti_pin_timer[] PROGMEM = { 0, 0, 0, 1, 0, 2, 3, 0 };  /* D3, D5, D6 have PWM */
+
+static uint8_t pti_output_bit(output_t output) {
+    return pgm_read_byte(&pti_pin_bit[pgm_read_byte(&pti_output_pin[output])]);
+}
+
+extern "C" void set_output(output_t output, bool output_state) {
+    if ((unsigned)output >= sizeof(pti_output_pin)) return;
+    uint8_t pin = pgm_read_byte(&pti_output_pin[output]);
+    uint8_t bit = pgm_read_byte(&pti_pin_bit[pin]);
+    if (pgm_read_byte(&pti_pin_timer[pin]) != 0) TCCR0A &= (uint8_t)~_BV(COM0B1);  /* turnOffPWM() */
+    uint8_t sreg = SREG;
+    cli();
+    if (output_state) PORTD |= bit;
+    else PORTD &= (uint8_t)~bit;
+    SREG = sreg;
+}
+
+extern "C" bool read_output(output_t output) {
+    if ((unsigned)output >= sizeof(pti_output_pin)) return false;
+    return (PIND & pti_output_bit(output)) != 0;
+}
+extern "C" uint32_t get_millis() { return pti_now_ms; }
+extern "C" uint32_t get_micros() { return pti_cycles() / (F_CPU / 1000000UL); }
+extern "C" void serial_printf(const char* format, ...) { (void)format; }
+extern "C" int serial_read_byte() { return -1; }
+extern "C" void serial_write(const uint8_t* data, uint16_t length) { (void)data; (void)length; }
+extern "C" uint16_t eeprom_size() { return E2END + 1U; }
+extern "C" uint8_t eeprom_read(uint16_t address) { return eeprom_read_byte((const uint8_t*)address); }
+extern "C" void eeprom_update(uint16_t address, uint8_t value) { eeprom_update_byte((uint8_t*)address, value); }
+
+/* Same as the sketch's door handler */
+extern "C" void door_sensor_interrupt_handler(bool voltage_high) {
+    uint32_t entry_us = get_micros();
+    if (voltage_high) ptx_actuator_emergency_stop_from(entry_us);
+    ptx_oven_set_door_state(voltage_high);
+}
+
+/* Paint free RAM before the C runtime sets up; runs without a stack frame */
+extern "C" void pti_stack_paint(void) __attribute__((naked, used, section(".init1")));
+extern "C" void pti_stack_paint(void) {
+    __asm volatile(
+        "    ldi r30, lo8(_end)\n"
+        "    ldi r31, hi8(_end)\n"
+        "    ldi r24, %0\n"
+        "    ldi r25, hi8(__stack)\n"
+        "    rjmp 2f\n"
+        "1:  st Z+, r24\n"
+        "2:  cpi r30, lo8(__stack)\n"
+        "    cpc r31, r25\n"
+        "    brlo 1b\n"
+        "    breq 1b\n"
+        :: "i"(AVR_BENCH_PAINT));
+}
+
+extern uint8_t _end;
+
+static uint16_t pti_stack_high_water(void) {
+    const uint8_t* p = &_end;
+    while (p <= (const uint8_t*)RAMEND && *p == AVR_BENCH_PAINT) p++;
+    return (uint16_t)((const uint8_t*)RAMEND + 1 - p);
+}
+
+static int pti_console_putc(char c, FILE* stream) {
+    (void)stream;
+    GPIOR0 = (uint8_t)c;
+    return 0;
+}
+
+static FILE pti_console;
+
+static const char* const pti_stage_names[AVR_BENCH_STAGE_COUNT] = {
+    "start", "inputs", "filter", "faults", "temperature", "heating", "log", "outputs"
+};
+
+/* Open-loop oven: 0.4 °C per tick with gas on, -0.1 °C per tick with gas off */
+static void pti_scenario_step(uint16_t tick, int16_t* temp_dc) {
+    pti_now_ms = (uint32_t)tick * AVR_BENCH_TICK_MS;
+    pti_vref_mv = (tick >= 800U && tick < 860U) ? 4300U : 5000U;
+    if (tick == 400U || tick == 460U) {
+        /* Door edge: handler cost is the latency from edge to gas off */
+        uint32_t t0 = pti_cycles();
+        door_sensor_interrupt_handler(tick == 400U);
+        pti_stats_add(&pti_door, pti_cycles() - t0);
+    }
+
+    *temp_dc += read_output(GAS_VALVE) ? 4 : -1;
+    /* signal = vref * (0.10 + 0.80 * (T + 10) / 310) */
+    pti_signal_mv = (uint16_t)(pti_vref_mv / 10U +
+                               ((uint32_t)pti_vref_mv * 8U * (uint32_t)(*temp_dc + 100)) / 31000UL);
+}
+
+static void pti_print_stats(const char* name, const pti_cycle_stats_t* s) {
+    printf("%s.min=%lu %s.avg=%lu %s.max=%lu\n", name, (unsigned long)s->min, name,
+           (unsigned long)(s->count ? s->sum / s->count : 0), name, (unsigned long)s->max);
+}
+
+int main(void) {
+    fdev_setup_stream(&pti_console, pti_console_putc, NULL, _FDEV_SETUP_WRITE);
+    stdout = &pti_console;
+
+    DDRD |= _BV(PD2) | _BV(PD4) | _BV(PD5) | _BV(PD7);  /* burner outputs */
+
+    TCCR1A = 0;
+    TCCR1B = _BV(CS10);  /* clk/1 */
+    TIMSK1 = _BV(TOIE1);
+    sei();
+
+    /* Cost of one mark, subtracted from every stage */
+    uint32_t best = UINT32_MAX;
+    for (uint8_t i = 0; i < 16; i++) {
+        avr_bench_mark(AVR_BENCH_STAGE_start);
+        uint32_t t0 = pti_last_mark;
+        avr_bench_mark(AVR_BENCH_STAGE_COUNT);
+        uint32_t d = pti_cycles() - t0;
+        if (d < best) best = d;
+    }
+    pti_mark_overhead = (uint16_t)best;
+
+    int16_t temp_dc = 1500;
+    pti_scenario_step(0, &temp_dc);
+    ptx_oven_control_init();
+    for (uint8_t i = 0; i < AVR_BENCH_STAGE_COUNT; i++) pti_stage[i].count = 0;
+
+    for (uint16_t tick = 0; tick < AVR_BENCH_TICKS; tick++) {
+        pti_scenario_step(tick, &temp_dc);
+        pti_marks_per_tick = 0;
+        uint32_t t0 = pti_cycles();
+        ptx_oven_control_update();
+        uint32_t d = pti_cycles() - t0;
+        uint32_t marks = (uint32_t)pti_marks_per_tick * pti_mark_overhead;
+        pti_stats_add(&pti_tick, (d > marks) ? d - marks : 0);
+    }
+    uint16_t stack_bytes = pti_stack_high_water();  /* before printf adds its own frames */
+
+    printf("avr_bench f_cpu=%lu ticks=%u mark_overhead=%u port_direct=%u\n", (unsigned long)F_CPU,
+           AVR_BENCH_TICKS, pti_mark_overhead, (unsigned)PTX_ACTUATOR_PORT_DIRECT);
+    pti_print_stats("tick", &pti_tick);
+    pti_print_stats("door_isr", &pti_door);
+    ptx_actuator_stop_stats_t stop;
+    ptx_actuator_get_stop_stats(&stop);
+    printf("estop.count=%lu estop.max_us=%lu\n", (unsigned long)stop.count, (unsigned long)stop.max_us);
+    for (uint8_t i = AVR_BENCH_STAGE_inputs; i < AVR_BENCH_STAGE_COUNT; i++) {
+        char name[24];
+        snprintf(name, sizeof(name), "stage.%s", pti_stage_names[i]);
+        pti_print_stats(name, &pti_stage[i]);
+    }
+    printf("stack.high_water=%u\n", stack_bytes);
+    printf("avr_bench done\n");
+
+    /* simavr exits when the CPU sleeps with interrupts off */
+    cli();
+    sleep_cpu();
+    for (;;) {
+    }
+}
@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+"""Check the AVR cost harness report against cycle, stack, flash and SRAM budgets.
+
+Usage: check_budgets.py <report.txt> <size.txt> [--tick-cycles N] [--stack-bytes N]
+                        [--flash-bytes N] [--sram-bytes N] [--estop-us N]
+
+report.txt is the simavr console output of avr_bench_main.cpp (key=value
+lines); size.txt is `avr-size -t` over the control module objects, so flash
+and SRAM cover the controller only, not the harness or avr-libc.
+Exit status is 1 when any budget is exceeded or the report is incomplete.
+"""
+import argparse
+import re
+import sys
+
+ANSI = re.compile(r"\x1b\[[0-9;]*m")
+
+
+def parse_report(path):
+    values = {}
+    done = False
+    with open(path, encoding="utf-8", errors="replace") as f:
+        for line in f:
+            line = ANSI.sub("", line).strip()
+            if line.endswith("avr_bench done"):
+                done = True
+            for key, value in re.findall(r"([\w.]+)=(\d+)", line):
+                values[key] = int(value)
+    return values, done
+
+
+def parse_size(path):
+    """Flash = text + data, SRAM = data + bss, from the TOTALS line."""
+    with open(path, encoding="utf-8") as f:
+        for line in f:
+            fields = line.split()
+            if len(fields) >= 3 and "(TOTALS)" in line:
+                text, data, bss = (int(x) for x in fields[:3])
+                return text + data, data + bss
+    return None, None
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("report")
+    ap.add_argument("size")
+    ap.add_argument("--tick-cycles", type=int, default=40000)
+    ap.add_argument("--stack-bytes", type=int, default=512)
+    ap.add_argument("--flash-bytes", type=int, default=20480)
+    ap.add_argument("--sram-bytes", type=int, default=1536)
+    ap.add_argument("--estop-us", type=int, default=10)
+    args = ap.parse_args()
+
+    values, done = parse_report(args.report)
+    if not done or "tick.max" not in values or values.get("estop.count", 0) == 0:
+        print("FAIL: incomplete report (harness crashed or simavr timed out)")
+        return 1
+    flash, sram = parse_size(args.size)
+    if flash is None:
+        print("FAIL: no TOTALS line in %s" % args.size)
+        return 1
+
+    f_cpu = values.get("f_cpu", 16000000)
+    print("ticks: %d at %.0f MHz (mark overhead %d cycles, port_direct=%d)" %
+          (values.get("ticks", 0), f_cpu / 1e6, values.get("mark_overhead", 0),
+           values.get("port_direct", 0)))
+    print("%-22s %8s %8s %8s" % ("cycles", "min", "avg", "max"))
+    for key in ["tick", "door_isr"] + sorted(k[:-4] for k in values if k.startswith("stage.") and k.endswith(".max")):
+        print("%-22s %8d %8d %8d" % (key, values[key + ".min"], values[key + ".avg"], values[key + ".max"]))
+    print("tick.max = %.1f us" % (values["tick.max"] * 1e6 / f_cpu))
+
+    checks = [
+        ("tick cycles (max)", values["tick.max"], args.tick_cycles),
+        ("stack high-water bytes", values.get("stack.high_water", 0), args.stack_bytes),
+        ("flash bytes", flash, args.flash_bytes),
+        ("sram bytes (static)", sram, args.sram_bytes),
+        ("estop latency us (max)", values.get("estop.max_us", 0), args.estop_us),
+    ]
+    failed = False
+    for name, value, budget in checks:
+        ok = value <= budget
+        failed |= not ok
+        print("%-4s %-24s %8d / %d" % ("OK" if ok else "FAIL", name, value, budget))
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
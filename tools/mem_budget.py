@@ -0,0 +1,350 @@
+#!/usr/bin/env python3
+"""Static flash/SRAM and stack-depth report for the controller modules, with budgets.
+
+Usage: mem_budget.py --config <budget.cfg> [--objdump avr-objdump] [--call-cost 2]
+                     [--rodata-in-ram] [--report-only] <module.o> ...
+
+Each object must be compiled with -ffunction-sections -fdata-sections
+-fstack-usage, so a function's frame size is in the .su file next to the
+object (x.o -> x.su, x.cpp.o -> x.cpp.su) and every function has its own
+section.
+
+Reports:
+  - per-module flash and RAM from the section headers (text, rodata,
+    data, bss, progmem)
+  - the largest symbols
+  - for every stack root in the config, the deepest call chain: frame sizes
+    from the .su files, call edges from the relocations of each function
+    (objdump -dr), plus `edge` lines from the config for calls the
+    relocations cannot show (function pointers, code outside the modules)
+
+Indirect calls that the config does not name are missed, so the depth is a
+lower bound when a function on the chain calls through a pointer; such
+frames are marked "dynamic" by GCC and flagged in the report.
+
+Budget file lines (# starts a comment):
+  module <name> flash=<bytes> ram=<bytes>   per-module limit (name = object stem)
+  total flash=<bytes> ram=<bytes>           sum over all modules
+  stack <root> <bytes>                      deepest chain from <root>
+  stack_total <bytes>                       deepest tick root + deepest isr root
+  root tick|isr <function>                  classify a stack root
+  edge <caller> <callee>                    call not visible in relocations
+  frame <function> <bytes>                  frame of a function outside the objects
+  include <file>                            read another budget file (path relative
+                                            to this one); later lines override
+
+Exit status is 1 when a budget is exceeded (0 with --report-only).
+"""
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+CALL_RELOC = re.compile(r"PLT|CALL|JUMP|13_PCREL|BRANCH")
+
+
+def run(cmd):
+    return subprocess.run(cmd, check=True, capture_output=True, text=True).stdout
+
+
+def section_class(name, rodata_in_ram):
+    """(flash, ram) contribution of a section, as multipliers."""
+    if name.startswith(".text") or name.startswith(".progmem"):
+        return 1, 0
+    if name.startswith(".rodata"):
+        return (1, 1) if rodata_in_ram else (1, 0)
+    if name.startswith(".data"):
+        return 1, 1
+    if name.startswith(".bss") or name.startswith(".noinit"):
+        return 0, 1
+    return 0, 0
+
+
+def base_name(demangled):
+    """Bare function identifier: 'void ns::f<T>(int) const' -> 'f'."""
+    s = demangled
+    depth = 0
+    for i, c in enumerate(s):  # cut the parameter list at template depth 0
+        if c == "<":
+            depth += 1
+        elif c == ">":
+            depth -= 1
+        elif c == "(" and depth == 0:
+            s = s[:i]
+            break
+    while s.endswith(">"):  # drop trailing template arguments
+        depth = 0
+        for i in range(len(s) - 1, -1, -1):
+            depth += {">": 1, "<": -1}.get(s[i], 0)
+            if depth == 0:
+                s = s[:i]
+                break
+    return re.split(r"[\s:*&]+", s.strip())[-1] if s.strip() else demangled
+
+
+def demangle(names, cxxfilt):
+    names = sorted(names)
+    if not names:
+        return {}
+    out = subprocess.run([cxxfilt], input="\n".join(names), capture_output=True, text=True,
+                         check=True).stdout.splitlines()
+    return dict(zip(names, out))
+
+
+class Module:
+    def __init__(self, path):
+        self.path = path
+        stem = os.path.basename(path)
+        self.name = stem.split(".")[0]
+        self.flash = 0
+        self.ram = 0
+        self.symbols = []      # (size, kind, mangled)
+        self.functions = {}    # mangled -> section
+        self.calls = {}        # mangled caller -> set of mangled/section targets
+        self.frames = {}       # base name -> (bytes, qualifier)
+
+
+def load_module(path, objdump, rodata_in_ram):
+    m = Module(path)
+    for line in run([objdump, "-h", path]).splitlines():
+        f = line.split()
+        if len(f) >= 7 and f[0].isdigit():
+            flash, ram = section_class(f[1], rodata_in_ram)
+            size = int(f[2], 16)
+            m.flash += flash * size
+            m.ram += ram * size
+
+    section_func = {}
+    for line in run([objdump, "-t", path]).splitlines():
+        # value flags section size name; flags are fixed width (7 chars)
+        mt = re.match(r"^[0-9a-fA-F]+ (.{7}) (\S+)\s+([0-9a-fA-F]+) (.+)$", line)
+        if not mt:
+            continue
+        flags, section, size, name = mt.group(1), mt.group(2), int(mt.group(3), 16), mt.group(4)
+        if "F" in flags:
+            m.functions[name] = section
+            section_func[section] = name
+            m.symbols.append((size, "text", name))
+        elif "O" in flags and size > 0:
+            flash, ram = section_class(section, rodata_in_ram)
+            kind = "bss" if not flash else ("data" if ram else "rodata")
+            m.symbols.append((size, kind, name))
+
+    current = None
+    for line in run([objdump, "-dr", path]).splitlines():
+        mf = re.match(r"^[0-9a-fA-F]+ <(.+)>:$", line)
+        if mf:
+            current = mf.group(1)
+            m.calls.setdefault(current, set())
+            continue
+        mr = re.match(r"^\s+[0-9a-fA-F]+: (R_\S+)\s+(\S+?)(?:[-+]0x[0-9a-fA-F]+)?$", line)
+        if mr and current is not None:
+            rtype, target = mr.group(1), mr.group(2)
+            target = section_func.get(target, target)
+            m.calls[current].add((target, bool(CALL_RELOC.search(rtype))))
+
+    su = os.path.splitext(path)[0] + ".su"
+    if os.path.exists(su):
+        with open(su, encoding="utf-8", errors="replace") as f:
+            for line in f:
+                parts = line.rstrip("\n").split("\t")
+                if len(parts) < 3:
+                    continue
+                name = su_name(parts[0])
+                size = int(parts[1])
+                prev = m.frames.get(name, (0, ""))
+                if size >= prev[0]:  # template instances share a name; keep the largest
+                    m.frames[name] = (size, parts[2])
+    return m
+
+
+def su_name(location):
+    """Function identifier of an .su entry, read from the source at file:line:col."""
+    mloc = re.match(r"^(.*):(\d+):(\d+):(.*)$", location)
+    if not mloc:
+        return base_name(location)
+    path, line, col, decl = mloc.group(1), int(mloc.group(2)), int(mloc.group(3)), mloc.group(4)
+    try:
+        with open(path, encoding="utf-8", errors="replace") as f:
+            text = f.read().splitlines()[line - 1]
+        ident = re.match(r"[A-Za-z_]\w*", text[col - 1:])
+        if ident:
+            return ident.group(0)
+    except (OSError, IndexError):
+        pass
+    return base_name(decl)
+
+
+def parse_config(path, cfg=None):
+    if cfg is None:
+        cfg = {"module": {}, "total": {}, "stack": {}, "stack_total": None, "root": {},
+               "edge": [], "frame": {}}
+    with open(path, encoding="utf-8") as f:
+        for lineno, raw in enumerate(f, 1):
+            words = raw.split("#", 1)[0].split()
+            if not words:
+                continue
+            kind, args = words[0], words[1:]
+            kv = dict(a.split("=", 1) for a in args if "=" in a)
+            try:
+                if kind == "module":
+                    cfg["module"][args[0]] = {k: int(v) for k, v in kv.items()}
+                elif kind == "total":
+                    cfg["total"] = {k: int(v) for k, v in kv.items()}
+                elif kind == "stack":
+                    cfg["stack"][args[0]] = int(args[1])
+                elif kind == "stack_total":
+                    cfg["stack_total"] = int(args[0])
+                elif kind == "root":
+                    cfg["root"][args[1]] = args[0]
+                elif kind == "edge":
+                    cfg["edge"].append((args[0], args[1]))
+                elif kind == "frame":
+                    cfg["frame"][args[0]] = int(args[1])
+                elif kind == "include":
+                    parse_config(os.path.join(os.path.dirname(path), args[0]), cfg)
+                else:
+                    raise ValueError("unknown keyword '%s'" % kind)
+            except (IndexError, ValueError) as e:
+                sys.exit("%s:%d: %s" % (path, lineno, e))
+    return cfg
+
+
+class CallGraph:
+    def __init__(self, modules, cfg, cxxfilt, call_cost):
+        self.call_cost = call_cost
+        mangled = set()
+        for m in modules:
+            mangled.update(n for _, _, n in m.symbols)
+            for targets in m.calls.values():
+                mangled.update(t for t, _ in targets)
+        self.pretty = demangle(mangled, cxxfilt)
+
+        defined = {}
+        for m in modules:
+            for fn in m.functions:
+                defined[fn] = m
+        self.frames = {}
+        self.qualifiers = {}
+        self.external = set()
+        self.edges = {}
+        for m in modules:
+            for fn in m.functions:
+                name = base_name(self.pretty.get(fn, fn))
+                size, qual = m.frames.get(name, (0, "missing"))
+                self.frames[name] = max(self.frames.get(name, 0), size)
+                self.qualifiers[name] = qual
+            for caller, targets in m.calls.items():
+                cname = base_name(self.pretty.get(caller, caller))
+                for target, is_call in targets:
+                    if target in defined:
+                        tname = base_name(self.pretty.get(target, target))
+                    elif is_call and not target.startswith("."):
+                        tname = base_name(self.pretty.get(target, target))
+                        self.external.add(tname)
+                    else:
+                        continue
+                    if tname != cname:
+                        self.edges.setdefault(cname, set()).add(tname)
+        for name, size in cfg["frame"].items():
+            self.frames[name] = size
+            self.qualifiers[name] = "config"
+            self.external.discard(name)
+        for caller, callee in cfg["edge"]:
+            self.edges.setdefault(caller, set()).add(callee)
+        self.memo = {}
+
+    def depth(self, fn, stack=()):
+        """(bytes, chain) of the deepest path from fn; recursion is reported as unbounded."""
+        if fn in stack:
+            return float("inf"), [fn + " (recursion)"]
+        if fn in self.memo:
+            return self.memo[fn]
+        best, chain = 0, []
+        for callee in sorted(self.edges.get(fn, ())):
+            d, c = self.depth(callee, stack + (fn,))
+            d += self.call_cost
+            if d > best:
+                best, chain = d, c
+        result = (self.frames.get(fn, 0) + best, [fn] + chain)
+        self.memo[fn] = result
+        return result
+
+    def describe(self, fn):
+        if fn in self.external and fn not in self.frames:
+            return "external, frame unknown"
+        qual = self.qualifiers.get(fn, "")
+        note = "" if qual == "static" else " [%s]" % qual
+        return "%d B%s" % (self.frames.get(fn, 0), note)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("objects", nargs="+")
+    ap.add_argument("--config", required=True)
+    ap.add_argument("--objdump", default="objdump")
+    ap.add_argument("--cxxfilt", help="default: c++filt with the objdump prefix")
+    ap.add_argument("--call-cost", type=int, default=0,
+                    help="bytes pushed per call not counted in the .su frames (AVR: 2)")
+    ap.add_argument("--rodata-in-ram", action="store_true",
+                    help="count .rodata as RAM too (AVR: constants are copied to SRAM)")
+    ap.add_argument("--top", type=int, default=15, help="largest symbols to list")
+    ap.add_argument("--report-only", action="store_true", help="never fail")
+    args = ap.parse_args()
+    cxxfilt = args.cxxfilt or args.objdump[:-len("objdump")] + "c++filt"
+
+    cfg = parse_config(args.config)
+    modules = [load_module(p, args.objdump, args.rodata_in_ram) for p in args.objects]
+    failures = []
+
+    def check(label, value, limit):
+        if limit is None:
+            return ""
+        if value > limit:
+            failures.append("%s: %d > %d" % (label, value, limit))
+            return "  FAIL (budget %d)" % limit
+        return "  ok (budget %d)" % limit
+
+    print("%-24s %8s %8s" % ("module", "flash", "ram"))
+    for m in sorted(modules, key=lambda m: -m.flash):
+        budget = cfg["module"].get(m.name, {})
+        print("%-24s %8d %8d%s%s" % (m.name, m.flash, m.ram,
+                                     check(m.name + " flash", m.flash, budget.get("flash")),
+                                     check(m.name + " ram", m.ram, budget.get("ram"))))
+    flash = sum(m.flash for m in modules)
+    ram = sum(m.ram for m in modules)
+    print("%-24s %8d %8d%s%s" % ("total", flash, ram,
+                                 check("total flash", flash, cfg["total"].get("flash")),
+                                 check("total ram", ram, cfg["total"].get("ram"))))
+
+    graph = CallGraph(modules, cfg, cxxfilt, args.call_cost)
+    symbols = sorted(((s, k, graph.pretty.get(n, n), m.name) for m in modules for s, k, n in m.symbols),
+                     reverse=True)[:args.top]
+    print("\nlargest symbols")
+    for size, kind, name, module in symbols:
+        print("%8d %-6s %-20s %s" % (size, kind, module, name))
+
+    print("\nstack depth (call cost %d B per level)" % args.call_cost)
+    worst = {"tick": 0, "isr": 0}
+    for root, limit in cfg["stack"].items():
+        total, chain = graph.depth(root)
+        print("%-32s %6s B%s" % (root, total, check("stack " + root, total, limit)))
+        for fn in chain:
+            print("    %-40s %s" % (fn, graph.describe(fn)))
+        kind = cfg["root"].get(root)
+        if kind in worst:
+            worst[kind] = max(worst[kind], total)
+    if cfg["stack_total"] is not None:
+        combined = worst["tick"] + worst["isr"]
+        print("%-32s %6s B%s" % ("tick + isr", combined,
+                                  check("stack tick + isr", combined, cfg["stack_total"])))
+
+    if failures:
+        print("\nbudget exceeded:\n  " + "\n  ".join(failures))
+        return 0 if args.report_only else 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
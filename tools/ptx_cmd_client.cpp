@@ -0,0 +1,380 @@
+/**
+ * @file ptx_cmd_client.cpp
+ * @brief Host-side client for the oven binary command protocol (POSIX serial)
+ * @details Usage:
+ *            ptx_cmd_client <device> get <field>
+ *            ptx_cmd_client <device> set <field> <value>
+ *            ptx_cmd_client <device> save | reset-lockout | status | stats | transitions
+ *            ptx_cmd_client <device> autotune [pi|pid <cycles>]
+ *            ptx_cmd_client <device> recipe [<id>|stop]
+ *            ptx_cmd_client <device> trace-capture <file.ptxt> <seconds>
+ *          Log text sent by the controller on the same port is skipped; only
+ *          frames with a valid CRC are decoded.
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "ptx_cmd_frame.h"
+#include "ptx_cmd_protocol.h"
+#include "ptx_oven_config.h"
+
+#define PTX_CLIENT_TIMEOUT_MS 1000
+
+static const struct {
+    const char* name;
+    uint8_t id;
+} pti_fields[] = {
+    { "ignition_duration_ms",     PTX_CMD_FIELD_IGNITION_DURATION_MS },
+    { "periodic_log_ms",          PTX_CMD_FIELD_PERIODIC_LOG_MS },
+    { "sensor_fault_window_ms",   PTX_CMD_FIELD_SENSOR_FAULT_WINDOW_MS },
+    { "auto_resume_delay_ms",     PTX_CMD_FIELD_AUTO_RESUME_DELAY_MS },
+    { "vref_min_v",               PTX_CMD_FIELD_VREF_MIN_V },
+    { "vref_max_v",               PTX_CMD_FIELD_VREF_MAX_V },
+    { "temp_target_c",            PTX_CMD_FIELD_TEMP_TARGET_C },
+    { "temp_delta_c",             PTX_CMD_FIELD_TEMP_DELTA_C },
+    { "max_ignition_attempts",    PTX_CMD_FIELD_MAX_IGNITION_ATTEMPTS },
+    { "purge_time_ms",            PTX_CMD_FIELD_PURGE_TIME_MS },
+    { "flame_detect_temp_rise_c", PTX_CMD_FIELD_FLAME_DETECT_TEMP_RISE_C },
+    { "control_mode",             PTX_CMD_FIELD_CONTROL_MODE },
+    { "pid_kp",                   PTX_CMD_FIELD_PID_KP },
+    { "pid_ki",                   PTX_CMD_FIELD_PID_KI },
+    { "pid_kd",                   PTX_CMD_FIELD_PID_KD },
+    { "pid_window_ms",            PTX_CMD_FIELD_PID_WINDOW_MS },
+    { "predict_lead_ms",          PTX_CMD_FIELD_PREDICT_LEAD_MS },
+    { "preignite_enabled",        PTX_CMD_FIELD_PREIGNITE_ENABLED },
+};
+
+static int ptx_field_id(const char* name) {
+    for (size_t i = 0; i < sizeof(pti_fields) / sizeof(pti_fields[0]); i++) {
+        if (strcmp(pti_fields[i].name, name) == 0) return pti_fields[i].id;
+    }
+    return -1;
+}
+
+static uint16_t ptx_get_u16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+
+static uint32_t ptx_get_u32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static int ptx_open_serial(const char* device) {
+    int fd = open(device, O_RDWR | O_NOCTTY);
+    if (fd < 0) return -1;
+
+    struct termios tio;
+    if (tcgetattr(fd, &tio) != 0) {
+        close(fd);
+        return -1;
+    }
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, B115200);
+    cfsetospeed(&tio, B115200);
+    tio.c_cflag |= CLOCAL | CREAD;
+    if (tcsetattr(fd, TCSANOW, &tio) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/* Send one request and wait for the matching response frame */
+static bool ptx_transact(int fd, uint8_t cmd, const uint8_t* payload, uint8_t length,
+                         ptx_cmd_parser_t* parser) {
+    uint8_t frame[PTX_CMD_MAX_FRAME];
+    uint8_t frame_len = ptx_cmd_encode_frame(cmd, payload, length, frame);
+    if (write(fd, frame, frame_len) != (ssize_t)frame_len) return false;
+
+    ptx_cmd_parser_init(parser);
+    struct pollfd pfd = { fd, POLLIN, 0 };
+    while (poll(&pfd, 1, PTX_CLIENT_TIMEOUT_MS) > 0) {
+        uint8_t buf[64];
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if (n <= 0) break;
+        for (ssize_t i = 0; i < n; i++) {
+            if (ptx_cmd_parser_feed(parser, buf[i]) &&
+                parser->cmd == (uint8_t)(cmd | PTX_CMD_RESPONSE_FLAG)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static long ptx_elapsed_ms(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1000L + (now.tv_nsec - start->tv_nsec) / 1000000L;
+}
+
+/* Stream TRACE_DATA chunks to a file; returns false if the device never acknowledged */
+static bool ptx_trace_capture(int fd, FILE* out, long seconds, unsigned long* bytes) {
+    uint8_t frame[PTX_CMD_MAX_FRAME];
+    uint8_t on = 1;
+    uint8_t frame_len = ptx_cmd_encode_frame(PTX_CMD_TRACE_CONTROL, &on, 1, frame);
+    if (write(fd, frame, frame_len) != (ssize_t)frame_len) return false;
+
+    ptx_cmd_parser_t parser;
+    ptx_cmd_parser_init(&parser);
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    bool acked = false;
+    bool stopping = false;
+    *bytes = 0;
+
+    for (;;) {
+        if (!stopping && ptx_elapsed_ms(&start) >= seconds * 1000L) {
+            /* Stop; the device flushes its last chunk before answering */
+            on = 0;
+            frame_len = ptx_cmd_encode_frame(PTX_CMD_TRACE_CONTROL, &on, 1, frame);
+            if (write(fd, frame, frame_len) != (ssize_t)frame_len) return false;
+            stopping = true;
+        }
+        struct pollfd pfd = { fd, POLLIN, 0 };
+        if (poll(&pfd, 1, PTX_CLIENT_TIMEOUT_MS) <= 0) {
+            if (stopping) break;
+            continue;
+        }
+        uint8_t buf[64];
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if (n <= 0) break;
+        for (ssize_t i = 0; i < n; i++) {
+            if (!ptx_cmd_parser_feed(&parser, buf[i])) continue;
+            if (parser.cmd == (uint8_t)(PTX_CMD_TRACE_DATA | PTX_CMD_RESPONSE_FLAG)) {
+                fwrite(parser.payload, 1, parser.length, out);
+                *bytes += parser.length;
+            } else if (parser.cmd == (uint8_t)(PTX_CMD_TRACE_CONTROL | PTX_CMD_RESPONSE_FLAG) &&
+                       parser.length >= 1 && parser.payload[0] == PTX_CMD_RESULT_OK) {
+                if (stopping) return true;
+                acked = true;
+            }
+        }
+    }
+    return acked;
+}
+
+/* Page through the heating transition ring, oldest first */
+static bool ptx_dump_transitions(int fd) {
+    static const char* const state_names[] = { "IDLE", "IGNITING", "HEATING", "PURGING", "LOCKOUT" };
+    ptx_cmd_parser_t parser;
+    uint8_t start = 0;
+    for (;;) {
+        if (!ptx_transact(fd, PTX_CMD_GET_TRANSITIONS, &start, 1, &parser) || parser.length < 5 ||
+            parser.payload[0] != PTX_CMD_RESULT_OK) {
+            return false;
+        }
+        const uint8_t* r = parser.payload;
+        if (start == 0) printf("%u held, %u total\n", r[1], ptx_get_u16(&r[2]));
+        uint8_t n = (uint8_t)((parser.length - 5) / 8);
+        for (uint8_t i = 0; i < n; i++) {
+            const uint8_t* e = &r[5 + 8 * i];
+            uint8_t from = (uint8_t)(e[6] >> 4), to = (uint8_t)(e[6] & 0x0FU);
+            printf("t=%lums %s -> %s cause=%u temp=%.1fC\n", (unsigned long)ptx_get_u32(e),
+                   (from < 5) ? state_names[from] : "?", (to < 5) ? state_names[to] : "?", e[7],
+                   (double)(int16_t)ptx_get_u16(&e[4]) / 10.0);
+        }
+        start = (uint8_t)(start + n);
+        if (n == 0 || start >= r[1]) return true;
+    }
+}
+
+static void ptx_print_value(uint8_t field, uint32_t value) {
+    if (ptx_cmd_field_is_float(field)) {
+        float f;
+        memcpy(&f, &value, sizeof(f));
+        printf("%g\n", (double)f);
+    } else {
+        printf("%lu\n", (unsigned long)value);
+    }
+}
+
+static int ptx_usage(void) {
+    fprintf(stderr, "usage: ptx_cmd_client <device> get <field> | set <field> <value> |\n"
+                    "                               save | reset-lockout | status | stats | transitions |\n"
+                    "                               autotune [pi|pid <cycles>] |\n"
+                    "                               recipe [<id>|stop] |\n"
+                    "                               trace-capture <file.ptxt> <seconds>\n");
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) return ptx_usage();
+
+    const char* op = argv[2];
+
+    if (strcmp(op, "trace-capture") == 0) {
+        if (argc != 5) return ptx_usage();
+        long seconds = strtol(argv[4], NULL, 0);
+        FILE* out = fopen(argv[3], "wb");
+        if (out == NULL) {
+            fprintf(stderr, "cannot create %s: %s\n", argv[3], strerror(errno));
+            return 1;
+        }
+        int fd = ptx_open_serial(argv[1]);
+        if (fd < 0) {
+            fprintf(stderr, "cannot open %s: %s\n", argv[1], strerror(errno));
+            fclose(out);
+            return 1;
+        }
+        unsigned long bytes;
+        bool ok = ptx_trace_capture(fd, out, seconds, &bytes);
+        close(fd);
+        fclose(out);
+        if (!ok) {
+            fprintf(stderr, "no response (trace recording disabled in this build?)\n");
+            return 1;
+        }
+        printf("%lu bytes\n", bytes);
+        return 0;
+    }
+
+    if (strcmp(op, "transitions") == 0) {
+        int fd = ptx_open_serial(argv[1]);
+        if (fd < 0) {
+            fprintf(stderr, "cannot open %s: %s\n", argv[1], strerror(errno));
+            return 1;
+        }
+        bool ok = ptx_dump_transitions(fd);
+        close(fd);
+        if (!ok) {
+            fprintf(stderr, "no response\n");
+            return 1;
+        }
+        return 0;
+    }
+
+    uint8_t cmd;
+    uint8_t payload[PTX_CMD_MAX_PAYLOAD];
+    uint8_t length = 0;
+    int field = -1;
+
+    if (strcmp(op, "get") == 0 || strcmp(op, "set") == 0) {
+        bool is_set = (op[0] == 's');
+        if (argc != (is_set ? 5 : 4)) return ptx_usage();
+        field = ptx_field_id(argv[3]);
+        if (field < 0) {
+            fprintf(stderr, "unknown field '%s'\n", argv[3]);
+            return 2;
+        }
+        cmd = is_set ? PTX_CMD_SET_FIELD : PTX_CMD_GET_FIELD;
+        payload[0] = (uint8_t)field;
+        length = 1;
+        if (is_set) {
+            uint32_t value;
+            if (ptx_cmd_field_is_float((uint8_t)field)) {
+                float f = strtof(argv[4], NULL);
+                memcpy(&value, &f, sizeof(value));
+            } else {
+                value = (uint32_t)strtoul(argv[4], NULL, 0);
+            }
+            for (int b = 0; b < 4; b++) payload[1 + b] = (uint8_t)(value >> (8 * b));
+            length = 5;
+        }
+    } else if (strcmp(op, "save") == 0) {
+        cmd = PTX_CMD_SAVE_CONFIG;
+    } else if (strcmp(op, "reset-lockout") == 0) {
+        cmd = PTX_CMD_RESET_LOCKOUT;
+    } else if (strcmp(op, "status") == 0) {
+        cmd = PTX_CMD_GET_STATUS;
+    } else if (strcmp(op, "stats") == 0) {
+        cmd = PTX_CMD_GET_STATS;
+    } else if (strcmp(op, "autotune") == 0) {
+        cmd = PTX_CMD_AUTOTUNE;
+        if (argc == 5) {
+            if (strcmp(argv[3], "pi") == 0) payload[0] = PTX_CONTROL_MODE_PI;
+            else if (strcmp(argv[3], "pid") == 0) payload[0] = PTX_CONTROL_MODE_PID;
+            else return ptx_usage();
+            payload[1] = (uint8_t)strtoul(argv[4], NULL, 0);
+            length = 2;
+        } else if (argc != 3) {
+            return ptx_usage();
+        }
+    } else if (strcmp(op, "recipe") == 0) {
+        cmd = PTX_CMD_RECIPE;
+        if (argc == 4) {
+            payload[0] = (strcmp(argv[3], "stop") == 0) ? 0 : (uint8_t)strtoul(argv[3], NULL, 0);
+            length = 1;
+        } else if (argc != 3) {
+            return ptx_usage();
+        }
+    } else {
+        return ptx_usage();
+    }
+
+    int fd = ptx_open_serial(argv[1]);
+    if (fd < 0) {
+        fprintf(stderr, "cannot open %s: %s\n", argv[1], strerror(errno));
+        return 1;
+    }
+
+    ptx_cmd_parser_t parser;
+    bool ok = ptx_transact(fd, cmd, payload, length, &parser);
+    close(fd);
+    if (!ok || parser.length < 1) {
+        fprintf(stderr, "no response\n");
+        return 1;
+    }
+
+    const uint8_t* r = parser.payload;
+    if (r[0] != PTX_CMD_RESULT_OK) {
+        fprintf(stderr, "result=%u\n", r[0]);
+    }
+
+    switch (cmd) {
+        case PTX_CMD_GET_FIELD:
+        case PTX_CMD_SET_FIELD:
+            if (parser.length >= 6) ptx_print_value(r[1], ptx_get_u32(&r[2]));
+            break;
+        case PTX_CMD_GET_STATUS:
+            if (parser.length >= 9) {
+                printf("temp=%.1fC vref=%umV signal=%umV flags=0x%02X state=%u attempt=%u\n",
+                       (double)(int16_t)ptx_get_u16(&r[1]) / 10.0, ptx_get_u16(&r[3]),
+                       ptx_get_u16(&r[5]), r[7], r[8] & 0x07U, r[8] >> 3);
+            }
+            break;
+        case PTX_CMD_GET_STATS:
+            if (parser.length >= 17) {
+                printf("frames_ok=%u crc_errors=%u length_errors=%u rejected=%u "
+                       "config_version=%lu uptime_ms=%lu",
+                       ptx_get_u16(&r[1]), ptx_get_u16(&r[3]), ptx_get_u16(&r[5]), ptx_get_u16(&r[7]),
+                       (unsigned long)ptx_get_u32(&r[9]), (unsigned long)ptx_get_u32(&r[13]));
+                if (parser.length >= 21) {
+                    printf(" estop_count=%u estop_max_us=%u", ptx_get_u16(&r[17]), ptx_get_u16(&r[19]));
+                }
+                printf("\n");
+            }
+            break;
+        case PTX_CMD_AUTOTUNE:
+            if (parser.length >= 24) {
+                static const char* const at_names[] = { "idle", "running", "done", "aborted" };
+                float ku, kp, ki, kd;
+                uint32_t u;
+                u = ptx_get_u32(&r[4]);  memcpy(&ku, &u, sizeof(ku));
+                u = ptx_get_u32(&r[12]); memcpy(&kp, &u, sizeof(kp));
+                u = ptx_get_u32(&r[16]); memcpy(&ki, &u, sizeof(ki));
+                u = ptx_get_u32(&r[20]); memcpy(&kd, &u, sizeof(kd));
+                printf("autotune=%s cycles=%u/%u ku=%g tu=%.1fs kp=%g ki=%g kd=%g\n",
+                       (r[1] < 4) ? at_names[r[1]] : "?", r[2], r[3], (double)ku,
+                       (double)ptx_get_u32(&r[8]) / 1000.0, (double)kp, (double)ki, (double)kd);
+            }
+            break;
+        case PTX_CMD_RECIPE:
+            if (parser.length >= 10) {
+                static const char* const rc_names[] = { "idle", "running", "done", "aborted" };
+                static const char* const phase_names[] = { "ramp", "soak", "hold" };
+                printf("recipe=%s id=%u segment=%u/%u phase=%s setpoint=%.1fC hold_left=%us\n",
+                       (r[1] < 4) ? rc_names[r[1]] : "?", r[2], (unsigned)r[3] + 1U, r[4],
+                       (r[5] < 3) ? phase_names[r[5]] : "?", (double)(int16_t)ptx_get_u16(&r[6]) / 10.0,
+                       ptx_get_u16(&r[8]));
+            }
+            break;
+        default:
+            break;
+    }
+    return (r[0] == PTX_CMD_RESULT_OK) ? 0 : 1;
+}